@@ -0,0 +1,134 @@
+# Compile-time benchmark for DEADDEV_ENABLE_BITMASK
+#
+# Generates two translation units with DEADDEV_ENUMS enums of DEADDEV_FLAGS flags each:
+#   * baseline.cpp - header and enums only
+#   * bitmask.cpp  - the same plus registration and a few operators per enum
+# and runs the compiler front-end only (-fsyntax-only or /Zs) on both. The difference is
+# the cost of the library per translation unit.
+#
+# DEADDEV_REGISTRATION selects the registration macro:
+#   * adl      - DEADDEV_ENABLE_BITMASK inside the enums namespace (default)
+#   * external - DEADDEV_ENABLE_BITMASK_EXTERNAL at global scope
+# ADL registration looks up every overload declared in the enum's namespace, so its cost
+# grows with the number of registered enums sharing one namespace.
+#
+# Usage:
+#   cmake -DDEADDEV_CXX_COMPILER=g++ -DDEADDEV_INCLUDE_DIR=include
+#         [-DDEADDEV_CXX_COMPILER_ID=MSVC] [-DDEADDEV_WORK_DIR=dir] [-DDEADDEV_ENUMS=2000]
+#         [-DDEADDEV_FLAGS=32] [-DDEADDEV_STANDARDS=14;17;20] [-DDEADDEV_REPEAT=3]
+#         [-DDEADDEV_REGISTRATION=adl|external]
+#         -P compile_benchmark.cmake
+cmake_minimum_required(VERSION 3.23)
+
+if(NOT DEADDEV_CXX_COMPILER OR NOT DEADDEV_INCLUDE_DIR)
+    message(FATAL_ERROR "DEADDEV_CXX_COMPILER and DEADDEV_INCLUDE_DIR are required")
+endif()
+if(NOT DEADDEV_WORK_DIR)
+    set(DEADDEV_WORK_DIR "${CMAKE_CURRENT_BINARY_DIR}/compile_time")
+endif()
+if(NOT DEADDEV_ENUMS)
+    set(DEADDEV_ENUMS 2000)
+endif()
+if(NOT DEADDEV_FLAGS)
+    set(DEADDEV_FLAGS 32)
+endif()
+if(DEADDEV_FLAGS LESS 3)
+    set(DEADDEV_FLAGS 3)
+elseif(DEADDEV_FLAGS GREATER 64)
+    set(DEADDEV_FLAGS 64)
+endif()
+if(NOT DEADDEV_STANDARDS)
+    set(DEADDEV_STANDARDS 14 17 20)
+endif()
+if(NOT DEADDEV_REPEAT)
+    set(DEADDEV_REPEAT 3)
+endif()
+if(NOT DEADDEV_REGISTRATION)
+    set(DEADDEV_REGISTRATION adl)
+endif()
+if(NOT DEADDEV_REGISTRATION MATCHES "^(adl|external)$")
+    message(FATAL_ERROR "unknown DEADDEV_REGISTRATION: ${DEADDEV_REGISTRATION}")
+endif()
+
+file(MAKE_DIRECTORY "${DEADDEV_WORK_DIR}")
+
+# enum bodies are shared by both translation units
+math(EXPR last_flag "${DEADDEV_FLAGS} - 1")
+set(enum_values "")
+foreach(flag RANGE ${last_flag})
+    string(APPEND enum_values "  f${flag} = 1ull << ${flag},\n")
+endforeach()
+
+set(baseline "${DEADDEV_WORK_DIR}/baseline.cpp")
+set(bitmask "${DEADDEV_WORK_DIR}/bitmask.cpp")
+file(WRITE "${baseline}" "#include <deaddev/bitmask.hpp>\nnamespace bench {\n")
+file(WRITE "${bitmask}" "#include <deaddev/bitmask.hpp>\nnamespace bench {\n")
+
+math(EXPR last_enum "${DEADDEV_ENUMS} - 1")
+foreach(index RANGE ${last_enum})
+    set(name "e${index}")
+    set(declaration "enum class ${name} : unsigned long long {\n${enum_values}};\n")
+    if(DEADDEV_REGISTRATION STREQUAL "adl")
+        set(registration "DEADDEV_ENABLE_BITMASK(${name}")
+        set(prefix "")
+    else()
+        # leave the namespace for a global specialization
+        set(registration "} // namespace bench\nDEADDEV_ENABLE_BITMASK_EXTERNAL(bench::${name}")
+        set(prefix "bench::")
+    endif()
+    foreach(flag RANGE ${last_flag})
+        string(APPEND registration ", ${prefix}${name}::f${flag}")
+    endforeach()
+    string(APPEND registration ")\n")
+    if(DEADDEV_REGISTRATION STREQUAL "external")
+        string(APPEND registration "namespace bench {\n")
+    endif()
+    string(CONCAT usage
+        "inline bool use_${name}(::deaddev::bitmask<${name}> f) {\n"
+        "  return (~(${name}::f0 | ${name}::f1) & f).is_set(${name}::f2) && "
+        "${name}::f0 != f;\n}\n")
+    file(APPEND "${baseline}" "${declaration}")
+    file(APPEND "${bitmask}" "${declaration}${registration}${usage}")
+endforeach()
+file(APPEND "${baseline}" "} // namespace bench\n")
+file(APPEND "${bitmask}" "} // namespace bench\n")
+
+# returns the best of DEADDEV_REPEAT runs in microseconds
+function(deaddev_time_compile source standard out_var)
+    if(DEADDEV_CXX_COMPILER_ID STREQUAL "MSVC")
+        set(args /nologo /Zs /EHsc /std:c++${standard} "/I${DEADDEV_INCLUDE_DIR}")
+    else()
+        set(args -fsyntax-only -std=c++${standard} "-I${DEADDEV_INCLUDE_DIR}")
+    endif()
+    set(best "")
+    foreach(run RANGE 1 ${DEADDEV_REPEAT})
+        string(TIMESTAMP start "%s%f" UTC)
+        execute_process(
+            COMMAND "${DEADDEV_CXX_COMPILER}" ${args} "${source}"
+            RESULT_VARIABLE result
+            ERROR_VARIABLE errors
+            OUTPUT_VARIABLE output)
+        string(TIMESTAMP stop "%s%f" UTC)
+        if(NOT result EQUAL 0)
+            message(FATAL_ERROR "compilation of ${source} failed:\n${output}${errors}")
+        endif()
+        math(EXPR elapsed "${stop} - ${start}")
+        if(best STREQUAL "" OR elapsed LESS best)
+            set(best ${elapsed})
+        endif()
+    endforeach()
+    set(${out_var} ${best} PARENT_SCOPE)
+endfunction()
+
+message(STATUS "${DEADDEV_ENUMS} enums x ${DEADDEV_FLAGS} flags, ${DEADDEV_REGISTRATION} "
+               "registration, best of ${DEADDEV_REPEAT}")
+foreach(standard IN LISTS DEADDEV_STANDARDS)
+    deaddev_time_compile("${baseline}" ${standard} baseline_us)
+    deaddev_time_compile("${bitmask}" ${standard} bitmask_us)
+    math(EXPR library_us "${bitmask_us} - ${baseline_us}")
+    math(EXPR per_enum_us "${library_us} / ${DEADDEV_ENUMS}")
+    math(EXPR baseline_ms "${baseline_us} / 1000")
+    math(EXPR bitmask_ms "${bitmask_us} / 1000")
+    message(STATUS "c++${standard}: baseline ${baseline_ms} ms, with bitmasks ${bitmask_ms} ms, "
+                   "${per_enum_us} us per enum")
+endforeach()
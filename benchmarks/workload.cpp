@@ -0,0 +1,61 @@
+#include <deaddev/bitmask_workload.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace bench {
+enum class flag_bits : uint32_t {
+  flag_0_bit = 0x0001,
+  flag_1_bit = 0x0002,
+  flag_2_bit = 0x0004,
+  flag_3_bit = 0x0008,
+  flag_4_bit = 0x0010,
+  flag_5_bit = 0x0020,
+  flag_6_bit = 0x0040,
+  flag_7_bit = 0x0080,
+  flag_8_bit = 0x0100,
+  flag_9_bit = 0x0200,
+  flag_10_bit = 0x0400,
+  flag_11_bit = 0x0800,
+  flag_12_bit = 0x1000,
+  flag_13_bit = 0x2000,
+  flag_14_bit = 0x4000,
+  flag_15_bit = 0x8000,
+};
+DEADDEV_ENABLE_BITMASK(flag_bits, static_cast<flag_bits>(0xFFFF));
+using flags = deaddev::bitmask<flag_bits>;
+} // namespace bench
+
+namespace {
+template <typename Generator>
+void run(const char *name, const Generator &generator, std::vector<bench::flags> &out,
+         unsigned threads) {
+  const auto start = std::chrono::steady_clock::now();
+  generator.fill(out.data(), out.size(), threads);
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::printf("%-24s %8.3f s %10.1f M masks/s\n", name, elapsed.count(),
+              static_cast<double>(out.size()) / elapsed.count() / 1e6);
+}
+} // namespace
+
+// usage: deaddev_bitmask_workload_benchmark [masks] [threads]
+int main(int argc, char **argv) {
+  const std::size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{1} << 28;
+  const unsigned threads =
+      argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 0;
+  std::vector<bench::flags> out(count);
+
+  using generator = deaddev::workload_generator<bench::flag_bits>;
+  run("independent flags", generator(1), out, threads);
+  run("skewed flags + groups",
+      generator(1)
+          .flag_probability(bench::flags::all_flags(), 0.05)
+          .group(bench::flag_bits::flag_0_bit | bench::flag_bits::flag_7_bit, 0.3)
+          .group(bench::flag_bits::flag_3_bit | bench::flag_bits::flag_12_bit, 0.1),
+      out, threads);
+  run("zipf 4096", generator(1).zipf(4096, 1.1), out, threads);
+  run("zipf 4096 + locality", generator(1).zipf(4096, 1.1).locality(0.8), out, threads);
+  return 0;
+}
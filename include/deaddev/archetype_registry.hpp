@@ -0,0 +1,478 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Entity storage grouped by component signature
+ * @details deaddev::archetype_registry stores entities in archetypes, one per distinct
+ * signature, each with chunks of component columns. Queries by required and excluded
+ * components are cached and extended only when new archetypes appear
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_ARCHETYPE_REGISTRY_HPP
+#define DEADDEV_ARCHETYPE_REGISTRY_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+#include <deaddev/wide_bitmask.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace deaddev {
+
+/// entity handle, stale after the entity is destroyed
+struct entity {
+  /// slot in the entity table
+  ::std::uint32_t index = 0;
+  /// incremented when the slot is reused
+  ::std::uint32_t generation = 0;
+
+  DEADDEV_NODISCARD friend constexpr bool operator==(entity left, entity right) noexcept {
+    return left.index == right.index && left.generation == right.generation;
+  }
+  DEADDEV_NODISCARD friend constexpr bool operator!=(entity left, entity right) noexcept {
+    return !(left == right);
+  }
+};
+
+namespace details {
+
+/// signature with only bit index set
+template <typename T>
+::deaddev::bitmask<T> signature_bit(const ::deaddev::bitmask<T> &, ::std::size_t index) noexcept {
+  using mask_type = typename ::deaddev::bitmask<T>::mask_type;
+  return ::deaddev::bitmask<T>(static_cast<mask_type>(mask_type{1} << index));
+}
+
+/// signature with only bit index set
+template <::std::size_t Bits, typename Index>
+::deaddev::wide_bitmask<Bits, Index> signature_bit(const ::deaddev::wide_bitmask<Bits, Index> &,
+                                                   ::std::size_t index) noexcept {
+  return ::deaddev::wide_bitmask<Bits, Index>{static_cast<Index>(index)};
+}
+
+/// hashes the bytes of a signature
+template <typename Signature> struct signature_hash {
+  ::std::size_t operator()(const Signature &signature) const noexcept {
+    unsigned char bytes[sizeof(Signature)];
+    ::std::memcpy(bytes, &signature, sizeof(Signature));
+    ::std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (const unsigned char byte : bytes) {
+      hash = (hash ^ byte) * 0x100000001b3ull;
+    }
+    return static_cast<::std::size_t>(hash);
+  }
+};
+
+/// (required, excluded) pair of a cached query
+template <typename Signature> struct query_key {
+  Signature required;
+  Signature excluded;
+
+  bool operator==(const query_key &other) const noexcept {
+    return required == other.required && excluded == other.excluded;
+  }
+};
+
+template <typename Signature> struct query_key_hash {
+  ::std::size_t operator()(const query_key<Signature> &key) const noexcept {
+    const signature_hash<Signature> hash;
+    return hash(key.required) * 31 + hash(key.excluded);
+  }
+};
+
+/// position of C in Types
+template <typename C, typename... Types> struct component_index;
+template <typename C, typename... Types>
+struct component_index<C, C, Types...> : ::std::integral_constant<::std::size_t, 0> {};
+template <typename C, typename First, typename... Types>
+struct component_index<C, First, Types...>
+    : ::std::integral_constant<::std::size_t, 1 + component_index<C, Types...>::value> {};
+
+template <typename Tuple, typename F, ::std::size_t... I>
+void for_each_column(Tuple &tuple, F &&function, ::std::index_sequence<I...>) {
+  const int expand[] = {0, (function(::std::get<I>(tuple), I), 0)...};
+  static_cast<void>(expand);
+}
+
+template <typename Tuple, typename F, ::std::size_t... I>
+void for_each_column_pair(Tuple &first, Tuple &second, F &&function,
+                          ::std::index_sequence<I...>) {
+  const int expand[] = {0, (function(::std::get<I>(first), ::std::get<I>(second)), 0)...};
+  static_cast<void>(expand);
+}
+
+} // namespace details
+
+/**
+ * @brief Entities grouped into archetypes by component signature
+ * @details Bit i of a signature is the component Components[i], higher bits are tags
+ * without storage. Every archetype stores its entities in chunks of ChunkRows rows with
+ * one array per component (structure of arrays). Destroying an entity moves the last
+ * row of its archetype into the hole, so rows stay dense
+ * @tparam Signature deaddev::bitmask or deaddev::wide_bitmask
+ * @tparam ChunkRows rows per chunk
+ * @tparam Components default constructible, move assignable component types
+ */
+template <typename Signature, ::std::size_t ChunkRows, typename... Components>
+class archetype_registry {
+  static_assert(ChunkRows > 0, "chunks need rows");
+  using columns_type = ::std::tuple<::std::unique_ptr<Components[]>...>;
+  using indices = ::std::index_sequence_for<Components...>;
+
+  struct chunk_storage {
+    ::std::unique_ptr<::deaddev::entity[]> entities;
+    columns_type columns;
+    ::std::size_t size = 0;
+  };
+
+  struct archetype_storage {
+    Signature signature;
+    ::std::vector<chunk_storage> chunks;
+    ::std::size_t size = 0;
+  };
+
+  struct entity_record {
+    ::std::size_t archetype;
+    ::std::size_t row;
+    ::std::uint32_t generation;
+  };
+
+  struct cached_query {
+    ::std::vector<::std::size_t> archetypes;
+    /// archetypes already matched
+    ::std::size_t checked = 0;
+  };
+
+public:
+  using signature_type = Signature;
+  /// returned for missing archetypes
+  static constexpr ::std::size_t npos = ~::std::size_t{0};
+
+  /**
+   * @brief Rows of one chunk
+   * @details column<C>() is nullptr when the archetype has no C
+   */
+  class chunk {
+  public:
+    /// number of rows
+    DEADDEV_NODISCARD ::std::size_t size() const noexcept { return storage_->size; }
+    /// signature of the archetype
+    DEADDEV_NODISCARD const Signature &signature() const noexcept { return *signature_; }
+    /// entity of every row
+    DEADDEV_NODISCARD const ::deaddev::entity *entities() const noexcept {
+      return storage_->entities.get();
+    }
+    /// component C of every row or nullptr
+    template <typename C> DEADDEV_NODISCARD C *column() const noexcept {
+      return ::std::get<::deaddev::details::component_index<C, Components...>::value>(
+                 storage_->columns)
+          .get();
+    }
+
+  private:
+    friend class archetype_registry;
+    chunk(const Signature *signature, chunk_storage *storage) noexcept
+        : signature_(signature), storage_(storage) {}
+    const Signature *signature_;
+    chunk_storage *storage_;
+  };
+
+  /**
+   * @brief Creates an entity
+   * @param signature components and tags, components are default constructed
+   * @return entity handle
+   */
+  ::deaddev::entity create(const Signature &signature) {
+    ::std::uint32_t index;
+    if (free_.empty()) {
+      index = static_cast<::std::uint32_t>(records_.size());
+      records_.push_back(entity_record{npos, 0, 0});
+    } else {
+      index = free_.back();
+      free_.pop_back();
+    }
+    const ::deaddev::entity result{index, records_[index].generation};
+    const ::std::size_t archetype = find_or_add(signature);
+    records_[index].archetype = archetype;
+    records_[index].row = append_row(archetype, result);
+    return result;
+  }
+
+  /**
+   * @brief Destroys an entity
+   * @return false if the handle is stale
+   */
+  bool destroy(::deaddev::entity handle) {
+    if (!alive(handle)) {
+      return false;
+    }
+    entity_record &record = records_[handle.index];
+    remove_row(record.archetype, record.row);
+    record.archetype = npos;
+    ++record.generation;
+    free_.push_back(handle.index);
+    return true;
+  }
+
+  /**
+   * @brief Changes the signature of an entity
+   * @details Components in both signatures are moved, new ones default constructed
+   * @return false if the handle is stale
+   */
+  bool change(::deaddev::entity handle, const Signature &signature) {
+    if (!alive(handle)) {
+      return false;
+    }
+    const ::std::size_t target = find_or_add(signature);
+    entity_record &record = records_[handle.index];
+    if (target == record.archetype) {
+      return true;
+    }
+    const ::std::size_t row = append_row(target, handle);
+    chunk_storage &from = row_chunk(record.archetype, record.row);
+    chunk_storage &to = row_chunk(target, row);
+    const ::std::size_t from_row = record.row % ChunkRows;
+    const ::std::size_t to_row = row % ChunkRows;
+    ::deaddev::details::for_each_column_pair(
+        from.columns, to.columns,
+        [&](auto &source, auto &destination) {
+          if (source && destination) {
+            destination[to_row] = ::std::move(source[from_row]);
+          }
+        },
+        indices{});
+    remove_row(record.archetype, record.row);
+    record.archetype = target;
+    record.row = row;
+    return true;
+  }
+
+  /// true if the handle refers to a live entity
+  DEADDEV_NODISCARD bool alive(::deaddev::entity handle) const noexcept {
+    return handle.index < records_.size() && records_[handle.index].archetype != npos &&
+           records_[handle.index].generation == handle.generation;
+  }
+
+  /// signature of a live entity
+  DEADDEV_NODISCARD const Signature &signature(::deaddev::entity handle) const noexcept {
+    return archetypes_[records_[handle.index].archetype].signature;
+  }
+
+  /// component C of an entity or nullptr
+  template <typename C> DEADDEV_NODISCARD C *get(::deaddev::entity handle) noexcept {
+    if (!alive(handle)) {
+      return nullptr;
+    }
+    const entity_record &record = records_[handle.index];
+    C *column = ::std::get<::deaddev::details::component_index<C, Components...>::value>(
+                    row_chunk(record.archetype, record.row).columns)
+                    .get();
+    return column == nullptr ? nullptr : column + record.row % ChunkRows;
+  }
+
+  /// number of live entities
+  DEADDEV_NODISCARD ::std::size_t size() const noexcept {
+    return records_.size() - free_.size();
+  }
+  /// number of archetypes, archetypes are never removed
+  DEADDEV_NODISCARD ::std::size_t archetype_count() const noexcept {
+    return archetypes_.size();
+  }
+  /// signature of an archetype
+  DEADDEV_NODISCARD const Signature &archetype_signature(::std::size_t archetype) const noexcept {
+    return archetypes_[archetype].signature;
+  }
+  /// live entities of an archetype
+  DEADDEV_NODISCARD ::std::size_t archetype_size(::std::size_t archetype) const noexcept {
+    return archetypes_[archetype].size;
+  }
+
+  /**
+   * @brief Archetypes with all of required and none of excluded
+   * @details The result is cached per (required, excluded). Later calls only test the
+   * archetypes added since, so a stable set of archetypes makes queries a hash lookup
+   * @return archetype indices in creation order, valid until the next query or create
+   */
+  const ::std::vector<::std::size_t> &match(const Signature &required,
+                                            const Signature &excluded = Signature{}) {
+    cached_query &query = queries_[::deaddev::details::query_key<Signature>{required, excluded}];
+    for (; query.checked < archetypes_.size(); ++query.checked) {
+      const Signature &signature = archetypes_[query.checked].signature;
+      if ((signature & required) == required && (signature & excluded) == Signature{}) {
+        query.archetypes.push_back(query.checked);
+      }
+    }
+    return query.archetypes;
+  }
+
+  /// number of cached queries
+  DEADDEV_NODISCARD ::std::size_t cached_queries() const noexcept { return queries_.size(); }
+
+  /**
+   * @brief Visits the non-empty chunks of matching archetypes
+   * @param function `void(const chunk &)` callable, must not create, change or destroy
+   * entities
+   */
+  template <typename F>
+  void for_each_chunk(const Signature &required, const Signature &excluded, F &&function) {
+    for (const ::std::size_t archetype : match(required, excluded)) {
+      archetype_storage &storage = archetypes_[archetype];
+      for (chunk_storage &rows : storage.chunks) {
+        if (rows.size != 0) {
+          function(chunk(&storage.signature, &rows));
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Visits the non-empty chunks of matching archetypes on a worker pool
+   * @details Workers take chunks from a shared counter, so archetypes of different sizes
+   * balance. Chunks hold disjoint rows, so function may write their columns
+   * @tparam Pool class with `size()` and `run(function)` calling `function(index)` once on
+   * every worker, e.g. deaddev::pinned_worker_pool
+   * @param function `void(const chunk &, ::std::size_t worker)` callable, must not create,
+   * change or destroy entities
+   */
+  template <typename Pool, typename F>
+  void for_each_chunk_on(Pool &pool, const Signature &required, const Signature &excluded,
+                         F &&function) {
+    ::std::vector<chunk> work;
+    for (const ::std::size_t archetype : match(required, excluded)) {
+      archetype_storage &storage = archetypes_[archetype];
+      for (chunk_storage &rows : storage.chunks) {
+        if (rows.size != 0) {
+          work.push_back(chunk(&storage.signature, &rows));
+        }
+      }
+    }
+    ::std::atomic<::std::size_t> next{0};
+    pool.run([&](::std::size_t worker) {
+      for (::std::size_t index = next.fetch_add(1, ::std::memory_order_relaxed);
+           index < work.size(); index = next.fetch_add(1, ::std::memory_order_relaxed)) {
+        function(work[index], worker);
+      }
+    });
+  }
+
+private:
+  ::std::size_t find_or_add(const Signature &signature) {
+    const auto found = lookup_.find(signature);
+    if (found != lookup_.end()) {
+      return found->second;
+    }
+    archetype_storage storage;
+    storage.signature = signature;
+    archetypes_.push_back(::std::move(storage));
+    lookup_.emplace(signature, archetypes_.size() - 1);
+    return archetypes_.size() - 1;
+  }
+
+  chunk_storage &row_chunk(::std::size_t archetype, ::std::size_t row) noexcept {
+    return archetypes_[archetype].chunks[row / ChunkRows];
+  }
+
+  ::std::size_t append_row(::std::size_t archetype, ::deaddev::entity handle) {
+    archetype_storage &storage = archetypes_[archetype];
+    const ::std::size_t row = storage.size;
+    if (row / ChunkRows == storage.chunks.size()) {
+      chunk_storage rows;
+      rows.entities.reset(new ::deaddev::entity[ChunkRows]);
+      const Signature &signature = storage.signature;
+      ::deaddev::details::for_each_column(
+          rows.columns,
+          [&](auto &column, ::std::size_t index) {
+            const Signature bit = ::deaddev::details::signature_bit(signature, index);
+            if ((signature & bit) == bit) {
+              using component_type = typename ::std::remove_reference<decltype(column[0])>::type;
+              column.reset(new component_type[ChunkRows]());
+            }
+          },
+          indices{});
+      storage.chunks.push_back(::std::move(rows));
+    }
+    chunk_storage &rows = storage.chunks[row / ChunkRows];
+    rows.entities[row % ChunkRows] = handle;
+    ++rows.size;
+    ++storage.size;
+    return row;
+  }
+
+  /// moves the last row into row, then resets the vacated row
+  void remove_row(::std::size_t archetype, ::std::size_t row) {
+    archetype_storage &storage = archetypes_[archetype];
+    const ::std::size_t last = storage.size - 1;
+    chunk_storage &hole = storage.chunks[row / ChunkRows];
+    chunk_storage &tail = storage.chunks[last / ChunkRows];
+    const ::std::size_t hole_row = row % ChunkRows;
+    const ::std::size_t tail_row = last % ChunkRows;
+    ::deaddev::details::for_each_column_pair(
+        hole.columns, tail.columns,
+        [&](auto &destination, auto &source) {
+          if (destination) {
+            using component_type =
+                typename ::std::remove_reference<decltype(destination[0])>::type;
+            if (row != last) {
+              destination[hole_row] = ::std::move(source[tail_row]);
+            }
+            source[tail_row] = component_type();
+          }
+        },
+        indices{});
+    if (row != last) {
+      const ::deaddev::entity moved = tail.entities[tail_row];
+      hole.entities[hole_row] = moved;
+      records_[moved.index].row = row;
+    }
+    --tail.size;
+    --storage.size;
+  }
+
+  ::std::vector<archetype_storage> archetypes_;
+  ::std::unordered_map<Signature, ::std::size_t, ::deaddev::details::signature_hash<Signature>>
+      lookup_;
+  ::std::unordered_map<::deaddev::details::query_key<Signature>, cached_query,
+                       ::deaddev::details::query_key_hash<Signature>>
+      queries_;
+  ::std::vector<entity_record> records_;
+  ::std::vector<::std::uint32_t> free_;
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_ARCHETYPE_REGISTRY_HPP
@@ -0,0 +1,226 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Atomic bitmask
+ * @details `::std::atomic` over the mask type of `bitmask<T>` plus a futex based parking word
+ * for consumers that sleep until a mask changes
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_ATOMIC_BITMASK_HPP
+#define DEADDEV_ATOMIC_BITMASK_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace deaddev {
+
+/**
+ * @brief Atomic bitmask
+ * @details read-modify-write operations return the previous value like `::std::atomic`
+ * @tparam T enum type
+ */
+template <typename T> class atomic_bitmask {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// mask type
+  using mask_type = typename value_type::mask_type;
+  /// enum type
+  using enum_type = T;
+
+  /// empty mask
+  constexpr atomic_bitmask() noexcept : mask_(0) {}
+  /// initial mask
+  constexpr atomic_bitmask(value_type value) noexcept : mask_(static_cast<mask_type>(value)) {}
+  atomic_bitmask(const atomic_bitmask &) = delete;
+  atomic_bitmask &operator=(const atomic_bitmask &) = delete;
+
+  /// atomic load
+  DEADDEV_NODISCARD value_type
+  load(::std::memory_order order = ::std::memory_order_seq_cst) const noexcept {
+    return value_type{mask_.load(order)};
+  }
+
+  /// atomic store
+  void store(value_type value,
+             ::std::memory_order order = ::std::memory_order_seq_cst) noexcept {
+    mask_.store(static_cast<mask_type>(value), order);
+  }
+
+  /// atomic exchange, returns previous mask
+  value_type exchange(value_type value,
+                      ::std::memory_order order = ::std::memory_order_seq_cst) noexcept {
+    return value_type{mask_.exchange(static_cast<mask_type>(value), order)};
+  }
+
+  /// sets flags, returns previous mask
+  value_type fetch_or(value_type value,
+                      ::std::memory_order order = ::std::memory_order_seq_cst) noexcept {
+    return value_type{mask_.fetch_or(static_cast<mask_type>(value), order)};
+  }
+
+  /// keeps only flags of value, returns previous mask
+  value_type fetch_and(value_type value,
+                       ::std::memory_order order = ::std::memory_order_seq_cst) noexcept {
+    return value_type{mask_.fetch_and(static_cast<mask_type>(value), order)};
+  }
+
+  /// toggles flags, returns previous mask
+  value_type fetch_xor(value_type value,
+                       ::std::memory_order order = ::std::memory_order_seq_cst) noexcept {
+    return value_type{mask_.fetch_xor(static_cast<mask_type>(value), order)};
+  }
+
+  /// clears flags, returns previous mask
+  value_type fetch_remove(value_type value,
+                          ::std::memory_order order = ::std::memory_order_seq_cst) noexcept {
+    return value_type{mask_.fetch_and(static_cast<mask_type>(~value), order)};
+  }
+
+  /**
+   * @brief atomic compare and exchange
+   * @param expected expected mask, updated with the current one on failure
+   * @param desired new mask
+   * @return true if the mask was replaced
+   */
+  bool compare_exchange_weak(value_type &expected, value_type desired,
+                             ::std::memory_order order = ::std::memory_order_seq_cst) noexcept {
+    auto mask = static_cast<mask_type>(expected);
+    const bool result = mask_.compare_exchange_weak(mask, static_cast<mask_type>(desired), order);
+    expected = value_type{mask};
+    return result;
+  }
+
+  /// @copydoc compare_exchange_weak
+  bool compare_exchange_strong(value_type &expected, value_type desired,
+                               ::std::memory_order order = ::std::memory_order_seq_cst) noexcept {
+    auto mask = static_cast<mask_type>(expected);
+    const bool result =
+        mask_.compare_exchange_strong(mask, static_cast<mask_type>(desired), order);
+    expected = value_type{mask};
+    return result;
+  }
+
+  /// true if the operations are lock-free
+  DEADDEV_NODISCARD bool is_lock_free() const noexcept { return mask_.is_lock_free(); }
+
+private:
+  ::std::atomic<mask_type> mask_;
+};
+
+namespace details {
+
+/**
+ * @brief Word to sleep on until another thread bumps it
+ * @details Futex on Linux, mutex and condition variable elsewhere. Waiters are counted so
+ * that waking nobody costs one load
+ */
+class parking_word {
+public:
+  parking_word() = default;
+  parking_word(const parking_word &) = delete;
+  parking_word &operator=(const parking_word &) = delete;
+
+  /**
+   * @brief Sleeps until woken or ready() returns true
+   * @details ready is checked after the waiter is published, so a state change followed
+   * by wake() in another thread is never missed. May return spuriously, call it in a loop
+   * @param ready predicate over the watched state
+   */
+  template <typename F> void wait(F &&ready) {
+    waiters_.fetch_add(1, ::std::memory_order_seq_cst);
+    const ::std::uint32_t epoch = epoch_.load(::std::memory_order_seq_cst);
+    if (!ready()) {
+#if defined(__linux__)
+      ::syscall(SYS_futex, reinterpret_cast<::std::uint32_t *>(&epoch_), FUTEX_WAIT_PRIVATE,
+                epoch, nullptr, nullptr, 0);
+#else
+      ::std::unique_lock<::std::mutex> lock(lock_);
+      condition_.wait(lock, [&] { return epoch_.load(::std::memory_order_relaxed) != epoch; });
+#endif
+    }
+    waiters_.fetch_sub(1, ::std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Wakes sleeping threads
+   * @details call after the state change that ready() observes
+   * @param all wake every waiter instead of one
+   */
+  void wake(bool all = false) noexcept {
+    if (waiters_.load(::std::memory_order_seq_cst) == 0) {
+      return;
+    }
+#if defined(__linux__)
+    epoch_.fetch_add(1, ::std::memory_order_seq_cst);
+    ::syscall(SYS_futex, reinterpret_cast<::std::uint32_t *>(&epoch_), FUTEX_WAKE_PRIVATE,
+              all ? INT_MAX : 1, nullptr, nullptr, 0);
+#else
+    {
+      ::std::lock_guard<::std::mutex> lock(lock_);
+      epoch_.fetch_add(1, ::std::memory_order_seq_cst);
+    }
+    if (all) {
+      condition_.notify_all();
+    } else {
+      condition_.notify_one();
+    }
+#endif
+  }
+
+private:
+  static_assert(sizeof(::std::atomic<::std::uint32_t>) == sizeof(::std::uint32_t),
+                "futex word must be a plain 32-bit integer");
+  ::std::atomic<::std::uint32_t> epoch_{0};
+  ::std::atomic<::std::uint32_t> waiters_{0};
+#if !defined(__linux__)
+  ::std::mutex lock_;
+  ::std::condition_variable condition_;
+#endif
+};
+
+} // namespace details
+
+} // namespace deaddev
+
+#endif // DEADDEV_ATOMIC_BITMASK_HPP
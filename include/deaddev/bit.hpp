@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Bit manipulation helpers
+ * @details C++14 replacements for `<bit>` used by the bulk algorithms and containers
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_BIT_HPP
+#define DEADDEV_BIT_HPP
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace deaddev {
+namespace details {
+
+/**
+ * @brief number of trailing zero bits
+ * @param value value, must not be zero
+ * @return int index of the lowest set bit
+ */
+inline auto countr_zero(::std::uint64_t value) noexcept -> int {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(value);
+#else
+  int result = 0;
+  while ((value & 1) == 0) {
+    value >>= 1;
+    ++result;
+  }
+  return result;
+#endif
+}
+
+/**
+ * @brief number of leading zero bits
+ * @param value value, must not be zero
+ * @return int 63 - index of the highest set bit
+ */
+inline auto countl_zero(::std::uint64_t value) noexcept -> int {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return 63 - static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_clzll(value);
+#else
+  int result = 0;
+  while ((value & (::std::uint64_t{1} << 63)) == 0) {
+    value <<= 1;
+    ++result;
+  }
+  return result;
+#endif
+}
+
+/**
+ * @brief number of set bits
+ * @param value value
+ * @return int number of ones
+ */
+inline auto popcount(::std::uint64_t value) noexcept -> int {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(value);
+#else
+  value = value - ((value >> 1) & 0x5555555555555555ull);
+  value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+  value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+  return static_cast<int>((value * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/**
+ * @brief number of set bits in constant expressions
+ * @param value value
+ * @return ::std::size_t number of ones
+ */
+constexpr auto constexpr_popcount(::std::uint64_t value) noexcept -> ::std::size_t {
+  ::std::size_t result = 0;
+  for (; value != 0; value &= value - 1) {
+    ++result;
+  }
+  return result;
+}
+
+/**
+ * @brief mask of the lowest bits
+ * @param count number of bits in [0, 64]
+ * @return ::std::uint64_t value with `count` lowest bits set
+ */
+constexpr auto low_bits(unsigned count) noexcept -> ::std::uint64_t {
+  return count >= 64 ? ~::std::uint64_t{0} : (::std::uint64_t{1} << count) - 1;
+}
+
+/**
+ * @brief index of the only bit of a flag
+ * @param flag enum value with one bit set
+ * @return ::std::size_t bit index
+ */
+template <typename T> auto flag_index(T flag) noexcept -> ::std::size_t {
+  return static_cast<::std::size_t>(::deaddev::details::countr_zero(static_cast<::std::uint64_t>(
+      static_cast<::std::make_unsigned_t<::std::underlying_type_t<T>>>(flag))));
+}
+
+} // namespace details
+} // namespace deaddev
+
+#endif // DEADDEV_BIT_HPP
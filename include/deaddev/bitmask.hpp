@@ -37,6 +37,8 @@
 #ifndef DEADDEV_BITMASK_HPP
 #define DEADDEV_BITMASK_HPP
 #pragma once
+#include <deaddev/bitmask_macros.hpp>
+
 #include <climits>
 #include <type_traits>
 #include <cstddef>
@@ -49,6 +51,14 @@
 #endif
 #endif
 
+#ifndef DEADDEV_IS_ENUM
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define DEADDEV_IS_ENUM(T) __is_enum(T)
+#else
+#define DEADDEV_IS_ENUM(T) ::std::is_enum<T>::value
+#endif
+#endif
+
 #ifndef DEADDEV_NODISCARD
 #if defined(__has_cpp_attribute) && __has_cpp_attribute(nodiscard)
 #define DEADDEV_NODISCARD [[nodiscard]]
@@ -119,45 +129,11 @@ DEADDEV_CONSTEVAL auto combine_flags(::std::underlying_type_t<T> &result, T valu
   result |= static_cast<::std::underlying_type_t<T>>(value);
 }
 
-#if __cplusplus < 201703L
-/**
- * @brief sentinel recursion overload for all flags calculation
- *
- * @tparam T enum type
- * @param val value
- * @return T value
- */
-template <typename T>
-DEADDEV_CONSTEVAL auto calculate_all_flags_cpp_before_17(T val) -> T {
-  return static_cast<T>(val);
-}
-/**
- * @brief C++14 implementation for calculate_all_flags
- *
- * @tparam T enum type
- * @tparam Args enum values
- * @param arg first enum value
- * @param args rest of values
- * @return T combined valuees
- */
-template <typename T, typename... Args>
-DEADDEV_CONSTEVAL auto calculate_all_flags_cpp_before_17(T arg, Args... args) -> T {
-  return static_cast<T>(static_cast<typename ::std::underlying_type<T>::type>(arg) |
-                        static_cast<typename ::std::underlying_type<T>::type>(
-                            calculate_all_flags_cpp_before_17(args...)));
-}
-#else
-template <typename T, typename... Args>
-DEADDEV_CONSTEVAL auto calculate_all_flags_cpp_17(Args... args) -> T {
-  ::std::underlying_type_t<T> result{0};
-  (::deaddev::details::combine_flags(result, args), ...);
-  return static_cast<T>(result);
-}
-#endif
-
 /**
  * @brief Combines flags
- * @details Uses folding expressions to easily combine all flags using binary or operator
+ * @details Expands the pack in a single function body (fold expression since C++17,
+ * array initializer before), so a long flags list costs one instantiation instead of
+ * one per value
  * @tparam T enum type
  * @tparam Args enum types or integers
  * @param args all flags list
@@ -165,11 +141,14 @@ DEADDEV_CONSTEVAL auto calculate_all_flags_cpp_17(Args... args) -> T {
  */
 template <typename T, typename... Args>
 DEADDEV_CONSTEVAL auto calculate_all_flags(Args... args) -> T {
+  ::std::underlying_type_t<T> result{0};
 #if __cplusplus < 201703L
-  return calculate_all_flags_cpp_before_17<T>(args...);
+  const int expansion[] = {0, (::deaddev::details::combine_flags(result, args), 0)...};
+  static_cast<void>(expansion);
 #else
-  return calculate_all_flags_cpp_17<T>(args...);
+  (::deaddev::details::combine_flags(result, args), ...);
 #endif
+  return static_cast<T>(result);
 }
 /**
  * @brief returns all flags
@@ -215,17 +194,45 @@ struct bitmask_operations_check_traits
 
 /**
  * @brief Is T a bitmask type
- * @details Check if the bitmask operations are enabled for T
+ * @details Primary template is picked for non-enum types, so the free operators reject
+ * them without looking up bitmask traits
+ * @tparam T any type
+ * @tparam bool is T an enum
+ */
+template <typename T, bool = DEADDEV_IS_ENUM(T)>
+struct is_bitmask : ::std::false_type {};
+
+/**
+ * @brief Is T a bitmask type
+ * @details Check if the bitmask operations are enabled for enum T. Traits are looked up
+ * once per enum and cached by the class template instantiation
  * @tparam T enum type
- * @tparam typename SFINAE
  */
-template <typename T,
-          typename = typename ::std::enable_if<::std::is_enum<T>::value>::type>
-constexpr bool is_bitmask_v =
+template <typename T>
+struct is_bitmask<T, true>
+    : ::std::integral_constant<bool,
 #ifdef DEADDEV_ENABLE_BITMASKS_FOR_SCOPED_ENUMS
-    ::deaddev::details::is_scoped_enum_v<T> ||
+                               ::deaddev::details::is_scoped_enum_v<T> ||
 #endif
-    ::deaddev::details::bitmask_operations_check_traits<T>::enable;
+                               ::deaddev::details::bitmask_operations_check_traits<
+                                   T>::enable> {
+};
+
+/**
+ * @brief Is T a bitmask type
+ * @tparam T any type
+ */
+template <typename T>
+constexpr bool is_bitmask_v = ::deaddev::details::is_bitmask<T>::value;
+
+/**
+ * @brief SFINAE helper for the free operators
+ * @details single alias so every operator costs one cached trait lookup
+ * @tparam T any type
+ */
+template <typename T>
+using enable_if_bitmask_t =
+    typename ::std::enable_if<::deaddev::details::is_bitmask<T>::value, T>::type;
 
 /**
  * @brief All flags combined
@@ -240,6 +247,76 @@ constexpr T bitmask_all_flags_v =
 
 } // namespace details
 
+/**
+ * @brief Operation reported to instrumentation hooks
+ */
+enum class bitmask_operation : unsigned {
+  /// bitmask::set
+  set,
+  /// bitmask::remove
+  remove,
+  /// bitmask::is_set
+  test,
+  /// operator|=
+  or_assign,
+  /// operator&=
+  and_assign,
+  /// operator^=
+  xor_assign,
+};
+
+namespace details {
+
+/**
+ * @brief default instrumentation
+ * @details hooks are disabled, no hook is ever instantiated
+ */
+struct disabled_bitmask_instrumentation {
+  /// for tag dispatch
+  static constexpr bool enabled = false;
+};
+
+/**
+ * @brief instrumentation registered with DEADDEV_INSTRUMENT_BITMASK
+ * @tparam Policy class with `static void on_operation(bitmask_operation operation,
+ * mask_type mask, mask_type operand)`
+ */
+template <typename Policy> struct enabled_bitmask_instrumentation : Policy {
+  /// for tag dispatch
+  static constexpr bool enabled = true;
+};
+
+/**
+ * @brief noop
+ * @details used to get the instrumentation policy using argument-dependent lookup (ADL)
+ * @param ... placeholder for ADL
+ * @return ::deaddev::details::disabled_bitmask_instrumentation default policy
+ */
+auto adl_bitmask_instrumentation(...) -> ::deaddev::details::disabled_bitmask_instrumentation;
+
+/**
+ * @brief instrumentation policy of T
+ * @details wrapper for cases when we can't use ADL (e.g. for external libraries)
+ * @tparam T enum type
+ */
+template <typename T>
+struct bitmask_instrumentation_traits
+    : decltype(adl_bitmask_instrumentation(::std::declval<T &>())){};
+
+/// disabled instrumentation, compiles to nothing
+template <typename T, typename M>
+constexpr void instrument_bitmask(::std::false_type, ::deaddev::bitmask_operation, M,
+                                  M) noexcept {}
+
+/// forwards the operation to the registered policy
+template <typename T, typename M>
+void instrument_bitmask(::std::true_type, ::deaddev::bitmask_operation operation, M mask,
+                        M operand) noexcept {
+  ::deaddev::details::bitmask_instrumentation_traits<T>::on_operation(operation, mask, operand);
+}
+
+} // namespace details
+
 /**
  * @brief Bitmask class type
  * @details Wrapper for enums to use their values as bit flags/masks
@@ -327,6 +404,14 @@ public:
     return mask_ > mask;
   }
   /// comparison operator
+  DEADDEV_NODISCARD constexpr bool operator==(enum_type flag) const noexcept {
+    return mask_ == static_cast<mask_type>(flag);
+  }
+  /// comparison operator
+  DEADDEV_NODISCARD constexpr bool operator!=(enum_type flag) const noexcept {
+    return mask_ != static_cast<mask_type>(flag);
+  }
+  /// comparison operator
   DEADDEV_NODISCARD constexpr bool operator==(bitmask other) const noexcept {
     return mask_ == other.mask_;
   }
@@ -373,18 +458,21 @@ public:
 
   /// comparison operator
   constexpr bitmask &operator^=(bitmask other) noexcept {
+    instrument(::deaddev::bitmask_operation::xor_assign, other.mask_);
     mask_ ^= other.mask_;
     return *this;
   }
 
   /// comparison operator
   constexpr bitmask &operator|=(bitmask other) noexcept {
+    instrument(::deaddev::bitmask_operation::or_assign, other.mask_);
     mask_ |= other.mask_;
     return *this;
   }
 
   /// comparison operator
   constexpr bitmask &operator&=(bitmask other) noexcept {
+    instrument(::deaddev::bitmask_operation::and_assign, other.mask_);
     mask_ &= other.mask_;
     return *this;
   }
@@ -406,18 +494,21 @@ public:
 
   /// comparison operator
   constexpr bitmask &operator^=(enum_type other) noexcept {
+    instrument(::deaddev::bitmask_operation::xor_assign, static_cast<mask_type>(other));
     mask_ ^= static_cast<mask_type>(other);
     return *this;
   }
 
   /// comparison operator
   constexpr bitmask &operator|=(enum_type other) noexcept {
+    instrument(::deaddev::bitmask_operation::or_assign, static_cast<mask_type>(other));
     mask_ |= static_cast<mask_type>(other);
     return *this;
   }
 
   /// comparison operator
   constexpr bitmask &operator&=(enum_type other) noexcept {
+    instrument(::deaddev::bitmask_operation::and_assign, static_cast<mask_type>(other));
     mask_ &= static_cast<mask_type>(other);
     return *this;
   }
@@ -431,6 +522,7 @@ public:
    * @return false flag is not in the mask
    */
   DEADDEV_NODISCARD constexpr bool is_set(enum_type flag) const noexcept {
+    instrument(::deaddev::bitmask_operation::test, static_cast<mask_type>(flag));
     return (mask_ & static_cast<mask_type>(flag)) == static_cast<mask_type>(flag);
   }
 
@@ -443,6 +535,7 @@ public:
    * @return false some or all flags is not in the mask
    */
   DEADDEV_NODISCARD constexpr bool is_set(bitmask other) const noexcept {
+    instrument(::deaddev::bitmask_operation::test, other.mask_);
     return (mask_ & other.mask_) == other.mask_;
   }
 
@@ -452,7 +545,11 @@ public:
    * @param flag enum value
    * @return bitmask& call chaining
    */
-  constexpr bitmask &set(enum_type flag) noexcept { return *this |= flag; }
+  constexpr bitmask &set(enum_type flag) noexcept {
+    instrument(::deaddev::bitmask_operation::set, static_cast<mask_type>(flag));
+    mask_ |= static_cast<mask_type>(flag);
+    return *this;
+  }
 
   /**
    * @brief Combine bit mask with an enum value
@@ -460,7 +557,11 @@ public:
    * @param other bit mask
    * @return bitmask& call chaining
    */
-  constexpr bitmask &set(bitmask other) noexcept { return *this |= other.mask_; }
+  constexpr bitmask &set(bitmask other) noexcept {
+    instrument(::deaddev::bitmask_operation::set, other.mask_);
+    mask_ |= other.mask_;
+    return *this;
+  }
 
   /**
    * @brief Combine bit mask with an enum value
@@ -468,7 +569,11 @@ public:
    * @param flag enum value
    * @return bitmask& call chaining
    */
-  constexpr bitmask &remove(enum_type flag) noexcept { return *this ^= flag; }
+  constexpr bitmask &remove(enum_type flag) noexcept {
+    instrument(::deaddev::bitmask_operation::remove, static_cast<mask_type>(flag));
+    mask_ ^= static_cast<mask_type>(flag);
+    return *this;
+  }
 
   /**
    * @brief Combine bit mask with an enum value
@@ -476,9 +581,22 @@ public:
    * @param other bit mask
    * @return bitmask& call chaining
    */
-  constexpr bitmask &remove(bitmask other) noexcept { return *this ^= other.mask_; }
+  constexpr bitmask &remove(bitmask other) noexcept {
+    instrument(::deaddev::bitmask_operation::remove, other.mask_);
+    mask_ ^= other.mask_;
+    return *this;
+  }
 
 private:
+  /// reports an operation to the instrumentation policy of T, if there's one
+  constexpr void instrument(::deaddev::bitmask_operation operation,
+                            mask_type operand) const noexcept {
+    ::deaddev::details::instrument_bitmask<enum_type>(
+        ::std::integral_constant<
+            bool, ::deaddev::details::bitmask_instrumentation_traits<enum_type>::enabled>{},
+        operation, mask_, operand);
+  }
+
   /// bit mask value
   mask_type mask_{};
 };
@@ -486,120 +604,97 @@ private:
 } // namespace deaddev
 
 // Out of namespace because of ADL
+// Operators taking deaddev::bitmask<T> need no constraint: T is deduced from the
+// bitmask itself, which already requires T to be a bitmask enum
 
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator==(T left, deaddev::bitmask<T> right) noexcept {
   return right == left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator!=(T left, deaddev::bitmask<T> right) noexcept {
   return right != left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator>=(T left, deaddev::bitmask<T> right) noexcept {
   return right <= left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator<=(T left, deaddev::bitmask<T> right) noexcept {
   return right >= left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator<(T left, deaddev::bitmask<T> right) noexcept {
   return right > left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator>(T left, deaddev::bitmask<T> right) noexcept {
   return right < left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator==(typename std::underlying_type<T>::type left,
                                             deaddev::bitmask<T> right) noexcept {
   return right == left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator!=(typename std::underlying_type<T>::type left,
                                             deaddev::bitmask<T> right) noexcept {
   return right != left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator>=(typename std::underlying_type<T>::type left,
                                             deaddev::bitmask<T> right) noexcept {
   return right <= left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator<=(typename std::underlying_type<T>::type left,
                                             deaddev::bitmask<T> right) noexcept {
   return right >= left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator<(typename std::underlying_type<T>::type left,
                                            deaddev::bitmask<T> right) noexcept {
   return right > left; // reversed order
 }
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr bool operator>(typename std::underlying_type<T>::type left,
                                            deaddev::bitmask<T> right) noexcept {
   return right < left; // reversed order
 }
 
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T, typename = ::deaddev::details::enable_if_bitmask_t<T>>
 DEADDEV_NODISCARD constexpr deaddev::bitmask<T> operator~(T flag) noexcept {
   return ~deaddev::bitmask<T>(flag);
 }
 
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T, typename = ::deaddev::details::enable_if_bitmask_t<T>>
 DEADDEV_NODISCARD constexpr deaddev::bitmask<T> operator^(T left, T right) noexcept {
   return deaddev::bitmask<T>(left) ^ right;
 }
 
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T, typename = ::deaddev::details::enable_if_bitmask_t<T>>
 DEADDEV_NODISCARD constexpr deaddev::bitmask<T> operator|(T left, T right) noexcept {
   return deaddev::bitmask<T>(left) | right;
 }
 
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T, typename = ::deaddev::details::enable_if_bitmask_t<T>>
 DEADDEV_NODISCARD constexpr deaddev::bitmask<T> operator&(T left, T right) noexcept {
   return deaddev::bitmask<T>(left) & right;
 }
 
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr deaddev::bitmask<T> operator^(T left, ::deaddev::bitmask<T> right) noexcept {
   return right ^ left;
 }
 
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr deaddev::bitmask<T> operator|(T left, ::deaddev::bitmask<T> right) noexcept {
   return right | left;
 }
 
-template <typename T, typename = ::std::enable_if<::deaddev::details::is_bitmask_v<T>>>
+template <typename T>
 DEADDEV_NODISCARD constexpr deaddev::bitmask<T> operator&(T left, ::deaddev::bitmask<T> right) noexcept {
   return right & left;
 }
 
-/**
- * @brief Enable bitmask operations for enum
- * @details defines `auto adl_bitmask_operations_check(T) ->
- * ::deaddev::details::bitmask_traits<T, ...>` function for ADL-based type checks
- * @param T enum type
- * @param ... optional enum values list for all flags calculation
- */
-#define DEADDEV_ENABLE_BITMASK(T, ...)                                                   \
-  auto adl_bitmask_operations_check(T &) -> ::deaddev::details::bitmask_traits<          \
-      T, ::deaddev::details::calculate_all_flags<T>(__VA_ARGS__)>;
-
-/**
- * @brief Enable bitmask operations for enum
- * @details defines template specialization for
- * `struct ::deaddev::details::bitmask_operations_check_traits<T>`
- * for ADL-independent type checks
- * @param T enum type
- * @param ... optional enum values list for all flags calculation
- */
-#define DEADDEV_ENABLE_BITMASK_EXTERNAL(T, ...)                                          \
-  template <>                                                                            \
-  struct ::deaddev::details::bitmask_operations_check_traits<T>                          \
-      : ::deaddev::details::bitmask_traits<                                              \
-            T, ::deaddev::details::calculate_all_flags<T>(__VA_ARGS__)> {};
-
 #endif // DEADDEV_BITMASK_HPP
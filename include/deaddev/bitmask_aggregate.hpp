@@ -0,0 +1,664 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Streaming aggregation over bitmask columns
+ * @details Per-flag counts, flag co-occurrence and exact-mask counts over arrays or files
+ * larger than memory. Files are read in fixed-size chunks with double buffering while all
+ * cores aggregate the previous chunk
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_BITMASK_AGGREGATE_HPP
+#define DEADDEV_BITMASK_AGGREGATE_HPP
+#pragma once
+#include <deaddev/bit.hpp>
+#include <deaddev/bitmask.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace deaddev {
+namespace details {
+
+/// number of bits of the mask type of T
+template <typename T>
+constexpr ::std::size_t mask_bits = sizeof(typename ::deaddev::bitmask<T>::mask_type) * CHAR_BIT;
+
+/**
+ * @brief Transposes up to 64 rows into bit planes
+ * @details bit i of planes[b] is bit b of rows[i]
+ * @param rows first row
+ * @param count number of rows, at most 64
+ * @param planes output
+ */
+template <typename T>
+void bit_planes(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                ::std::uint64_t (&planes)[mask_bits<T>]) noexcept {
+  using unsigned_type = ::std::make_unsigned_t<typename ::deaddev::bitmask<T>::mask_type>;
+  for (::std::size_t bit = 0; bit < mask_bits<T>; ++bit) {
+    planes[bit] = 0;
+  }
+  for (::std::size_t i = 0; i < count; ++i) {
+    const auto row = static_cast<unsigned_type>(
+        static_cast<typename ::deaddev::bitmask<T>::mask_type>(rows[i]));
+    for (::std::size_t bit = 0; bit < mask_bits<T>; ++bit) {
+      planes[bit] |= static_cast<::std::uint64_t>((row >> bit) & 1u) << i;
+    }
+  }
+}
+
+/// closes spill files
+struct file_closer {
+  void operator()(::std::FILE *file) const noexcept { ::std::fclose(file); }
+};
+
+} // namespace details
+
+/**
+ * @brief Number of rows with each flag set
+ * @details Keeps a 256-entry histogram per byte of the mask, one increment per byte and row.
+ * Flag counts are summed from the histograms when queried
+ * @tparam T enum type
+ */
+template <typename T> class flag_counts {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// enum type
+  using enum_type = T;
+  /// number of bits
+  static constexpr ::std::size_t bits = ::deaddev::details::mask_bits<T>;
+
+  /// adds rows
+  void add(const value_type *rows, ::std::size_t count) noexcept {
+    for (::std::size_t i = 0; i < count; ++i) {
+      const auto row = static_cast<unsigned_type>(static_cast<mask_type>(rows[i]));
+      for (::std::size_t byte = 0; byte < bytes; ++byte) {
+        ++histograms_[byte][(row >> (byte * 8)) & 0xFFu];
+      }
+    }
+    rows_ += count;
+  }
+
+  /// adds counts of another aggregator
+  void merge(const flag_counts &other) noexcept {
+    for (::std::size_t byte = 0; byte < bytes; ++byte) {
+      for (::std::size_t value = 0; value < 256; ++value) {
+        histograms_[byte][value] += other.histograms_[byte][value];
+      }
+    }
+    rows_ += other.rows_;
+  }
+
+  /// empty aggregator with the same settings
+  DEADDEV_NODISCARD flag_counts split() const noexcept { return flag_counts{}; }
+
+  /// rows with bit set
+  DEADDEV_NODISCARD ::std::uint64_t operator[](::std::size_t bit) const noexcept {
+    ::std::uint64_t result = 0;
+    for (::std::size_t value = 0; value < 256; ++value) {
+      if ((value >> (bit % 8)) & 1u) {
+        result += histograms_[bit / 8][value];
+      }
+    }
+    return result;
+  }
+
+  /// rows with flag set
+  DEADDEV_NODISCARD ::std::uint64_t count(enum_type flag) const noexcept {
+    return (*this)[::deaddev::details::flag_index(flag)];
+  }
+
+  /// number of added rows
+  DEADDEV_NODISCARD ::std::uint64_t rows() const noexcept { return rows_; }
+
+private:
+  using mask_type = typename value_type::mask_type;
+  using unsigned_type = ::std::make_unsigned_t<mask_type>;
+  static constexpr ::std::size_t bytes = sizeof(mask_type);
+
+  ::std::uint64_t histograms_[bytes][256] = {};
+  ::std::uint64_t rows_ = 0;
+};
+
+/**
+ * @brief Number of rows with each pair of flags set
+ * @details Masks of up to 16 bits are counted in a dense histogram and pairs are summed from
+ * it when queried. Wider masks are transposed 64 rows at a time into bit planes, and a pair
+ * costs one popcount per 64 rows
+ * @tparam T enum type
+ */
+template <typename T> class cooccurrence_counts {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// enum type
+  using enum_type = T;
+  /// number of bits
+  static constexpr ::std::size_t bits = ::deaddev::details::mask_bits<T>;
+  /// true if masks are counted in a dense histogram
+  static constexpr bool dense = bits <= 16;
+
+  cooccurrence_counts() : counts_(dense ? ::std::size_t{1} << (dense ? bits : 0) : bits * bits) {}
+
+  /// adds rows
+  void add(const value_type *rows, ::std::size_t count) noexcept {
+    rows_ += count;
+    if (dense) {
+      for (::std::size_t i = 0; i < count; ++i) {
+        ++counts_[static_cast<unsigned_type>(static_cast<mask_type>(rows[i]))];
+      }
+      return;
+    }
+    ::std::uint64_t planes[bits];
+    for (::std::size_t offset = 0; offset < count; offset += 64) {
+      const ::std::size_t rest = ::std::min<::std::size_t>(count - offset, 64);
+      ::deaddev::details::bit_planes(rows + offset, rest, planes);
+      for (::std::size_t first = 0; first < bits; ++first) {
+        if (planes[first] == 0) {
+          continue;
+        }
+        ::std::uint64_t *row = counts_.data() + first * bits;
+        for (::std::size_t second = first; second < bits; ++second) {
+          row[second] += static_cast<::std::uint64_t>(
+              ::deaddev::details::popcount(planes[first] & planes[second]));
+        }
+      }
+    }
+  }
+
+  /// adds counts of another aggregator
+  void merge(const cooccurrence_counts &other) noexcept {
+    for (::std::size_t i = 0; i < counts_.size(); ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    rows_ += other.rows_;
+  }
+
+  /// empty aggregator with the same settings
+  DEADDEV_NODISCARD cooccurrence_counts split() const { return cooccurrence_counts{}; }
+
+  /**
+   * @brief rows with both bits set
+   * @param first bit index
+   * @param second bit index, first == second counts rows with the bit set
+   * @return ::std::uint64_t number of rows
+   */
+  DEADDEV_NODISCARD ::std::uint64_t operator()(::std::size_t first,
+                                               ::std::size_t second) const noexcept {
+    if (dense) {
+      const ::std::size_t pair = (::std::size_t{1} << first) | (::std::size_t{1} << second);
+      ::std::uint64_t result = 0;
+      for (::std::size_t mask = 0; mask < counts_.size(); ++mask) {
+        result += (mask & pair) == pair ? counts_[mask] : 0;
+      }
+      return result;
+    }
+    return first <= second ? counts_[first * bits + second] : counts_[second * bits + first];
+  }
+
+  /// rows with both flags set
+  DEADDEV_NODISCARD ::std::uint64_t count(enum_type first, enum_type second) const noexcept {
+    return (*this)(::deaddev::details::flag_index(first), ::deaddev::details::flag_index(second));
+  }
+
+  /// number of added rows
+  DEADDEV_NODISCARD ::std::uint64_t rows() const noexcept { return rows_; }
+
+private:
+  using mask_type = typename value_type::mask_type;
+  using unsigned_type = ::std::make_unsigned_t<mask_type>;
+
+  /// histogram of masks if dense, upper triangle of a bits x bits matrix otherwise
+  ::std::vector<::std::uint64_t> counts_;
+  ::std::uint64_t rows_ = 0;
+};
+
+/**
+ * @brief Number of rows with each exact mask
+ * @details Masks of up to 16 bits are counted in a dense table. Wider masks go to a hash
+ * map that is sorted and spilled to a temporary file when it holds more than max_distinct
+ * masks; for_each merges the spilled runs
+ * @tparam T enum type
+ */
+template <typename T> class mask_histogram {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// enum type
+  using enum_type = T;
+  /// true if masks are counted in a dense table
+  static constexpr bool dense = ::deaddev::details::mask_bits<T> <= 16;
+
+  /**
+   * @brief empty histogram
+   * @param max_distinct masks kept in memory before spilling
+   */
+  explicit mask_histogram(::std::size_t max_distinct = ::std::size_t{1} << 20)
+      : max_distinct_(max_distinct) {
+    if (dense) {
+      table_.resize(::std::size_t{1} << ::deaddev::details::mask_bits<T>);
+    }
+  }
+
+  /// adds rows
+  void add(const value_type *rows, ::std::size_t count) {
+    for (::std::size_t i = 0; i < count; ++i) {
+      add(key(rows[i]), 1);
+    }
+  }
+
+  /// adds counts of another histogram and takes its spilled runs
+  void merge(mask_histogram &other) {
+    if (dense) {
+      for (::std::size_t i = 0; i < table_.size(); ++i) {
+        table_[i] += other.table_[i];
+      }
+    } else {
+      for (const auto &entry : other.map_) {
+        add(entry.first, entry.second);
+      }
+      other.map_.clear();
+      for (auto &run : other.runs_) {
+        runs_.push_back(::std::move(run));
+      }
+      other.runs_.clear();
+    }
+  }
+
+  /// empty histogram with the same settings
+  DEADDEV_NODISCARD mask_histogram split() const { return mask_histogram{max_distinct_}; }
+
+  /**
+   * @brief Visits masks in ascending order
+   * @param visit `void(bitmask<T>, ::std::uint64_t count)` callable
+   */
+  template <typename F> void for_each(F &&visit) {
+    if (dense) {
+      for (::std::size_t i = 0; i < table_.size(); ++i) {
+        if (table_[i] != 0) {
+          visit(value_type{static_cast<mask_type>(i)}, table_[i]);
+        }
+      }
+      return;
+    }
+    ::std::vector<entry> memory(map_.begin(), map_.end());
+    ::std::sort(memory.begin(), memory.end());
+    // k-way merge of the sorted memory entries and spilled runs
+    ::std::vector<entry> heads(runs_.size() + 1);
+    ::std::vector<bool> live(runs_.size() + 1);
+    ::std::size_t next_memory = 0;
+    const auto advance = [&](::std::size_t source) {
+      if (source == runs_.size()) {
+        live[source] = next_memory < memory.size();
+        if (live[source]) {
+          heads[source] = memory[next_memory++];
+        }
+      } else {
+        live[source] = ::std::fread(&heads[source], sizeof(entry), 1, runs_[source].get()) == 1;
+      }
+    };
+    for (auto &run : runs_) {
+      ::std::rewind(run.get());
+    }
+    for (::std::size_t source = 0; source < heads.size(); ++source) {
+      advance(source);
+    }
+    for (;;) {
+      ::std::size_t best = heads.size();
+      for (::std::size_t source = 0; source < heads.size(); ++source) {
+        if (live[source] && (best == heads.size() || heads[source].first < heads[best].first)) {
+          best = source;
+        }
+      }
+      if (best == heads.size()) {
+        break;
+      }
+      const unsigned_type mask = heads[best].first;
+      ::std::uint64_t total = 0;
+      for (::std::size_t source = 0; source < heads.size(); ++source) {
+        while (live[source] && heads[source].first == mask) {
+          total += heads[source].second;
+          advance(source);
+        }
+      }
+      visit(value_type{static_cast<mask_type>(mask)}, total);
+    }
+  }
+
+  /// number of runs spilled to disk
+  DEADDEV_NODISCARD ::std::size_t spilled_runs() const noexcept { return runs_.size(); }
+
+private:
+  using mask_type = typename value_type::mask_type;
+  using unsigned_type = ::std::make_unsigned_t<mask_type>;
+  using entry = ::std::pair<unsigned_type, ::std::uint64_t>;
+
+  static unsigned_type key(value_type value) noexcept {
+    return static_cast<unsigned_type>(static_cast<mask_type>(value));
+  }
+
+  void add(unsigned_type mask, ::std::uint64_t count) {
+    if (dense) {
+      table_[static_cast<::std::size_t>(mask)] += count;
+      return;
+    }
+    map_[mask] += count;
+    if (map_.size() > max_distinct_) {
+      spill();
+    }
+  }
+
+  /// writes the sorted map to a temporary file, keeps it in memory if that fails
+  void spill() {
+    ::std::unique_ptr<::std::FILE, ::deaddev::details::file_closer> file(::std::tmpfile());
+    if (!file) {
+      return;
+    }
+    ::std::vector<entry> sorted(map_.begin(), map_.end());
+    ::std::sort(sorted.begin(), sorted.end());
+    if (::std::fwrite(sorted.data(), sizeof(entry), sorted.size(), file.get()) != sorted.size() ||
+        ::std::fflush(file.get()) != 0) {
+      return;
+    }
+    runs_.push_back(::std::move(file));
+    map_.clear();
+  }
+
+  ::std::size_t max_distinct_;
+  ::std::vector<::std::uint64_t> table_;
+  ::std::unordered_map<unsigned_type, ::std::uint64_t> map_;
+  ::std::vector<::std::unique_ptr<::std::FILE, ::deaddev::details::file_closer>> runs_;
+};
+
+/// settings of aggregate_file
+struct aggregate_options {
+  /// rows per chunk, two chunks are in memory
+  ::std::size_t chunk_rows = ::std::size_t{1} << 20;
+  /// number of threads, 0 for hardware concurrency
+  unsigned threads = 0;
+  /// bytes to skip at the start of the file
+  long offset = 0;
+};
+
+/// outcome of aggregate_file
+struct aggregate_result {
+  /// number of aggregated rows
+  ::std::uint64_t rows = 0;
+  /// false if the file could not be opened or read, or ends with a partial row
+  bool ok = false;
+};
+
+namespace details {
+
+template <typename Tuple, typename F, ::std::size_t... I>
+void for_each_element(Tuple &tuple, F &&function, ::std::index_sequence<I...>) {
+  const int expand[] = {0, (function(::std::get<I>(tuple)), 0)...};
+  static_cast<void>(expand);
+}
+
+template <typename Targets, typename Locals, ::std::size_t... I>
+void merge_elements(Targets &targets, Locals &locals, ::std::index_sequence<I...>) {
+  const int expand[] = {0, (::std::get<I>(targets).merge(::std::get<I>(locals)), 0)...};
+  static_cast<void>(expand);
+}
+
+/**
+ * @brief Runs aggregators over chunks from source on a thread pool
+ * @details `source(const value_type *&data)` returns the rows of the next chunk, 0 at the
+ * end. It is called for the next chunk while the workers aggregate the current one, so a
+ * source that reads into two alternating buffers overlaps I/O with aggregation
+ */
+template <typename T, typename Source, typename... Aggregators>
+auto aggregate_chunks(Source &&source, unsigned threads, Aggregators &...results)
+    -> ::std::uint64_t {
+  using value_type = ::deaddev::bitmask<T>;
+  using locals_type = ::std::tuple<Aggregators...>;
+  using indices = ::std::index_sequence_for<Aggregators...>;
+  if (threads == 0) {
+    threads = ::std::max(1u, ::std::thread::hardware_concurrency());
+  }
+  ::std::vector<locals_type> locals;
+  locals.reserve(threads);
+  for (unsigned i = 0; i < threads; ++i) {
+    locals.emplace_back(results.split()...);
+  }
+
+  ::std::mutex lock;
+  ::std::condition_variable work_ready;
+  ::std::condition_variable work_done;
+  const value_type *chunk = nullptr;
+  ::std::size_t chunk_size = 0;
+  ::std::uint64_t generation = 0;
+  unsigned finished = 0;
+  bool stop = false;
+
+  const auto work = [&](unsigned index, const value_type *data, ::std::size_t count) {
+    const ::std::size_t first = count * index / threads;
+    const ::std::size_t last = count * (index + 1) / threads;
+    for_each_element(
+        locals[index], [&](auto &aggregator) { aggregator.add(data + first, last - first); },
+        indices{});
+  };
+
+  ::std::uint64_t rows = 0;
+  {
+    // stops and joins the workers on every exit, also when source or add throws
+    struct pool_guard {
+      ::std::vector<::std::thread> threads;
+      ::std::mutex &lock;
+      ::std::condition_variable &work_ready;
+      bool &stop;
+
+      ~pool_guard() {
+        {
+          ::std::lock_guard<::std::mutex> guard(lock);
+          stop = true;
+        }
+        work_ready.notify_all();
+        for (auto &thread : threads) {
+          thread.join();
+        }
+      }
+    } workers{{}, lock, work_ready, stop};
+    auto &pool = workers.threads;
+    pool.reserve(threads - 1);
+    for (unsigned index = 1; index < threads; ++index) {
+      pool.emplace_back([&, index] {
+        ::std::uint64_t seen = 0;
+        for (;;) {
+          const value_type *data;
+          ::std::size_t count;
+          {
+            ::std::unique_lock<::std::mutex> guard(lock);
+            work_ready.wait(guard, [&] { return stop || generation != seen; });
+            if (stop) {
+              return;
+            }
+            seen = generation;
+            data = chunk;
+            count = chunk_size;
+          }
+          work(index, data, count);
+          {
+            ::std::lock_guard<::std::mutex> guard(lock);
+            ++finished;
+          }
+          work_done.notify_one();
+        }
+      });
+    }
+
+    const value_type *data = nullptr;
+    ::std::size_t count = source(data);
+    while (count != 0) {
+      {
+        ::std::lock_guard<::std::mutex> guard(lock);
+        chunk = data;
+        chunk_size = count;
+        finished = 0;
+        ++generation;
+      }
+      work_ready.notify_all();
+      const value_type *next = nullptr;
+      const ::std::size_t next_count = source(next);
+      work(0, data, count);
+      {
+        ::std::unique_lock<::std::mutex> guard(lock);
+        work_done.wait(guard, [&] { return finished == threads - 1; });
+      }
+      rows += count;
+      data = next;
+      count = next_count;
+    }
+  }
+
+  ::std::tuple<Aggregators &...> targets(results...);
+  for (auto &local : locals) {
+    merge_elements(targets, local, indices{});
+  }
+  return rows;
+}
+
+} // namespace details
+
+/**
+ * @brief Aggregates an array on all cores
+ * @param rows first row
+ * @param count number of rows
+ * @param threads number of threads, 0 for hardware concurrency
+ * @param first aggregator, receives the result
+ * @param rest more aggregators over the same rows
+ */
+template <typename Aggregator, typename... Aggregators>
+void aggregate(const typename Aggregator::value_type *rows, ::std::size_t count,
+               unsigned threads, Aggregator &first, Aggregators &...rest) {
+  bool done = false;
+  ::deaddev::details::aggregate_chunks<typename Aggregator::enum_type>(
+      [&](const typename Aggregator::value_type *&data) -> ::std::size_t {
+        data = rows;
+        const ::std::size_t result = done ? 0 : count;
+        done = true;
+        return result;
+      },
+      threads, first, rest...);
+}
+
+/**
+ * @brief Aggregates an array on a worker pool
+ * @details Worker i builds its partial aggregators and aggregates the i-th contiguous slice,
+ * so on a pinned_worker_pool both stay local to the worker's CPU and NUMA node
+ * @tparam Pool class with `size()` and `run(function)` calling `function(index)` once on
+ * every worker and returning when all finished
+ * @param pool workers
+ * @param rows first row
+ * @param count number of rows
+ * @param first aggregator, receives the result
+ * @param rest more aggregators over the same rows
+ */
+template <typename Pool, typename Aggregator, typename... Aggregators>
+void aggregate_on(Pool &pool, const typename Aggregator::value_type *rows, ::std::size_t count,
+                  Aggregator &first, Aggregators &...rest) {
+  using locals_type = ::std::tuple<Aggregator, Aggregators...>;
+  using indices = ::std::index_sequence_for<Aggregator, Aggregators...>;
+  const ::std::size_t workers = pool.size();
+  ::std::vector<::std::unique_ptr<locals_type>> locals(workers);
+  pool.run([&](::std::size_t index) {
+    locals[index].reset(new locals_type(first.split(), rest.split()...));
+    const ::std::size_t begin = count * index / workers;
+    const ::std::size_t end = count * (index + 1) / workers;
+    ::deaddev::details::for_each_element(
+        *locals[index], [&](auto &aggregator) { aggregator.add(rows + begin, end - begin); },
+        indices{});
+  });
+  ::std::tuple<Aggregator &, Aggregators &...> targets(first, rest...);
+  for (auto &local : locals) {
+    ::deaddev::details::merge_elements(targets, *local, indices{});
+  }
+}
+
+/**
+ * @brief Aggregates a file of masks in native byte order
+ * @details Reads chunk_rows rows at a time into one of two buffers while the threads
+ * aggregate the other, memory use is bounded by the two chunks and the aggregators
+ * @param path file path
+ * @param options chunk size, threads and header size
+ * @param first aggregator, receives the result
+ * @param rest more aggregators over the same rows
+ * @return aggregate_result rows read and whether the whole file was read
+ */
+template <typename Aggregator, typename... Aggregators>
+auto aggregate_file(const char *path, const aggregate_options &options, Aggregator &first,
+                    Aggregators &...rest) -> aggregate_result {
+  using value_type = typename Aggregator::value_type;
+  aggregate_result result;
+  ::std::unique_ptr<::std::FILE, ::deaddev::details::file_closer> file(::std::fopen(path, "rb"));
+  if (!file || ::std::fseek(file.get(), options.offset, SEEK_SET) != 0) {
+    return result;
+  }
+  const ::std::size_t chunk_rows = ::std::max<::std::size_t>(options.chunk_rows, 1);
+  ::std::vector<value_type> buffers[2] = {::std::vector<value_type>(chunk_rows),
+                                          ::std::vector<value_type>(chunk_rows)};
+  ::std::size_t current = 0;
+  bool ok = true;
+  result.rows = ::deaddev::details::aggregate_chunks<typename Aggregator::enum_type>(
+      [&](const value_type *&data) -> ::std::size_t {
+        if (!ok) {
+          return 0;
+        }
+        current ^= 1;
+        auto *bytes = reinterpret_cast<unsigned char *>(buffers[current].data());
+        const ::std::size_t read = ::std::fread(bytes, 1, chunk_rows * sizeof(value_type), file.get());
+        if (read % sizeof(value_type) != 0 || (read == 0 && ::std::ferror(file.get()))) {
+          ok = false;
+        }
+        data = buffers[current].data();
+        return read / sizeof(value_type);
+      },
+      options.threads, first, rest...);
+  result.ok = ok && !::std::ferror(file.get());
+  return result;
+}
+
+} // namespace deaddev
+
+#endif // DEADDEV_BITMASK_AGGREGATE_HPP
@@ -0,0 +1,883 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Bulk algorithms over arrays of deaddev::bitmask
+ * @details Rows are processed 64 at a time into match words (bit i of a word is the
+ * predicate result for row i). The inner loops are branch-free so the compiler
+ * vectorizes them for the predicates below
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_BITMASK_ALGORITHM_HPP
+#define DEADDEV_BITMASK_ALGORITHM_HPP
+#pragma once
+#include <deaddev/bit.hpp>
+#include <deaddev/bitmask.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace deaddev {
+
+/**
+ * @brief rows per match word
+ */
+constexpr ::std::size_t match_word_rows = 64;
+
+/**
+ * @brief predicate: all flags are set
+ * @tparam T enum type
+ */
+template <typename T> struct all_of_predicate {
+  /// required flags
+  ::deaddev::bitmask<T> flags;
+  /// predicate
+  DEADDEV_NODISCARD constexpr bool operator()(::deaddev::bitmask<T> row) const noexcept {
+    return row.is_set(flags);
+  }
+};
+
+/**
+ * @brief predicate: at least one flag is set
+ * @tparam T enum type
+ */
+template <typename T> struct any_of_predicate {
+  /// flags
+  ::deaddev::bitmask<T> flags;
+  /// predicate
+  DEADDEV_NODISCARD constexpr bool operator()(::deaddev::bitmask<T> row) const noexcept {
+    return (row & flags) != 0;
+  }
+};
+
+/**
+ * @brief predicate: no flag is set
+ * @tparam T enum type
+ */
+template <typename T> struct none_of_predicate {
+  /// excluded flags
+  ::deaddev::bitmask<T> flags;
+  /// predicate
+  DEADDEV_NODISCARD constexpr bool operator()(::deaddev::bitmask<T> row) const noexcept {
+    return (row & flags) == 0;
+  }
+};
+
+/**
+ * @brief predicate: all required flags are set and no excluded flag is set
+ * @tparam T enum type
+ */
+template <typename T> struct query_predicate {
+  /// required flags
+  ::deaddev::bitmask<T> required;
+  /// excluded flags
+  ::deaddev::bitmask<T> excluded;
+  /// predicate
+  DEADDEV_NODISCARD constexpr bool operator()(::deaddev::bitmask<T> row) const noexcept {
+    return (row & (required | excluded)) == required;
+  }
+};
+
+/**
+ * @brief makes all_of_predicate
+ * @tparam T enum type
+ * @param flags required flags
+ * @return all_of_predicate<T> predicate
+ */
+template <typename T>
+DEADDEV_NODISCARD constexpr auto has_all(::deaddev::bitmask<T> flags) noexcept
+    -> all_of_predicate<T> {
+  return {flags};
+}
+
+/**
+ * @brief makes all_of_predicate
+ * @tparam T enum type
+ * @param flag required flag
+ * @return all_of_predicate<T> predicate
+ */
+template <typename T, typename = ::deaddev::details::enable_if_bitmask_t<T>>
+DEADDEV_NODISCARD constexpr auto has_all(T flag) noexcept -> all_of_predicate<T> {
+  return {flag};
+}
+
+/**
+ * @brief makes any_of_predicate
+ * @tparam T enum type
+ * @param flags flags
+ * @return any_of_predicate<T> predicate
+ */
+template <typename T>
+DEADDEV_NODISCARD constexpr auto has_any(::deaddev::bitmask<T> flags) noexcept
+    -> any_of_predicate<T> {
+  return {flags};
+}
+
+/**
+ * @brief makes any_of_predicate
+ * @tparam T enum type
+ * @param flag flag
+ * @return any_of_predicate<T> predicate
+ */
+template <typename T, typename = ::deaddev::details::enable_if_bitmask_t<T>>
+DEADDEV_NODISCARD constexpr auto has_any(T flag) noexcept -> any_of_predicate<T> {
+  return {flag};
+}
+
+/**
+ * @brief makes none_of_predicate
+ * @tparam T enum type
+ * @param flags excluded flags
+ * @return none_of_predicate<T> predicate
+ */
+template <typename T>
+DEADDEV_NODISCARD constexpr auto has_none(::deaddev::bitmask<T> flags) noexcept
+    -> none_of_predicate<T> {
+  return {flags};
+}
+
+/**
+ * @brief makes none_of_predicate
+ * @tparam T enum type
+ * @param flag excluded flag
+ * @return none_of_predicate<T> predicate
+ */
+template <typename T, typename = ::deaddev::details::enable_if_bitmask_t<T>>
+DEADDEV_NODISCARD constexpr auto has_none(T flag) noexcept -> none_of_predicate<T> {
+  return {flag};
+}
+
+/**
+ * @brief makes query_predicate
+ * @tparam T enum type
+ * @param required required flags
+ * @param excluded excluded flags
+ * @return query_predicate<T> predicate
+ */
+template <typename T>
+DEADDEV_NODISCARD constexpr auto query(::deaddev::bitmask<T> required,
+                                       ::deaddev::bitmask<T> excluded) noexcept
+    -> query_predicate<T> {
+  return {required, excluded};
+}
+
+/**
+ * @brief Evaluates predicate for up to 64 rows
+ * @tparam T enum type
+ * @tparam Predicate `bool(bitmask<T>)` callable
+ * @param rows first row
+ * @param count number of rows, at most match_word_rows
+ * @param predicate predicate
+ * @return ::std::uint64_t bit i is the result for rows[i]
+ */
+template <typename T, typename Predicate>
+DEADDEV_NODISCARD auto match_word(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                                  const Predicate &predicate) noexcept -> ::std::uint64_t {
+  ::std::uint64_t word = 0;
+  if (count == match_word_rows) {
+    // constant trip count, unrolled and vectorized
+    for (::std::size_t i = 0; i < match_word_rows; ++i) {
+      word |= static_cast<::std::uint64_t>(predicate(rows[i])) << i;
+    }
+  } else {
+    for (::std::size_t i = 0; i < count; ++i) {
+      word |= static_cast<::std::uint64_t>(predicate(rows[i])) << i;
+    }
+  }
+  return word;
+}
+
+/**
+ * @brief Evaluates predicate for all rows
+ * @tparam T enum type
+ * @tparam Predicate `bool(bitmask<T>)` callable
+ * @param rows first row
+ * @param count number of rows
+ * @param predicate predicate
+ * @param words output, (count + 63) / 64 match words
+ */
+template <typename T, typename Predicate>
+void match_words(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                 const Predicate &predicate, ::std::uint64_t *words) noexcept {
+  for (::std::size_t offset = 0; offset < count; offset += match_word_rows) {
+    const ::std::size_t rest = count - offset;
+    *words++ = ::deaddev::match_word(
+        rows + offset, rest < match_word_rows ? rest : match_word_rows, predicate);
+  }
+}
+
+/**
+ * @brief Counts rows matching predicate
+ * @tparam T enum type
+ * @tparam Predicate `bool(bitmask<T>)` callable
+ * @param rows first row
+ * @param count number of rows
+ * @param predicate predicate
+ * @return ::std::size_t number of matching rows
+ */
+template <typename T, typename Predicate>
+DEADDEV_NODISCARD auto count_if(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                                const Predicate &predicate) noexcept -> ::std::size_t {
+  ::std::size_t result = 0;
+  for (::std::size_t offset = 0; offset < count; offset += match_word_rows) {
+    const ::std::size_t rest = count - offset;
+    result += static_cast<::std::size_t>(::deaddev::details::popcount(::deaddev::match_word(
+        rows + offset, rest < match_word_rows ? rest : match_word_rows, predicate)));
+  }
+  return result;
+}
+
+/**
+ * @brief scan operation: running OR, the flags seen so far
+ */
+struct scan_or_t {
+  /// identity, no flags
+  template <typename T>
+  DEADDEV_NODISCARD static constexpr auto identity() noexcept -> ::deaddev::bitmask<T> {
+    return {};
+  }
+  /// combines two masks
+  template <typename M> DEADDEV_NODISCARD static constexpr M apply(M left, M right) noexcept {
+    return static_cast<M>(left | right);
+  }
+};
+
+/**
+ * @brief scan operation: running AND, the flags held in every row so far
+ */
+struct scan_and_t {
+  /// identity, all flags
+  template <typename T>
+  DEADDEV_NODISCARD static constexpr auto identity() noexcept -> ::deaddev::bitmask<T> {
+    return ::deaddev::bitmask<T>::all_flags();
+  }
+  /// combines two masks
+  template <typename M> DEADDEV_NODISCARD static constexpr M apply(M left, M right) noexcept {
+    return static_cast<M>(left & right);
+  }
+};
+
+/// running OR
+constexpr scan_or_t scan_or{};
+/// running AND
+constexpr scan_and_t scan_and{};
+
+namespace details {
+
+/// row i is lane i of a scan word only on little endian targets
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool scan_words_supported = false;
+#else
+constexpr bool scan_words_supported = true;
+#endif
+
+/// masks per 64 bit scan word
+template <typename T>
+constexpr ::std::size_t scan_lanes = 8 / sizeof(typename ::deaddev::bitmask<T>::mask_type);
+
+/// unsigned lane of a scan word, masks are widened through it so signed masks do not
+/// sign extend into the neighbouring lanes
+template <typename T>
+using scan_lane_type = ::std::make_unsigned_t<typename ::deaddev::bitmask<T>::mask_type>;
+
+/// value repeated in every lane of a scan word
+template <typename T>
+constexpr auto scan_broadcast(scan_lane_type<T> value) noexcept -> ::std::uint64_t {
+  return static_cast<::std::uint64_t>(value) *
+         (~::std::uint64_t{0} / static_cast<::std::uint64_t>(static_cast<scan_lane_type<T>>(
+                                    ~scan_lane_type<T>{0})));
+}
+
+/**
+ * @brief Scans rows in 64 bit words, log2(lanes) shift-and-combine steps per word
+ * @details The words scan independently, only the last lane of each is chained to the
+ * next word, so the dependency chain is one operation per word instead of one per row
+ */
+template <typename T, typename Operation, bool Inclusive>
+auto scan_words(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                ::deaddev::bitmask<T> *out, typename ::deaddev::bitmask<T>::mask_type carry,
+                ::std::true_type) noexcept ->
+    typename ::deaddev::bitmask<T>::mask_type {
+  using mask_type = typename ::deaddev::bitmask<T>::mask_type;
+  using lane_type = scan_lane_type<T>;
+  constexpr ::std::size_t lanes = scan_lanes<T>;
+  constexpr ::std::size_t lane_bits = sizeof(mask_type) * CHAR_BIT;
+  constexpr ::std::size_t top = 64 - lane_bits;
+  const ::std::uint64_t identity = scan_broadcast<T>(
+      static_cast<lane_type>(static_cast<mask_type>(Operation::template identity<T>())));
+  auto lane_carry = static_cast<lane_type>(carry);
+  ::std::size_t i = 0;
+  for (; i + lanes <= count; i += lanes) {
+    ::std::uint64_t word;
+    ::std::memcpy(&word, rows + i, sizeof(word));
+    // constant conditions, the steps stay unrolled at -O2
+    if (lane_bits <= 8) {
+      word = Operation::apply(word, (word << 8) | (identity >> 56));
+    }
+    if (lane_bits <= 16) {
+      word = Operation::apply(word, (word << 16) | (identity >> 48));
+    }
+    word = Operation::apply(word, (word << 32) | (identity >> 32));
+    const ::std::uint64_t scanned = Operation::apply(word, scan_broadcast<T>(lane_carry));
+    const ::std::uint64_t result =
+        Inclusive ? scanned : (scanned << lane_bits) | static_cast<::std::uint64_t>(lane_carry);
+    ::std::memcpy(static_cast<void *>(out + i), &result, sizeof(result));
+    lane_carry = Operation::apply(lane_carry, static_cast<lane_type>(word >> top));
+  }
+  carry = static_cast<mask_type>(lane_carry);
+  for (; i < count; ++i) {
+    const auto next = Operation::apply(carry, static_cast<mask_type>(rows[i]));
+    out[i] = ::deaddev::bitmask<T>(Inclusive ? next : carry);
+    carry = next;
+  }
+  return carry;
+}
+
+/// 64 bit masks or big endian, plain running value
+template <typename T, typename Operation, bool Inclusive>
+auto scan_words(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                ::deaddev::bitmask<T> *out, typename ::deaddev::bitmask<T>::mask_type carry,
+                ::std::false_type) noexcept ->
+    typename ::deaddev::bitmask<T>::mask_type {
+  using mask_type = typename ::deaddev::bitmask<T>::mask_type;
+  for (::std::size_t i = 0; i < count; ++i) {
+    const auto next = Operation::apply(carry, static_cast<mask_type>(rows[i]));
+    out[i] = ::deaddev::bitmask<T>(Inclusive ? next : carry);
+    carry = next;
+  }
+  return carry;
+}
+
+template <typename T, typename Operation, bool Inclusive>
+auto scan(const ::deaddev::bitmask<T> *rows, ::std::size_t count, ::deaddev::bitmask<T> *out,
+          ::deaddev::bitmask<T> carry) noexcept -> ::deaddev::bitmask<T> {
+  using mask_type = typename ::deaddev::bitmask<T>::mask_type;
+  static_assert(sizeof(::deaddev::bitmask<T>) == sizeof(mask_type), "masks are packed");
+  return ::deaddev::bitmask<T>(scan_words<T, Operation, Inclusive>(
+      rows, count, out, static_cast<mask_type>(carry),
+      ::std::integral_constant<bool, scan_words_supported && (scan_lanes<T> > 1)>{}));
+}
+
+template <typename T, typename Operation>
+auto reduce(const ::deaddev::bitmask<T> *rows, ::std::size_t count) noexcept
+    -> ::deaddev::bitmask<T> {
+  using mask_type = typename ::deaddev::bitmask<T>::mask_type;
+  auto value = static_cast<mask_type>(Operation::template identity<T>());
+  for (::std::size_t i = 0; i < count; ++i) {
+    value = Operation::apply(value, static_cast<mask_type>(rows[i]));
+  }
+  return ::deaddev::bitmask<T>(value);
+}
+
+template <typename T, typename Operation, bool Inclusive>
+void segmented_scan(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                    const ::std::uint64_t *starts, ::deaddev::bitmask<T> *out) noexcept {
+  const auto identity = Operation::template identity<T>();
+  ::std::size_t first = 0;
+  while (first < count) {
+    // next segment start after first, skipping whole words without starts
+    ::std::size_t last = first + 1;
+    while (last < count) {
+      const ::std::uint64_t word = starts[last / match_word_rows] >> (last % match_word_rows);
+      if (word != 0) {
+        last += static_cast<::std::size_t>(::deaddev::details::countr_zero(word));
+        break;
+      }
+      last += match_word_rows - last % match_word_rows;
+    }
+    last = last < count ? last : count;
+    scan<T, Operation, Inclusive>(rows + first, last - first, out + first, identity);
+    first = last;
+  }
+}
+
+template <typename T, typename Operation, bool Inclusive, typename Pool>
+auto scan_on(Pool &pool, const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+             ::deaddev::bitmask<T> *out) -> ::deaddev::bitmask<T> {
+  const ::std::size_t workers = pool.size();
+  const auto identity = Operation::template identity<T>();
+  ::std::vector<::deaddev::bitmask<T>> carries(workers + 1, identity);
+  // pass 1: every worker reduces its slice
+  pool.run([&](::std::size_t index) {
+    const ::std::size_t first = count * index / workers;
+    const ::std::size_t last = count * (index + 1) / workers;
+    carries[index + 1] = reduce<T, Operation>(rows + first, last - first);
+  });
+  using mask_type = typename ::deaddev::bitmask<T>::mask_type;
+  for (::std::size_t index = 1; index <= workers; ++index) {
+    carries[index] = ::deaddev::bitmask<T>(Operation::apply(
+        static_cast<mask_type>(carries[index - 1]), static_cast<mask_type>(carries[index])));
+  }
+  // pass 2: every worker scans its slice from the combined carry of the slices before it
+  pool.run([&](::std::size_t index) {
+    const ::std::size_t first = count * index / workers;
+    const ::std::size_t last = count * (index + 1) / workers;
+    scan<T, Operation, Inclusive>(rows + first, last - first, out + first, carries[index]);
+  });
+  return carries[workers];
+}
+
+} // namespace details
+
+/**
+ * @brief Inclusive scan, out[i] combines carry and rows[0..i]
+ * @details For chunked streams pass the result of the previous chunk as carry
+ * @tparam T enum type
+ * @tparam Operation scan_or_t or scan_and_t
+ * @param rows first row
+ * @param count number of rows
+ * @param out output, count rows, may be rows
+ * @param carry combined value of the rows before rows[0]
+ * @return bitmask<T> combined value of carry and all rows
+ */
+template <typename T, typename Operation>
+auto inclusive_scan(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                    ::deaddev::bitmask<T> *out, Operation,
+                    ::deaddev::bitmask<T> carry) noexcept -> ::deaddev::bitmask<T> {
+  return ::deaddev::details::scan<T, Operation, true>(rows, count, out, carry);
+}
+
+/**
+ * @brief Inclusive scan, out[i] combines rows[0..i]
+ * @tparam T enum type
+ * @tparam Operation scan_or_t or scan_and_t
+ * @param rows first row
+ * @param count number of rows
+ * @param out output, count rows, may be rows
+ * @return bitmask<T> combined value of all rows
+ */
+template <typename T, typename Operation>
+auto inclusive_scan(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                    ::deaddev::bitmask<T> *out, Operation operation) noexcept
+    -> ::deaddev::bitmask<T> {
+  return ::deaddev::inclusive_scan(rows, count, out, operation,
+                                   Operation::template identity<T>());
+}
+
+/**
+ * @brief Exclusive scan, out[i] combines carry and rows[0..i)
+ * @details For chunked streams pass the result of the previous chunk as carry
+ * @tparam T enum type
+ * @tparam Operation scan_or_t or scan_and_t
+ * @param rows first row
+ * @param count number of rows
+ * @param out output, count rows, may be rows
+ * @param carry combined value of the rows before rows[0]
+ * @return bitmask<T> combined value of carry and all rows
+ */
+template <typename T, typename Operation>
+auto exclusive_scan(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                    ::deaddev::bitmask<T> *out, Operation,
+                    ::deaddev::bitmask<T> carry) noexcept -> ::deaddev::bitmask<T> {
+  return ::deaddev::details::scan<T, Operation, false>(rows, count, out, carry);
+}
+
+/**
+ * @brief Exclusive scan, out[i] combines rows[0..i), out[0] is the identity
+ * @tparam T enum type
+ * @tparam Operation scan_or_t or scan_and_t
+ * @param rows first row
+ * @param count number of rows
+ * @param out output, count rows, may be rows
+ * @return bitmask<T> combined value of all rows
+ */
+template <typename T, typename Operation>
+auto exclusive_scan(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                    ::deaddev::bitmask<T> *out, Operation operation) noexcept
+    -> ::deaddev::bitmask<T> {
+  return ::deaddev::exclusive_scan(rows, count, out, operation,
+                                   Operation::template identity<T>());
+}
+
+/**
+ * @brief Inclusive scan that restarts at every segment start
+ * @tparam T enum type
+ * @tparam Operation scan_or_t or scan_and_t
+ * @param rows first row
+ * @param count number of rows
+ * @param starts match words, bit i set if row i starts a segment, e.g. from match_words
+ * @param out output, count rows, may be rows
+ */
+template <typename T, typename Operation>
+void segmented_inclusive_scan(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                              const ::std::uint64_t *starts, ::deaddev::bitmask<T> *out,
+                              Operation) noexcept {
+  ::deaddev::details::segmented_scan<T, Operation, true>(rows, count, starts, out);
+}
+
+/**
+ * @brief Exclusive scan that restarts at every segment start
+ * @tparam T enum type
+ * @tparam Operation scan_or_t or scan_and_t
+ * @param rows first row
+ * @param count number of rows
+ * @param starts match words, bit i set if row i starts a segment, e.g. from match_words
+ * @param out output, count rows, may be rows, segment starts get the identity
+ */
+template <typename T, typename Operation>
+void segmented_exclusive_scan(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                              const ::std::uint64_t *starts, ::deaddev::bitmask<T> *out,
+                              Operation) noexcept {
+  ::deaddev::details::segmented_scan<T, Operation, false>(rows, count, starts, out);
+}
+
+/**
+ * @brief Inclusive scan on a worker pool
+ * @details Two passes: the workers reduce their slices, the slice totals are combined,
+ * then every worker scans its slice starting from the total of the slices before it
+ * @tparam Pool class with `size()` and `run(function)` calling `function(index)` once on
+ * every worker, e.g. deaddev::pinned_worker_pool
+ * @param out output, count rows, may be rows
+ * @return bitmask<T> combined value of all rows
+ */
+template <typename Pool, typename T, typename Operation>
+auto inclusive_scan_on(Pool &pool, const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                       ::deaddev::bitmask<T> *out, Operation) -> ::deaddev::bitmask<T> {
+  return ::deaddev::details::scan_on<T, Operation, true>(pool, rows, count, out);
+}
+
+/**
+ * @brief Exclusive scan on a worker pool
+ * @details Same passes as inclusive_scan_on
+ * @tparam Pool class with `size()` and `run(function)` calling `function(index)` once on
+ * every worker, e.g. deaddev::pinned_worker_pool
+ * @param out output, count rows, may be rows
+ * @return bitmask<T> combined value of all rows
+ */
+template <typename Pool, typename T, typename Operation>
+auto exclusive_scan_on(Pool &pool, const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                       ::deaddev::bitmask<T> *out, Operation) -> ::deaddev::bitmask<T> {
+  return ::deaddev::details::scan_on<T, Operation, false>(pool, rows, count, out);
+}
+
+namespace details {
+
+/**
+ * @brief Calls visit(index, previous, current) for every row that differs from the row before
+ * @details Compares whole scan words of rows with the same words shifted by one row, so
+ * stable stretches cost one XOR per word
+ */
+template <typename T, typename F>
+auto for_each_change(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                     typename ::deaddev::bitmask<T>::mask_type previous, F &&visit,
+                     ::std::true_type) -> typename ::deaddev::bitmask<T>::mask_type {
+  using mask_type = typename ::deaddev::bitmask<T>::mask_type;
+  using lane_type = scan_lane_type<T>;
+  constexpr ::std::size_t lanes = scan_lanes<T>;
+  constexpr ::std::size_t lane_bits = sizeof(mask_type) * CHAR_BIT;
+  constexpr ::std::size_t top = 64 - lane_bits;
+  constexpr auto lane_mask = static_cast<::std::uint64_t>(static_cast<lane_type>(~lane_type{0}));
+  ::std::size_t i = 0;
+  for (; i + lanes <= count; i += lanes) {
+    ::std::uint64_t word;
+    ::std::memcpy(&word, rows + i, sizeof(word));
+    const ::std::uint64_t shifted =
+        (word << lane_bits) | static_cast<::std::uint64_t>(static_cast<lane_type>(previous));
+    ::std::uint64_t changed = word ^ shifted;
+    while (changed != 0) {
+      const ::std::size_t shift =
+          static_cast<::std::size_t>(::deaddev::details::countr_zero(changed)) / lane_bits *
+          lane_bits;
+      visit(i + shift / lane_bits, static_cast<mask_type>(shifted >> shift),
+            static_cast<mask_type>(word >> shift));
+      changed &= ~(lane_mask << shift);
+    }
+    previous = static_cast<mask_type>(word >> top);
+  }
+  for (; i < count; ++i) {
+    const auto current = static_cast<mask_type>(rows[i]);
+    if (current != previous) {
+      visit(i, previous, current);
+    }
+    previous = current;
+  }
+  return previous;
+}
+
+/// 64 bit masks or big endian, one row at a time
+template <typename T, typename F>
+auto for_each_change(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                     typename ::deaddev::bitmask<T>::mask_type previous, F &&visit,
+                     ::std::false_type) -> typename ::deaddev::bitmask<T>::mask_type {
+  using mask_type = typename ::deaddev::bitmask<T>::mask_type;
+  for (::std::size_t i = 0; i < count; ++i) {
+    const auto current = static_cast<mask_type>(rows[i]);
+    if (current != previous) {
+      visit(i, previous, current);
+    }
+    previous = current;
+  }
+  return previous;
+}
+
+} // namespace details
+
+/**
+ * @brief Visits the rows where flags turn on or off
+ * @details For chunked streams pass the result of the previous chunk as previous
+ * @tparam T enum type
+ * @tparam F `void(::std::size_t index, bitmask<T> rises, bitmask<T> falls)` callable
+ * @param rows first row
+ * @param count number of rows
+ * @param previous row before rows[0], flags set in rows[0] but not in previous rise
+ * @param visit called for every row that differs from the row before, in order
+ * @return bitmask<T> last row, or previous if count is 0
+ */
+template <typename T, typename F>
+auto for_each_edge(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                   ::deaddev::bitmask<T> previous, F &&visit) -> ::deaddev::bitmask<T> {
+  using mask_type = typename ::deaddev::bitmask<T>::mask_type;
+  return ::deaddev::bitmask<T>(::deaddev::details::for_each_change(
+      rows, count, static_cast<mask_type>(previous),
+      [&](::std::size_t index, mask_type before, mask_type current) {
+        const auto changed = static_cast<mask_type>(before ^ current);
+        visit(index, ::deaddev::bitmask<T>(static_cast<mask_type>(changed & current)),
+              ::deaddev::bitmask<T>(static_cast<mask_type>(changed & before)));
+      },
+      ::std::integral_constant<bool, ::deaddev::details::scan_words_supported &&
+                                         (::deaddev::details::scan_lanes<T> > 1)>{}));
+}
+
+/**
+ * @brief Edge bit planes, bit i of a word is set if a flag rose or fell at row i
+ * @tparam T enum type
+ * @param rows first row
+ * @param count number of rows
+ * @param previous row before rows[0]
+ * @param flags flags to watch, a row is marked if any of them changes
+ * @param rises output, (count + 63) / 64 match words
+ * @param falls output, (count + 63) / 64 match words
+ * @return bitmask<T> last row, or previous if count is 0
+ */
+template <typename T>
+auto edge_words(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                ::deaddev::bitmask<T> previous, ::deaddev::bitmask<T> flags,
+                ::std::uint64_t *rises, ::std::uint64_t *falls) -> ::deaddev::bitmask<T> {
+  const ::std::size_t words = (count + match_word_rows - 1) / match_word_rows;
+  for (::std::size_t i = 0; i < words; ++i) {
+    rises[i] = 0;
+    falls[i] = 0;
+  }
+  return ::deaddev::for_each_edge(
+      rows, count, previous,
+      [&](::std::size_t index, ::deaddev::bitmask<T> rise, ::deaddev::bitmask<T> fall) {
+        const ::std::uint64_t bit = ::std::uint64_t{1} << (index % match_word_rows);
+        rises[index / match_word_rows] |= (rise & flags) != 0 ? bit : 0;
+        falls[index / match_word_rows] |= (fall & flags) != 0 ? bit : 0;
+      });
+}
+
+/**
+ * @brief Per flag lists of the rows where the flag turns on or off
+ * @details Rows are numbered across all add calls, so a stream can be added in chunks
+ * @tparam T enum type
+ */
+template <typename T> class flag_edges {
+public:
+  using value_type = ::deaddev::bitmask<T>;
+  using mask_type = typename value_type::mask_type;
+  /// number of bits in a mask
+  static constexpr ::std::size_t bits = sizeof(mask_type) * CHAR_BIT;
+
+  /**
+   * @brief constructor
+   * @param initial row before the first added row
+   */
+  explicit flag_edges(value_type initial = value_type{}) noexcept : previous_(initial) {}
+
+  /// adds the next rows of the stream
+  void add(const value_type *rows, ::std::size_t count) {
+    previous_ = ::deaddev::for_each_edge(
+        rows, count, previous_,
+        [&](::std::size_t index, value_type rise, value_type fall) {
+          const ::std::uint64_t row = rows_ + index;
+          for (::std::uint64_t set = static_cast<lane_type>(static_cast<mask_type>(rise)); set != 0;
+               set &= set - 1) {
+            rises_[::deaddev::details::countr_zero(set)].push_back(row);
+          }
+          for (::std::uint64_t set = static_cast<lane_type>(static_cast<mask_type>(fall)); set != 0;
+               set &= set - 1) {
+            falls_[::deaddev::details::countr_zero(set)].push_back(row);
+          }
+        });
+    rows_ += count;
+  }
+
+  /// rows where bit turned on, ascending
+  DEADDEV_NODISCARD const ::std::vector<::std::uint64_t> &rises(::std::size_t bit) const noexcept {
+    return rises_[bit];
+  }
+  /// rows where bit turned off, ascending
+  DEADDEV_NODISCARD const ::std::vector<::std::uint64_t> &falls(::std::size_t bit) const noexcept {
+    return falls_[bit];
+  }
+  /// rows where flag turned on, ascending
+  DEADDEV_NODISCARD const ::std::vector<::std::uint64_t> &rises(T flag) const noexcept {
+    return rises_[bit_index(flag)];
+  }
+  /// rows where flag turned off, ascending
+  DEADDEV_NODISCARD const ::std::vector<::std::uint64_t> &falls(T flag) const noexcept {
+    return falls_[bit_index(flag)];
+  }
+
+  /// last added row
+  DEADDEV_NODISCARD value_type previous() const noexcept { return previous_; }
+  /// number of added rows
+  DEADDEV_NODISCARD ::std::uint64_t rows() const noexcept { return rows_; }
+
+private:
+  /// unsigned mask, widened without sign extension
+  using lane_type = ::std::make_unsigned_t<mask_type>;
+
+  static ::std::size_t bit_index(T flag) noexcept { return ::deaddev::details::flag_index(flag); }
+
+  value_type previous_;
+  ::std::uint64_t rows_ = 0;
+  ::std::vector<::std::uint64_t> rises_[bits];
+  ::std::vector<::std::uint64_t> falls_[bits];
+};
+
+namespace details {
+
+/// unsigned integer of the same width as a selected element
+template <::std::size_t Size> struct select_word;
+template <> struct select_word<1> {
+  using type = ::std::uint8_t;
+};
+template <> struct select_word<2> {
+  using type = ::std::uint16_t;
+};
+template <> struct select_word<4> {
+  using type = ::std::uint32_t;
+};
+template <> struct select_word<8> {
+  using type = ::std::uint64_t;
+};
+
+/**
+ * @brief Blends up to 64 elements by the bits of a match word
+ * @details Each bit becomes an all ones or all zeros lane mask and the elements are
+ * combined with AND/OR on their bits, so there is no branch to mispredict and the fixed
+ * trip count vectorizes into vector blends
+ */
+template <typename V>
+void select_block(::std::uint64_t word, const V *a, const V *b, V *out,
+                  ::std::size_t count) noexcept {
+  using word_type = typename select_word<sizeof(V)>::type;
+  const auto blend = [&](::std::size_t i) {
+    word_type left;
+    word_type right;
+    ::std::memcpy(&left, a + i, sizeof(V));
+    ::std::memcpy(&right, b + i, sizeof(V));
+    const auto lane = static_cast<word_type>(word_type{0} - static_cast<word_type>((word >> i) & 1u));
+    const auto result = static_cast<word_type>((left & lane) | (right & ~lane));
+    ::std::memcpy(static_cast<void *>(out + i), &result, sizeof(V));
+  };
+  if (count == match_word_rows) {
+    for (::std::size_t i = 0; i < match_word_rows; ++i) {
+      blend(i);
+    }
+  } else {
+    for (::std::size_t i = 0; i < count; ++i) {
+      blend(i);
+    }
+  }
+}
+
+} // namespace details
+
+/**
+ * @brief out[i] = predicate(rows[i]) ? a[i] : b[i] without branches
+ * @tparam T enum type
+ * @tparam Predicate `bool(bitmask<T>)` callable
+ * @tparam V trivially copyable element of 1, 2, 4 or 8 bytes, e.g. an integer or float
+ * @param rows first row
+ * @param count number of rows
+ * @param predicate predicate
+ * @param a elements for matching rows
+ * @param b elements for other rows
+ * @param out output, count elements, may be a or b
+ */
+template <typename T, typename Predicate, typename V>
+void select_if(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+               const Predicate &predicate, const V *a, const V *b, V *out) noexcept {
+  static_assert(::std::is_trivially_copyable<V>::value, "elements are blended as bits");
+  static_assert(sizeof(V) == 1 || sizeof(V) == 2 || sizeof(V) == 4 || sizeof(V) == 8,
+                "elements are 1, 2, 4 or 8 bytes");
+  for (::std::size_t offset = 0; offset < count; offset += match_word_rows) {
+    const ::std::size_t rest = count - offset;
+    const ::std::size_t rows_in_word = rest < match_word_rows ? rest : match_word_rows;
+    ::deaddev::details::select_block(
+        ::deaddev::match_word(rows + offset, rows_in_word, predicate), a + offset, b + offset,
+        out + offset, rows_in_word);
+  }
+}
+
+/**
+ * @brief out[i] = rows[i] has all of flags ? a[i] : b[i] without branches
+ * @tparam T enum type
+ * @tparam V trivially copyable element of 1, 2, 4 or 8 bytes, e.g. an integer or float
+ * @param rows first row
+ * @param count number of rows
+ * @param flags required flags
+ * @param a elements for matching rows
+ * @param b elements for other rows
+ * @param out output, count elements, may be a or b
+ */
+template <typename T, typename V>
+void select_by_flag(const ::deaddev::bitmask<T> *rows, ::std::size_t count,
+                    ::deaddev::bitmask<T> flags, const V *a, const V *b, V *out) noexcept {
+  ::deaddev::select_if(rows, count, ::deaddev::has_all(flags), a, b, out);
+}
+
+/**
+ * @brief out[i] = rows[i] has flag ? a[i] : b[i] without branches
+ * @tparam T enum type
+ * @tparam V trivially copyable element of 1, 2, 4 or 8 bytes, e.g. an integer or float
+ * @param rows first row
+ * @param count number of rows
+ * @param flag required flag
+ * @param a elements for matching rows
+ * @param b elements for other rows
+ * @param out output, count elements, may be a or b
+ */
+template <typename T, typename V, typename = ::deaddev::details::enable_if_bitmask_t<T>>
+void select_by_flag(const ::deaddev::bitmask<T> *rows, ::std::size_t count, T flag,
+                    const V *a, const V *b, V *out) noexcept {
+  ::deaddev::select_if(rows, count, ::deaddev::has_all(flag), a, b, out);
+}
+
+} // namespace deaddev
+
+#endif // DEADDEV_BITMASK_ALGORITHM_HPP
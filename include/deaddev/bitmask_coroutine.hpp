@@ -0,0 +1,462 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Coroutine awaitables for flag conditions
+ * @details `co_await flags.when_all(mask)` suspends until every flag of mask is set,
+ * `when_any` until one of them is. Requires C++20
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_BITMASK_COROUTINE_HPP
+#define DEADDEV_BITMASK_COROUTINE_HPP
+#pragma once
+#include <deaddev/bit.hpp>
+#include <deaddev/bitmask.hpp>
+
+#include <atomic>
+#include <climits>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace deaddev {
+
+/**
+ * @brief Executor that can resume coroutines
+ * @details `post` schedules the handle to be resumed later, on any thread the executor owns
+ */
+template <typename E>
+concept coroutine_executor = requires(E &executor, ::std::coroutine_handle<> handle) {
+  executor.post(handle);
+};
+
+template <typename T> class awaitable_bitmask;
+
+namespace details {
+
+/// intrusive waiter of awaitable_bitmask, lives in the awaiting coroutine frame
+template <typename T> struct flag_waiter {
+  using mask_type = ::std::make_unsigned_t<typename ::deaddev::bitmask<T>::mask_type>;
+
+  /// true if mask satisfies a wait for want
+  DEADDEV_NODISCARD static constexpr bool matches(mask_type want, bool all,
+                                                  mask_type mask) noexcept {
+    return all ? (mask & want) == want : (mask & want) != 0;
+  }
+
+  /// true if mask satisfies the wait
+  DEADDEV_NODISCARD constexpr bool ready(mask_type mask) const noexcept {
+    return matches(want, all, mask);
+  }
+
+  /// resumes the coroutine inline or on the chosen executor
+  void resume() const {
+    if (post != nullptr) {
+      post(executor, handle);
+    } else {
+      handle.resume();
+    }
+  }
+
+  flag_waiter *next = nullptr;
+  mask_type want = 0;
+  bool all = true;
+  ::std::coroutine_handle<> handle;
+  void (*post)(void *, ::std::coroutine_handle<>) = nullptr;
+  void *executor = nullptr;
+};
+
+} // namespace details
+
+/**
+ * @brief Awaiter returned by when_all and when_any
+ * @details resumes with the mask that satisfied the wait
+ * @tparam T enum type
+ */
+template <typename T> class flag_awaiter {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+
+  /// true if the condition already holds
+  DEADDEV_NODISCARD bool await_ready() const noexcept {
+    return waiter_.ready(owner_->load_mask());
+  }
+
+  /**
+   * @brief Registers the coroutine
+   * @details another thread's set() may resume it before this returns
+   * @return false if a set() since await_ready already satisfied the wait, the coroutine
+   * then continues without suspending
+   */
+  bool await_suspend(::std::coroutine_handle<> handle) noexcept {
+    waiter_.handle = handle;
+    return owner_->enqueue(waiter_);
+  }
+
+  /// current mask
+  DEADDEV_NODISCARD value_type await_resume() const noexcept {
+    return value_type{static_cast<typename value_type::mask_type>(owner_->load_mask())};
+  }
+
+private:
+  friend class awaitable_bitmask<T>;
+
+  flag_awaiter(awaitable_bitmask<T> &owner, value_type mask, bool all) noexcept
+      : owner_(&owner) {
+    waiter_.want = static_cast<typename details::flag_waiter<T>::mask_type>(
+        static_cast<typename value_type::mask_type>(mask));
+    waiter_.all = all;
+  }
+
+  template <coroutine_executor E> void resume_on(E &executor) noexcept {
+    waiter_.executor = &executor;
+    waiter_.post = [](void *context, ::std::coroutine_handle<> handle) {
+      static_cast<E *>(context)->post(handle);
+    };
+  }
+
+  awaitable_bitmask<T> *owner_;
+  details::flag_waiter<T> waiter_;
+};
+
+/**
+ * @brief Atomic bitmask coroutines can wait on
+ * @details Every flag has a lock-free intrusive list of waiters. A when_all waiter is kept
+ * in the list of one of its flags that is not set, a when_any waiter for one flag in that
+ * flag's list, so a set() takes only the lists of the flags that changed, resumes the
+ * waiters whose condition holds and files the rest under a flag they still miss. when_any
+ * waiters for several flags share one more list, taken when a flag one of them watches
+ * changes. Every flag counts the waiters watching it, so set() skips the lists when no
+ * waiter watches a flag that changed, and remove() never touches them. Conditions are
+ * checked against the current mask, a flag set and removed again before a waiter is
+ * checked may be missed.
+ * @tparam T enum type
+ */
+template <typename T> class awaitable_bitmask {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// enum type
+  using enum_type = T;
+
+  /// empty mask
+  awaitable_bitmask() noexcept = default;
+  /// initial mask
+  explicit awaitable_bitmask(value_type value) noexcept
+      : mask_(static_cast<unsigned_type>(static_cast<mask_type>(value))) {}
+  awaitable_bitmask(const awaitable_bitmask &) = delete;
+  awaitable_bitmask &operator=(const awaitable_bitmask &) = delete;
+
+  /// current mask
+  DEADDEV_NODISCARD value_type load() const noexcept {
+    return value_type{static_cast<mask_type>(load_mask())};
+  }
+
+  /**
+   * @brief Sets flags and resumes satisfied waiters
+   * @details waiters without an executor are resumed inline on this thread
+   * @param flags flags to set
+   * @return value_type previous mask
+   */
+  value_type set(value_type flags) {
+    const auto bits = static_cast<unsigned_type>(static_cast<mask_type>(flags));
+    const unsigned_type previous = mask_.fetch_or(bits, ::std::memory_order_seq_cst);
+    const auto changed = static_cast<unsigned_type>(bits & ~previous);
+    if (changed != 0 && watched(watchers_, changed)) {
+      version_.fetch_add(1, ::std::memory_order_seq_cst);
+      process(changed);
+    }
+    return value_type{static_cast<mask_type>(previous)};
+  }
+
+  /**
+   * @brief Clears flags
+   * @param flags flags to clear
+   * @return value_type previous mask
+   */
+  value_type remove(value_type flags) noexcept {
+    const auto bits = static_cast<unsigned_type>(static_cast<mask_type>(flags));
+    return value_type{
+        static_cast<mask_type>(mask_.fetch_and(static_cast<unsigned_type>(~bits),
+                                               ::std::memory_order_seq_cst))};
+  }
+
+  /**
+   * @brief Waits until every flag of mask is set
+   * @param mask flags
+   * @return flag_awaiter<T> awaiter, resumed on the setter thread
+   */
+  DEADDEV_NODISCARD flag_awaiter<T> when_all(value_type mask) noexcept {
+    return flag_awaiter<T>(*this, mask, true);
+  }
+
+  /**
+   * @brief Waits until every flag of mask is set
+   * @param mask flags
+   * @param executor executor to resume on, must outlive the wait
+   * @return flag_awaiter<T> awaiter
+   */
+  template <coroutine_executor E>
+  DEADDEV_NODISCARD flag_awaiter<T> when_all(value_type mask, E &executor) noexcept {
+    flag_awaiter<T> awaiter(*this, mask, true);
+    awaiter.resume_on(executor);
+    return awaiter;
+  }
+
+  /**
+   * @brief Waits until a flag of mask is set
+   * @param mask flags
+   * @return flag_awaiter<T> awaiter, resumed on the setter thread
+   */
+  DEADDEV_NODISCARD flag_awaiter<T> when_any(value_type mask) noexcept {
+    return flag_awaiter<T>(*this, mask, false);
+  }
+
+  /**
+   * @brief Waits until a flag of mask is set
+   * @param mask flags
+   * @param executor executor to resume on, must outlive the wait
+   * @return flag_awaiter<T> awaiter
+   */
+  template <coroutine_executor E>
+  DEADDEV_NODISCARD flag_awaiter<T> when_any(value_type mask, E &executor) noexcept {
+    flag_awaiter<T> awaiter(*this, mask, false);
+    awaiter.resume_on(executor);
+    return awaiter;
+  }
+
+private:
+  friend class flag_awaiter<T>;
+  using mask_type = typename value_type::mask_type;
+  using unsigned_type = typename details::flag_waiter<T>::mask_type;
+  using waiter = details::flag_waiter<T>;
+  static constexpr ::std::size_t flag_count = sizeof(unsigned_type) * CHAR_BIT;
+  /// list of the when_any waiters for several flags
+  static constexpr ::std::size_t any_list = flag_count;
+
+  DEADDEV_NODISCARD unsigned_type load_mask() const noexcept {
+    return mask_.load(::std::memory_order_seq_cst);
+  }
+
+  /// true if the waiter is kept in any_list
+  DEADDEV_NODISCARD static constexpr bool shared(unsigned_type want, bool all) noexcept {
+    return !all && (want == 0 || (want & (want - 1)) != 0);
+  }
+
+  /// list a waiter not satisfied by mask is kept in
+  DEADDEV_NODISCARD static ::std::size_t list_of(unsigned_type want, bool all,
+                                                 unsigned_type mask) noexcept {
+    if (shared(want, all)) {
+      return any_list;
+    }
+    const auto missing = static_cast<unsigned_type>(all ? want & ~mask : want);
+    return static_cast<::std::size_t>(
+        ::deaddev::details::countr_zero(static_cast<::std::uint64_t>(missing)));
+  }
+
+  /// true if counts has a waiter watching one of bits
+  DEADDEV_NODISCARD static bool watched(const ::std::atomic<::std::uint32_t> *counts,
+                                        unsigned_type bits) noexcept {
+    auto rest = static_cast<::std::uint64_t>(bits);
+    while (rest != 0) {
+      if (counts[::deaddev::details::countr_zero(rest)].load(::std::memory_order_seq_cst) !=
+          0) {
+        return true;
+      }
+      rest &= rest - 1;
+    }
+    return false;
+  }
+
+  void watch(unsigned_type want, bool all, int delta) noexcept {
+    auto rest = static_cast<::std::uint64_t>(want);
+    while (rest != 0) {
+      const auto flag = static_cast<::std::size_t>(::deaddev::details::countr_zero(rest));
+      watchers_[flag].fetch_add(static_cast<::std::uint32_t>(delta),
+                                ::std::memory_order_seq_cst);
+      if (shared(want, all)) {
+        any_watchers_[flag].fetch_add(static_cast<::std::uint32_t>(delta),
+                                      ::std::memory_order_seq_cst);
+      }
+      rest &= rest - 1;
+    }
+  }
+
+  /**
+   * @brief Registers a waiter
+   * @details Never resumes anything. A set() before the push may have missed the waiter,
+   * so a waiter that is satisfied, or whose list's flag got set, takes itself back out of
+   * its lists and tries again. Other waiters are left to set(), which rescans while a
+   * waiter holds a list
+   * @return true if the waiter stays registered, false if it was satisfied and removed
+   */
+  bool enqueue(waiter &node) noexcept {
+    // node may be resumed and destroyed by another thread once pushed
+    const unsigned_type want = node.want;
+    const bool all = node.all;
+    watch(want, all, 1);
+    for (;;) {
+      unsigned_type mask = load_mask();
+      if (waiter::matches(want, all, mask)) {
+        watch(want, all, -1);
+        return false;
+      }
+      const ::std::size_t list = list_of(want, all, mask);
+      push(list, &node, &node);
+      mask = load_mask();
+      if (!waiter::matches(want, all, mask) &&
+          (list == any_list || ((mask >> list) & 1) == 0)) {
+        return true;
+      }
+      claiming_.fetch_add(1, ::std::memory_order_seq_cst);
+      // setters may have moved the waiter to the list of another of its flags
+      bool found = false;
+      if (list == any_list) {
+        found = take(any_list, node);
+      } else {
+        auto rest = static_cast<::std::uint64_t>(want);
+        while (rest != 0 && !found) {
+          found = take(static_cast<::std::size_t>(::deaddev::details::countr_zero(rest)), node);
+          rest &= rest - 1;
+        }
+      }
+      // setters that found a list empty meanwhile scan again
+      version_.fetch_add(1, ::std::memory_order_seq_cst);
+      claiming_.fetch_sub(1, ::std::memory_order_seq_cst);
+      if (!found) {
+        // a setter holds the waiter and resumes or files it
+        return true;
+      }
+    }
+  }
+
+  /// takes node out of list, false if it is not there
+  bool take(::std::size_t list, waiter &node) noexcept {
+    if (lists_[list].load(::std::memory_order_seq_cst) == nullptr) {
+      return false;
+    }
+    waiter *rest = lists_[list].exchange(nullptr, ::std::memory_order_seq_cst);
+    bool found = false;
+    waiter *first = nullptr;
+    waiter *last = nullptr;
+    while (rest != nullptr) {
+      waiter *next = rest->next;
+      if (rest == &node) {
+        found = true;
+      } else {
+        rest->next = first;
+        first = rest;
+        last = last == nullptr ? rest : last;
+      }
+      rest = next;
+    }
+    if (first != nullptr) {
+      push(list, first, last);
+    }
+    return found;
+  }
+
+  /// pushes the chain first..last to list
+  void push(::std::size_t list, waiter *first, waiter *last) noexcept {
+    waiter *head = lists_[list].load(::std::memory_order_relaxed);
+    do {
+      last->next = head;
+    } while (!lists_[list].compare_exchange_weak(head, first, ::std::memory_order_seq_cst,
+                                                 ::std::memory_order_relaxed));
+  }
+
+  /// moves the satisfied waiters of list to ready and files the rest by their mask
+  void scan(::std::size_t list, waiter *&ready) noexcept {
+    if (lists_[list].load(::std::memory_order_seq_cst) == nullptr) {
+      return;
+    }
+    waiter *node = lists_[list].exchange(nullptr, ::std::memory_order_seq_cst);
+    const unsigned_type mask = load_mask();
+    while (node != nullptr) {
+      waiter *next = node->next;
+      if (node->ready(mask)) {
+        node->next = ready;
+        ready = node;
+      } else {
+        push(list_of(node->want, node->all, mask), node, node);
+      }
+      node = next;
+    }
+  }
+
+  /**
+   * @brief Resumes satisfied waiters in the lists of bits
+   * @details Repeats until no set() or enqueue() raced with the scan. A waiter filed
+   * meanwhile waits in the list of a flag that got set, so repeats take the lists of every
+   * set flag
+   */
+  void process(unsigned_type bits) {
+    ::std::uint64_t version;
+    do {
+      version = version_.load(::std::memory_order_seq_cst);
+      waiter *ready = nullptr;
+      auto rest = static_cast<::std::uint64_t>(bits);
+      while (rest != 0) {
+        scan(static_cast<::std::size_t>(::deaddev::details::countr_zero(rest)), ready);
+        rest &= rest - 1;
+      }
+      if (watched(any_watchers_, bits)) {
+        scan(any_list, ready);
+      }
+      while (ready != nullptr) {
+        waiter *next = ready->next;
+        watch(ready->want, ready->all, -1);
+        // the waiter is gone once its coroutine runs
+        ready->resume();
+        ready = next;
+      }
+      bits = load_mask();
+    } while (version_.load(::std::memory_order_seq_cst) != version ||
+             claiming_.load(::std::memory_order_seq_cst) != 0);
+  }
+
+  ::std::atomic<unsigned_type> mask_{0};
+  /// waiters by flag, any_list last
+  ::std::atomic<waiter *> lists_[flag_count + 1] = {};
+  ::std::atomic<::std::uint64_t> version_{0};
+  /// enqueue() calls holding a list to take their waiter back
+  ::std::atomic<::std::uint32_t> claiming_{0};
+  /// waiters watching each flag
+  ::std::atomic<::std::uint32_t> watchers_[flag_count] = {};
+  /// waiters in any_list watching each flag
+  ::std::atomic<::std::uint32_t> any_watchers_[flag_count] = {};
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_BITMASK_COROUTINE_HPP
@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Sampled per-thread counters of bitmask operations
+ * @details deaddev::sampled_flag_counters is an instrumentation policy for
+ * DEADDEV_INSTRUMENT_BITMASK. It counts, per operation and per flag, how often flags are
+ * set, removed and tested
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_BITMASK_INSTRUMENTATION_HPP
+#define DEADDEV_BITMASK_INSTRUMENTATION_HPP
+#pragma once
+#include <deaddev/bit.hpp>
+#include <deaddev/bitmask.hpp>
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace deaddev {
+
+/// number of bitmask_operation values
+constexpr ::std::size_t bitmask_operation_count = 6;
+
+/**
+ * @brief Counter totals
+ * @tparam Bits flags per mask
+ */
+template <::std::size_t Bits> struct flag_counter_snapshot {
+  /// estimated operations per bitmask_operation and flag bit
+  ::std::uint64_t counts[bitmask_operation_count][Bits] = {};
+
+  /// estimated operations on a bit
+  DEADDEV_NODISCARD ::std::uint64_t count(bitmask_operation operation,
+                                          ::std::size_t bit) const noexcept {
+    return counts[static_cast<::std::size_t>(operation)][bit];
+  }
+};
+
+namespace details {
+
+/**
+ * @brief counters of one thread
+ * @details written only by the owning thread, relaxed atomics let snapshots read them
+ */
+template <::std::size_t Bits> struct flag_counter_block {
+  ::std::atomic<::std::uint64_t> counts[bitmask_operation_count][Bits] = {};
+  /// operations until the next sample
+  unsigned countdown = 0;
+};
+
+/**
+ * @brief registry of live thread blocks and totals of exited threads
+ * @tparam Bits flags per mask
+ */
+template <::std::size_t Bits> struct flag_counter_registry {
+  ::std::mutex lock;
+  ::std::vector<flag_counter_block<Bits> *> blocks;
+  flag_counter_snapshot<Bits> retired;
+
+  void add_to(flag_counter_snapshot<Bits> &totals, const flag_counter_block<Bits> &block) {
+    for (::std::size_t operation = 0; operation < bitmask_operation_count; ++operation) {
+      for (::std::size_t bit = 0; bit < Bits; ++bit) {
+        totals.counts[operation][bit] +=
+            block.counts[operation][bit].load(::std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+} // namespace details
+
+/**
+ * @brief Instrumentation policy with sampled per-thread counters
+ * @details Every SampleRate-th operation of a thread is recorded with weight SampleRate,
+ * so counts are estimates and the hot path is a thread-local decrement. Counters of exited
+ * threads are kept in the totals
+ * @code
+ * DEADDEV_INSTRUMENT_BITMASK(my_flag_bits, deaddev::sampled_flag_counters<my_flag_bits>);
+ * const auto totals = deaddev::sampled_flag_counters<my_flag_bits>::snapshot();
+ * @endcode
+ * @tparam T enum type
+ * @tparam SampleRate operations per sample, 1 records every operation
+ */
+template <typename T, unsigned SampleRate = 64> struct sampled_flag_counters {
+  static_assert(SampleRate > 0, "sample rate must be positive");
+  /// underlying mask type
+  using mask_type = ::std::make_unsigned_t<::std::underlying_type_t<T>>;
+  /// flags per mask
+  static constexpr ::std::size_t bits = sizeof(mask_type) * CHAR_BIT;
+
+  /// instrumentation hook
+  template <typename M>
+  static void on_operation(bitmask_operation operation, M, M operand) noexcept {
+    thread_block &local = block();
+    if (local.block.countdown > 1) {
+      --local.block.countdown;
+      return;
+    }
+    local.block.countdown = SampleRate;
+    auto *counters = local.block.counts[static_cast<::std::size_t>(operation)];
+    for (auto rest = static_cast<::std::uint64_t>(static_cast<mask_type>(operand)); rest != 0;
+         rest &= rest - 1) {
+      auto &counter = counters[::deaddev::details::countr_zero(rest)];
+      counter.store(counter.load(::std::memory_order_relaxed) + SampleRate,
+                    ::std::memory_order_relaxed);
+    }
+  }
+
+  /// totals of all threads
+  DEADDEV_NODISCARD static flag_counter_snapshot<bits> snapshot() {
+    auto &shared = registry();
+    const ::std::lock_guard<::std::mutex> guard(shared.lock);
+    flag_counter_snapshot<bits> totals = shared.retired;
+    for (const auto *block : shared.blocks) {
+      shared.add_to(totals, *block);
+    }
+    return totals;
+  }
+
+  /// clears all counters
+  static void reset() {
+    auto &shared = registry();
+    const ::std::lock_guard<::std::mutex> guard(shared.lock);
+    shared.retired = flag_counter_snapshot<bits>{};
+    for (auto *block : shared.blocks) {
+      for (auto &operation : block->counts) {
+        for (auto &counter : operation) {
+          counter.store(0, ::std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+private:
+  /// registers on first use, folds its counts into the totals on thread exit
+  struct thread_block {
+    thread_block() {
+      auto &shared = registry();
+      const ::std::lock_guard<::std::mutex> guard(shared.lock);
+      shared.blocks.push_back(&block);
+    }
+    ~thread_block() {
+      auto &shared = registry();
+      const ::std::lock_guard<::std::mutex> guard(shared.lock);
+      shared.add_to(shared.retired, block);
+      for (auto &registered : shared.blocks) {
+        if (registered == &block) {
+          registered = shared.blocks.back();
+          shared.blocks.pop_back();
+          break;
+        }
+      }
+    }
+    ::deaddev::details::flag_counter_block<bits> block;
+  };
+
+  static ::deaddev::details::flag_counter_registry<bits> &registry() {
+    // never destroyed, threads may exit after static destruction
+    static auto *shared = new ::deaddev::details::flag_counter_registry<bits>();
+    return *shared;
+  }
+
+  static thread_block &block() {
+    static thread_local thread_block local;
+    return local;
+  }
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_BITMASK_INSTRUMENTATION_HPP
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Registration macros for deaddev::bitmask
+ * @details Macros don't cross module boundaries, so users of `import deaddev.bitmask;`
+ * include this header to get DEADDEV_ENABLE_BITMASK, DEADDEV_INSTRUMENT_BITMASK and their
+ * _EXTERNAL variants. It declares nothing itself, the macros expand to entities exported by the module.
+ * deaddev/bitmask.hpp includes it, so this is the only definition of the macros
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_BITMASK_MACROS_HPP
+#define DEADDEV_BITMASK_MACROS_HPP
+#pragma once
+
+/**
+ * @brief Enable bitmask operations for enum
+ * @details defines `auto adl_bitmask_operations_check(T) ->
+ * ::deaddev::details::bitmask_traits<T, ...>` function for ADL-based type checks
+ * @param T enum type
+ * @param ... optional enum values list for all flags calculation
+ */
+#ifndef DEADDEV_ENABLE_BITMASK
+#define DEADDEV_ENABLE_BITMASK(T, ...)                                                   \
+  auto adl_bitmask_operations_check(T &) -> ::deaddev::details::bitmask_traits<          \
+      T, ::deaddev::details::calculate_all_flags<T>(__VA_ARGS__)>;
+#endif
+
+/**
+ * @brief Enable bitmask operations for enum
+ * @details defines template specialization for
+ * `struct ::deaddev::details::bitmask_operations_check_traits<T>`
+ * for ADL-independent type checks
+ * @param T enum type
+ * @param ... optional enum values list for all flags calculation
+ */
+#ifndef DEADDEV_ENABLE_BITMASK_EXTERNAL
+#define DEADDEV_ENABLE_BITMASK_EXTERNAL(T, ...)                                          \
+  template <>                                                                            \
+  struct deaddev::details::bitmask_operations_check_traits<T>                            \
+      : ::deaddev::details::bitmask_traits<                                              \
+            T, ::deaddev::details::calculate_all_flags<T>(__VA_ARGS__)> {};
+#endif
+
+/**
+ * @brief Instrument bitmask operations of enum
+ * @details defines `auto adl_bitmask_instrumentation(T) -> Policy` function for ADL-based
+ * lookup. set, remove, is_set and the compound assignment operators of deaddev::bitmask<T>
+ * call `Policy::on_operation(operation, mask, operand)` before they run
+ * @param T enum type
+ * @param ... hook class, e.g. deaddev::sampled_flag_counters<T>
+ */
+#ifndef DEADDEV_INSTRUMENT_BITMASK
+#define DEADDEV_INSTRUMENT_BITMASK(T, ...)                                               \
+  auto adl_bitmask_instrumentation(T &)                                                  \
+      -> ::deaddev::details::enabled_bitmask_instrumentation<__VA_ARGS__>;
+#endif
+
+/**
+ * @brief Instrument bitmask operations of enum
+ * @details defines template specialization for
+ * `struct ::deaddev::details::bitmask_instrumentation_traits<T>`
+ * for ADL-independent lookup
+ * @param T enum type
+ * @param ... hook class
+ */
+#ifndef DEADDEV_INSTRUMENT_BITMASK_EXTERNAL
+#define DEADDEV_INSTRUMENT_BITMASK_EXTERNAL(T, ...)                                      \
+  template <>                                                                            \
+  struct deaddev::details::bitmask_instrumentation_traits<T>                             \
+      : ::deaddev::details::enabled_bitmask_instrumentation<__VA_ARGS__> {};
+#endif
+
+#endif // DEADDEV_BITMASK_MACROS_HPP
@@ -0,0 +1,414 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lazy views over deaddev::bitmask values and columns
+ * @details `views::where` steps through match words computed 64 rows at a time by
+ * deaddev::match_word, so lazy pipelines keep the bulk kernels inner loop. Requires C++20
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_BITMASK_RANGES_HPP
+#define DEADDEV_BITMASK_RANGES_HPP
+#pragma once
+#include <deaddev/bit.hpp>
+#include <deaddev/bitmask.hpp>
+#include <deaddev/bitmask_algorithm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace deaddev {
+
+/**
+ * @brief View of the single flags set in a mask
+ * @details yields flags from the lowest bit to the highest
+ * @tparam T enum type
+ */
+template <typename T>
+class set_flags_view : public ::std::ranges::view_interface<set_flags_view<T>> {
+  using unsigned_type = ::std::make_unsigned_t<typename ::deaddev::bitmask<T>::mask_type>;
+
+public:
+  /// forward iterator over set flags
+  class iterator {
+  public:
+    /// iterator concept
+    using iterator_concept = ::std::forward_iterator_tag;
+    /// iterator category
+    using iterator_category = ::std::forward_iterator_tag;
+    /// flag type
+    using value_type = T;
+    /// difference type
+    using difference_type = ::std::ptrdiff_t;
+
+    /// end iterator
+    constexpr iterator() noexcept = default;
+    /// iterator over remaining bits
+    constexpr explicit iterator(unsigned_type bits) noexcept : bits_(bits) {}
+
+    /// lowest remaining flag
+    DEADDEV_NODISCARD constexpr T operator*() const noexcept {
+      return static_cast<T>(bits_ & static_cast<unsigned_type>(~bits_ + 1));
+    }
+    /// next flag
+    constexpr iterator &operator++() noexcept {
+      bits_ &= static_cast<unsigned_type>(bits_ - 1);
+      return *this;
+    }
+    /// next flag
+    constexpr iterator operator++(int) noexcept {
+      iterator result = *this;
+      ++*this;
+      return result;
+    }
+    /// comparison operator
+    DEADDEV_NODISCARD friend constexpr bool operator==(iterator left,
+                                                       iterator right) noexcept {
+      return left.bits_ == right.bits_;
+    }
+    /// comparison operator
+    DEADDEV_NODISCARD friend constexpr bool operator==(iterator it,
+                                                       ::std::default_sentinel_t) noexcept {
+      return it.bits_ == 0;
+    }
+
+  private:
+    unsigned_type bits_{};
+  };
+
+  /// empty view
+  constexpr set_flags_view() noexcept = default;
+  /// view of mask
+  constexpr explicit set_flags_view(::deaddev::bitmask<T> mask) noexcept
+      : bits_(static_cast<unsigned_type>(
+            static_cast<typename ::deaddev::bitmask<T>::mask_type>(mask))) {}
+
+  /// first flag
+  DEADDEV_NODISCARD constexpr iterator begin() const noexcept { return iterator(bits_); }
+  /// end iterator
+  DEADDEV_NODISCARD constexpr iterator end() const noexcept { return iterator(); }
+  /// number of set flags
+  DEADDEV_NODISCARD ::std::size_t size() const noexcept {
+    return static_cast<::std::size_t>(::deaddev::details::popcount(bits_));
+  }
+
+private:
+  unsigned_type bits_{};
+};
+
+namespace details {
+
+/**
+ * @brief Assignable holder of a copyable callable
+ * @details Lambdas with captures cannot be assigned, views must be. Assignment destroys
+ * the held value and copies the other one in, like the standard library's movable-box
+ * @tparam T callable type
+ */
+template <typename T> class copyable_box {
+public:
+  /// default constructed value
+  copyable_box() noexcept(::std::is_nothrow_default_constructible_v<T>)
+    requires ::std::default_initializable<T>
+      : value_(::std::in_place) {}
+  /// holds value
+  explicit copyable_box(T value) noexcept(::std::is_nothrow_move_constructible_v<T>)
+      : value_(::std::in_place, ::std::move(value)) {}
+  copyable_box(const copyable_box &) = default;
+  copyable_box(copyable_box &&) = default;
+
+  /// copy assignment operator
+  copyable_box &operator=(const copyable_box &other) {
+    if (this != &other) {
+      assign(other.value_);
+    }
+    return *this;
+  }
+  /// move assignment operator
+  copyable_box &operator=(copyable_box &&other) {
+    if (this != &other) {
+      assign(::std::move(other.value_));
+    }
+    return *this;
+  }
+
+  /// held value
+  DEADDEV_NODISCARD const T &operator*() const noexcept { return *value_; }
+
+private:
+  template <typename U> void assign(U &&other) {
+    if (other) {
+      value_.emplace(*::std::forward<U>(other));
+    } else {
+      value_.reset();
+    }
+  }
+
+  ::std::optional<T> value_;
+};
+
+} // namespace details
+
+/**
+ * @brief View of rows matching predicate
+ * @details Rows are tested 64 at a time; the iterator walks the set bits of the current
+ * match word and computes the next one only when it runs out
+ * @tparam V contiguous sized view of deaddev::bitmask
+ * @tparam Predicate `bool(bitmask<T>)` callable
+ * @tparam Indices yield row indices instead of row references
+ */
+template <::std::ranges::view V, typename Predicate, bool Indices>
+  requires ::std::ranges::contiguous_range<V> && ::std::ranges::sized_range<V>
+class where_view
+    : public ::std::ranges::view_interface<where_view<V, Predicate, Indices>> {
+  using row_type = ::std::remove_cv_t<::std::ranges::range_value_t<V>>;
+  using pointer = const row_type *;
+
+public:
+  /// forward iterator over matches
+  class iterator {
+  public:
+    /// iterator concept
+    using iterator_concept = ::std::forward_iterator_tag;
+    /// iterator category
+    using iterator_category = ::std::forward_iterator_tag;
+    /// row or index
+    using value_type = ::std::conditional_t<Indices, ::std::size_t, row_type>;
+    /// difference type
+    using difference_type = ::std::ptrdiff_t;
+    /// row reference or index
+    using reference = ::std::conditional_t<Indices, ::std::size_t, const row_type &>;
+
+    /// singular iterator
+    iterator() = default;
+
+    /// match at current position
+    DEADDEV_NODISCARD reference operator*() const noexcept {
+      if constexpr (Indices) {
+        return index();
+      } else {
+        return rows_[index()];
+      }
+    }
+    /// index of current row
+    DEADDEV_NODISCARD ::std::size_t index() const noexcept {
+      return base_ + static_cast<::std::size_t>(::deaddev::details::countr_zero(word_));
+    }
+    /// next match
+    iterator &operator++() noexcept {
+      word_ &= word_ - 1;
+      settle();
+      return *this;
+    }
+    /// next match
+    iterator operator++(int) noexcept {
+      iterator result = *this;
+      ++*this;
+      return result;
+    }
+    /// comparison operator
+    DEADDEV_NODISCARD friend bool operator==(const iterator &left,
+                                             const iterator &right) noexcept {
+      return left.base_ == right.base_ && left.word_ == right.word_;
+    }
+    /// comparison operator
+    DEADDEV_NODISCARD friend bool operator==(const iterator &it,
+                                             ::std::default_sentinel_t) noexcept {
+      return it.base_ >= it.size_;
+    }
+
+  private:
+    friend where_view;
+
+    iterator(pointer rows, ::std::size_t size, const Predicate *predicate) noexcept
+        : rows_(rows), size_(size), predicate_(predicate) {
+      load();
+      settle();
+    }
+
+    void load() noexcept {
+      if (base_ < size_) {
+        const ::std::size_t rest = size_ - base_;
+        word_ = ::deaddev::match_word(
+            rows_ + base_, rest < match_word_rows ? rest : match_word_rows, *predicate_);
+      }
+    }
+
+    /// skips words without matches
+    void settle() noexcept {
+      while (word_ == 0 && base_ < size_) {
+        base_ += match_word_rows;
+        load();
+      }
+      if (base_ > size_) {
+        base_ = size_;
+      }
+    }
+
+    pointer rows_{};
+    ::std::size_t size_{};
+    ::std::size_t base_{};
+    ::std::uint64_t word_{};
+    const Predicate *predicate_{};
+  };
+
+  /// empty view
+  where_view() = default;
+  /// view of matching rows of base
+  where_view(V base, Predicate predicate)
+      : base_(::std::move(base)), predicate_(::std::move(predicate)) {}
+
+  /// first match
+  DEADDEV_NODISCARD iterator begin() const {
+    return iterator(::std::ranges::data(base_),
+                    static_cast<::std::size_t>(::std::ranges::size(base_)), &*predicate_);
+  }
+  /// end sentinel
+  DEADDEV_NODISCARD ::std::default_sentinel_t end() const noexcept {
+    return ::std::default_sentinel;
+  }
+  /// underlying view
+  DEADDEV_NODISCARD V base() const { return base_; }
+
+private:
+  V base_{};
+  ::deaddev::details::copyable_box<Predicate> predicate_{};
+};
+
+namespace details {
+
+/**
+ * @brief pipeable adaptor
+ * @details `range | adaptor` calls the stored function with the range
+ * @tparam F `view(range)` callable
+ */
+template <typename F> struct range_adaptor_closure {
+  /// adaptor
+  F function;
+
+  /// pipe operator
+  template <::std::ranges::viewable_range R>
+  DEADDEV_NODISCARD friend auto operator|(R &&range, const range_adaptor_closure &closure) {
+    return closure.function(::std::forward<R>(range));
+  }
+};
+
+/**
+ * @brief makes pipeable adaptor
+ * @tparam F `view(range)` callable
+ * @param function adaptor
+ * @return range_adaptor_closure<F> pipeable adaptor
+ */
+template <typename F> constexpr auto make_range_adaptor_closure(F function) {
+  return range_adaptor_closure<F>{::std::move(function)};
+}
+
+/**
+ * @brief views::where implementation
+ * @tparam Indices yield row indices
+ */
+template <bool Indices> struct where_adaptor {
+  /// view of matching rows
+  template <::std::ranges::viewable_range R, typename Predicate>
+  DEADDEV_NODISCARD auto operator()(R &&range, Predicate predicate) const {
+    return ::deaddev::where_view<::std::views::all_t<R>, Predicate, Indices>(
+        ::std::views::all(::std::forward<R>(range)), ::std::move(predicate));
+  }
+  /// pipeable adaptor
+  template <typename Predicate> DEADDEV_NODISCARD auto operator()(Predicate predicate) const {
+    return make_range_adaptor_closure(
+        [predicate = ::std::move(predicate)]<typename R>(R &&range) {
+          return where_adaptor{}(::std::forward<R>(range), predicate);
+        });
+  }
+};
+
+/**
+ * @brief views::masked implementation
+ */
+struct masked_adaptor {
+  /// view of rows combined with mask using bitwise "and"
+  template <::std::ranges::viewable_range R, typename T>
+  DEADDEV_NODISCARD auto operator()(R &&range, ::deaddev::bitmask<T> mask) const {
+    return ::std::views::transform(
+        ::std::forward<R>(range),
+        [mask](::deaddev::bitmask<T> row) noexcept { return row & mask; });
+  }
+  /// pipeable adaptor
+  template <typename T> DEADDEV_NODISCARD auto operator()(::deaddev::bitmask<T> mask) const {
+    return make_range_adaptor_closure([mask]<typename R>(R &&range) {
+      return masked_adaptor{}(::std::forward<R>(range), mask);
+    });
+  }
+  /// pipeable adaptor
+  template <typename T, typename = ::deaddev::details::enable_if_bitmask_t<T>>
+  DEADDEV_NODISCARD auto operator()(T flag) const {
+    return (*this)(::deaddev::bitmask<T>(flag));
+  }
+};
+
+/**
+ * @brief views::set_flags implementation
+ */
+struct set_flags_adaptor {
+  /// view of single flags of mask
+  template <typename T>
+  DEADDEV_NODISCARD constexpr auto operator()(::deaddev::bitmask<T> mask) const noexcept {
+    return ::deaddev::set_flags_view<T>(mask);
+  }
+};
+
+} // namespace details
+
+/**
+ * @brief range adaptors
+ */
+namespace views {
+
+/// `views::set_flags(mask)`: single flags set in mask, lowest first
+inline constexpr ::deaddev::details::set_flags_adaptor set_flags{};
+
+/// `column | views::where(predicate)`: references to rows matching predicate
+inline constexpr ::deaddev::details::where_adaptor<false> where{};
+
+/// `column | views::where_indices(predicate)`: indices of rows matching predicate
+inline constexpr ::deaddev::details::where_adaptor<true> where_indices{};
+
+/// `range | views::masked(mask)`: every row combined with mask using bitwise "and"
+inline constexpr ::deaddev::details::masked_adaptor masked{};
+
+} // namespace views
+} // namespace deaddev
+
+#endif // DEADDEV_BITMASK_RANGES_HPP
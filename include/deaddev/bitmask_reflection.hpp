@@ -0,0 +1,250 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Flag discovery for deaddev::bitmask
+ * @details Finds valid power-of-two enumerators and their names at compile time by
+ * probing `__PRETTY_FUNCTION__` (`__FUNCSIG__` on MSVC) once per bit of the underlying
+ * type, so the cost is bounded by 64 instantiations per enum. Requires C++17 and an
+ * enum with a fixed underlying type (every `enum class` or `enum E : type`)
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_BITMASK_REFLECTION_HPP
+#define DEADDEV_BITMASK_REFLECTION_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus < 201703L && (!defined(_MSVC_LANG) || _MSVC_LANG < 201703L)
+#error "deaddev/bitmask_reflection.hpp requires C++17"
+#endif
+
+namespace deaddev {
+namespace details {
+
+/**
+ * @brief compiler generated signature with enum value as template argument
+ * @tparam T enum type
+ * @tparam V probed value
+ * @return ::std::string_view function signature
+ */
+template <typename T, T V> constexpr auto enumerator_signature() noexcept -> ::std::string_view {
+#if defined(_MSC_VER) && !defined(__clang__)
+  return __FUNCSIG__;
+#else
+  return __PRETTY_FUNCTION__;
+#endif
+}
+
+/**
+ * @brief identifier character check
+ * @param c character
+ * @return true c can be a part of an identifier
+ */
+constexpr auto is_identifier_char(char c) noexcept -> bool {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+         c == '_';
+}
+
+/**
+ * @brief extracts enumerator name from the signature
+ * @details Valid values are printed as `ns::type::name`, invalid ones as `(ns::type)8`
+ * (GCC, Clang) or `0x8` (MSVC), so a name is the last identifier that doesn't start with
+ * a digit
+ * @param signature enumerator_signature<T, V>() result
+ * @return ::std::string_view name or empty view if V is not an enumerator
+ */
+constexpr auto enumerator_name_from_signature(::std::string_view signature) noexcept
+    -> ::std::string_view {
+#if defined(_MSC_VER) && !defined(__clang__)
+  const auto end = signature.rfind(">(");
+  const auto begin = signature.rfind(',', end) + 1;
+#else
+  const auto begin = signature.find("V = ") + 4;
+  const auto end = signature.find_first_of(";]", begin);
+#endif
+  auto name_begin = end;
+  while (name_begin > begin && is_identifier_char(signature[name_begin - 1])) {
+    --name_begin;
+  }
+  if (name_begin == end || (signature[name_begin] >= '0' && signature[name_begin] <= '9')) {
+    return {};
+  }
+  return signature.substr(name_begin, end - name_begin);
+}
+
+/**
+ * @brief enumerator name with static storage
+ * @details the name is copied out of the signature so it doesn't depend on how long the
+ * compiler keeps `__PRETTY_FUNCTION__` around
+ * @tparam T enum type
+ * @tparam V probed value
+ */
+template <typename T, T V> struct enumerator_name {
+  /// name length
+  static constexpr ::std::size_t size =
+      enumerator_name_from_signature(enumerator_signature<T, V>()).size();
+
+  /**
+   * @brief copies name into array
+   * @return ::std::array<char, size + 1> null-terminated name
+   */
+  static constexpr auto make_storage() noexcept -> ::std::array<char, size + 1> {
+    ::std::array<char, size + 1> result{};
+    const auto name = enumerator_name_from_signature(enumerator_signature<T, V>());
+    for (::std::size_t i = 0; i < size; ++i) {
+      result[i] = name[i];
+    }
+    return result;
+  }
+
+  /// null-terminated name
+  static constexpr ::std::array<char, size + 1> storage = make_storage();
+  /// name or empty view if V is not an enumerator
+  static constexpr ::std::string_view value{storage.data(), size};
+};
+
+/**
+ * @brief single bit value of enum
+ * @tparam T enum type
+ * @param bit bit index
+ * @return T value with only `bit` set
+ */
+template <typename T> constexpr auto flag_from_bit(::std::size_t bit) noexcept -> T {
+  using unsigned_type = ::std::make_unsigned_t<::std::underlying_type_t<T>>;
+  return static_cast<T>(static_cast<unsigned_type>(unsigned_type{1} << bit));
+}
+
+} // namespace details
+
+/**
+ * @brief Compile time list of enum flags
+ * @details One probe per bit of the underlying type
+ * @tparam T enum type with fixed underlying type
+ */
+template <typename T> struct reflected_flags {
+  static_assert(::std::is_enum<T>::value, "T must be an enum");
+
+  /// underlying type of enum
+  using mask_type = ::std::underlying_type_t<T>;
+  /// number of probed bits
+  static constexpr ::std::size_t bits = sizeof(T) * CHAR_BIT;
+
+private:
+  template <::std::size_t... I>
+  static constexpr auto make_names(::std::index_sequence<I...>) noexcept
+      -> ::std::array<::std::string_view, bits> {
+    return {{::deaddev::details::enumerator_name<
+        T, ::deaddev::details::flag_from_bit<T>(I)>::value...}};
+  }
+
+  static constexpr auto make_all_flags() noexcept -> mask_type {
+    mask_type result{0};
+    for (::std::size_t i = 0; i < bits; ++i) {
+      if (!names[i].empty()) {
+        result |= static_cast<mask_type>(::deaddev::details::flag_from_bit<T>(i));
+      }
+    }
+    return result;
+  }
+
+  static constexpr auto make_count() noexcept -> ::std::size_t {
+    ::std::size_t result = 0;
+    for (::std::size_t i = 0; i < bits; ++i) {
+      result += names[i].empty() ? 0 : 1;
+    }
+    return result;
+  }
+
+public:
+  /// flag names indexed by bit, empty for bits without enumerator
+  static constexpr ::std::array<::std::string_view, bits> names =
+      make_names(::std::make_index_sequence<bits>{});
+  /// combination of all discovered flags
+  static constexpr T all_flags = static_cast<T>(make_all_flags());
+  /// number of discovered flags
+  static constexpr ::std::size_t count = make_count();
+};
+
+/**
+ * @brief All flags combined
+ * @details usable as an argument of DEADDEV_ENABLE_BITMASK
+ * @tparam T enum type
+ * @return T combination of all discovered flags
+ */
+template <typename T> DEADDEV_CONSTEVAL auto reflected_all_flags() noexcept -> T {
+  return ::deaddev::reflected_flags<T>::all_flags;
+}
+
+/**
+ * @brief name of a single flag
+ * @tparam T enum type
+ * @param flag enum value
+ * @return ::std::string_view enumerator name or empty view if flag is not a single
+ * discovered flag
+ */
+template <typename T> constexpr auto flag_name(T flag) noexcept -> ::std::string_view {
+  using unsigned_type = ::std::make_unsigned_t<::std::underlying_type_t<T>>;
+  const auto value = static_cast<unsigned_type>(flag);
+  if (value == 0 || (value & (value - 1)) != 0) {
+    return {};
+  }
+  ::std::size_t bit = 0;
+  while ((value >> bit) != 1) {
+    ++bit;
+  }
+  return ::deaddev::reflected_flags<T>::names[bit];
+}
+
+} // namespace deaddev
+
+/**
+ * @brief Enable bitmask operations for enum with discovered flags
+ * @details DEADDEV_ENABLE_BITMASK without the flags list
+ * @param T enum type
+ */
+#define DEADDEV_ENABLE_BITMASK_REFLECTED(T)                                              \
+  DEADDEV_ENABLE_BITMASK(T, ::deaddev::reflected_all_flags<T>())
+
+/**
+ * @brief Enable bitmask operations for enum with discovered flags
+ * @details DEADDEV_ENABLE_BITMASK_EXTERNAL without the flags list
+ * @param T enum type
+ */
+#define DEADDEV_ENABLE_BITMASK_REFLECTED_EXTERNAL(T)                                     \
+  DEADDEV_ENABLE_BITMASK_EXTERNAL(T, ::deaddev::reflected_all_flags<T>())
+
+#endif // DEADDEV_BITMASK_REFLECTION_HPP
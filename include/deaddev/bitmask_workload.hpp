@@ -0,0 +1,446 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Synthetic workloads of deaddev::bitmask values
+ * @details Reproducible generator for benchmarks and soak tests. Output depends only on
+ * the seed and the configuration, not on the number of threads
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_BITMASK_WORKLOAD_HPP
+#define DEADDEV_BITMASK_WORKLOAD_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace deaddev {
+namespace details {
+
+/**
+ * @brief splitmix64 step
+ * @details used to expand a seed into generator states
+ * @param state generator state
+ * @return ::std::uint64_t next value
+ */
+inline auto splitmix64(::std::uint64_t &state) noexcept -> ::std::uint64_t {
+  ::std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief rotate left
+ * @param value value
+ * @param shift shift in (0, 64)
+ * @return ::std::uint64_t rotated value
+ */
+constexpr auto rotl64(::std::uint64_t value, int shift) noexcept -> ::std::uint64_t {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+/**
+ * @brief four independent xoshiro256++ generators
+ * @details lanes are stored component-wise so the step is vectorized by the compiler
+ */
+class xoshiro256pp_x4 {
+public:
+  /// number of lanes
+  static constexpr ::std::size_t lanes = 4;
+
+  /**
+   * @brief seeds all lanes from one value
+   * @param seed seed
+   */
+  explicit xoshiro256pp_x4(::std::uint64_t seed) noexcept {
+    for (::std::size_t lane = 0; lane < lanes; ++lane) {
+      s0_[lane] = splitmix64(seed);
+      s1_[lane] = splitmix64(seed);
+      s2_[lane] = splitmix64(seed);
+      s3_[lane] = splitmix64(seed);
+    }
+  }
+
+  /**
+   * @brief advances all lanes
+   * @param out one value per lane
+   */
+  void next(::std::uint64_t (&out)[lanes]) noexcept {
+    for (::std::size_t lane = 0; lane < lanes; ++lane) {
+      out[lane] = rotl64(s0_[lane] + s3_[lane], 23) + s0_[lane];
+      const ::std::uint64_t t = s1_[lane] << 17;
+      s2_[lane] ^= s0_[lane];
+      s3_[lane] ^= s1_[lane];
+      s1_[lane] ^= s2_[lane];
+      s0_[lane] ^= s3_[lane];
+      s2_[lane] ^= t;
+      s3_[lane] = rotl64(s3_[lane], 45);
+    }
+  }
+
+private:
+  ::std::uint64_t s0_[lanes];
+  ::std::uint64_t s1_[lanes];
+  ::std::uint64_t s2_[lanes];
+  ::std::uint64_t s3_[lanes];
+};
+
+/**
+ * @brief probability as a threshold for 32 random bits
+ * @param probability probability, clamped to [0, 1]
+ * @return ::std::uint64_t threshold in [0, 2^32]
+ */
+inline auto probability_threshold(double probability) noexcept -> ::std::uint64_t {
+  probability = ::std::min(1.0, ::std::max(0.0, probability));
+  return static_cast<::std::uint64_t>(::std::ldexp(probability, 32));
+}
+
+} // namespace details
+
+/**
+ * @brief Synthetic bitmask workload generator
+ * @details Each mask is drawn from
+ * - per-flag probabilities (0.5 for every flag of `bitmask<T>::all_flags()` by default,
+ *   resolution 2^-16)
+ * - correlated groups, set all together with their own probability
+ * - optionally a Zipf distribution over a dictionary of masks drawn from the two above
+ * - optionally temporal locality: the previous mask is repeated with some probability
+ *
+ * Output is split into blocks of `block_size` masks and every block has its own random
+ * stream, so `fill` gives the same result with any number of threads.
+ * @tparam T enum type
+ */
+template <typename T> class workload_generator {
+public:
+  /// generated value type
+  using bitmask_type = ::deaddev::bitmask<T>;
+  /// underlying type of enum
+  using mask_type = typename bitmask_type::mask_type;
+  /// masks per random stream
+  static constexpr ::std::size_t block_size = ::std::size_t{1} << 16;
+
+  /**
+   * @brief generator with every flag set with probability 0.5
+   * @param seed seed
+   */
+  explicit workload_generator(::std::uint64_t seed) : seed_(seed) {
+    flag_probability(bitmask_type::all_flags(), 0.5);
+  }
+
+  /**
+   * @brief sets probability of every flag in flags
+   * @param flags flags
+   * @param probability independent probability of each flag
+   * @return workload_generator& call chaining
+   */
+  workload_generator &flag_probability(bitmask_type flags, double probability) {
+    const auto threshold = ::deaddev::details::probability_threshold(probability);
+    auto remaining = static_cast<unsigned_type>(static_cast<mask_type>(flags));
+    while (remaining != 0) {
+      const unsigned_type bit = remaining & (~remaining + 1);
+      remaining ^= bit;
+      auto it = ::std::find_if(flags_.begin(), flags_.end(),
+                               [bit](const rule &r) { return r.bits == bit; });
+      if (it == flags_.end()) {
+        flags_.push_back(rule{bit, threshold});
+      } else {
+        it->threshold = threshold;
+      }
+    }
+    build_planes();
+    return *this;
+  }
+
+  /**
+   * @brief adds correlated group
+   * @details all flags of the group are set together, on top of per-flag probabilities
+   * @param flags group
+   * @param probability group probability
+   * @return workload_generator& call chaining
+   */
+  workload_generator &group(bitmask_type flags, double probability) {
+    groups_.push_back(rule{static_cast<unsigned_type>(static_cast<mask_type>(flags)),
+                           ::deaddev::details::probability_threshold(probability)});
+    return *this;
+  }
+
+  /**
+   * @brief draws masks from a Zipf distribution over a dictionary
+   * @details The dictionary is drawn from the flag and group rules configured so far,
+   * entry k has weight 1 / (k + 1)^exponent. Pass 0 entries to disable
+   * @param entries dictionary size, at most 2^32
+   * @param exponent Zipf exponent
+   * @return workload_generator& call chaining
+   */
+  workload_generator &zipf(::std::size_t entries, double exponent) {
+    dictionary_.clear();
+    alias_threshold_.clear();
+    alias_index_.clear();
+    if (entries == 0) {
+      return *this;
+    }
+    // dictionary stream is separate from every block stream
+    ::std::vector<bitmask_type> drawn(entries);
+    generate_block(drawn.data(), entries, ~::std::uint64_t{0});
+    dictionary_.reserve(entries);
+    for (const bitmask_type mask : drawn) {
+      dictionary_.push_back(static_cast<unsigned_type>(static_cast<mask_type>(mask)));
+    }
+    build_alias_table(entries, exponent);
+    return *this;
+  }
+
+  /**
+   * @brief repeats the previous mask with some probability
+   * @param repeat_probability probability of repeating the previous mask
+   * @return workload_generator& call chaining
+   */
+  workload_generator &locality(double repeat_probability) {
+    repeat_threshold_ = ::deaddev::details::probability_threshold(repeat_probability);
+    return *this;
+  }
+
+  /**
+   * @brief fills range with generated masks
+   * @param first output
+   * @param count number of masks
+   * @param threads number of threads, 0 for hardware concurrency
+   */
+  void fill(bitmask_type *first, ::std::size_t count, unsigned threads = 0) const {
+    const ::std::size_t blocks = (count + block_size - 1) / block_size;
+    if (threads == 0) {
+      threads = ::std::max(1u, ::std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(::std::min<::std::size_t>(threads, blocks));
+    const auto work = [this, first, count, blocks, threads](unsigned index) {
+      for (::std::size_t block = index; block < blocks; block += threads) {
+        const ::std::size_t offset = block * block_size;
+        generate_block(first + offset, ::std::min(block_size, count - offset), block);
+      }
+    };
+    if (threads <= 1) {
+      if (blocks != 0) {
+        work(0);
+      }
+      return;
+    }
+    ::std::vector<::std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned index = 1; index < threads; ++index) {
+      pool.emplace_back(work, index);
+    }
+    work(0);
+    for (auto &thread : pool) {
+      thread.join();
+    }
+  }
+
+  /**
+   * @brief generates masks
+   * @param count number of masks
+   * @param threads number of threads, 0 for hardware concurrency
+   * @return ::std::vector<bitmask_type> generated masks
+   */
+  DEADDEV_NODISCARD ::std::vector<bitmask_type> generate(::std::size_t count,
+                                                         unsigned threads = 0) const {
+    ::std::vector<bitmask_type> result(count);
+    fill(result.data(), count, threads);
+    return result;
+  }
+
+private:
+  using unsigned_type = ::std::make_unsigned_t<mask_type>;
+  using rng_type = ::deaddev::details::xoshiro256pp_x4;
+  static constexpr ::std::size_t lanes = rng_type::lanes;
+
+  /// flags set together with probability threshold / 2^32
+  struct rule {
+    unsigned_type bits;
+    ::std::uint64_t threshold;
+  };
+
+  /**
+   * @brief sequential reader of the four generator lanes
+   */
+  class word_source {
+  public:
+    explicit word_source(::std::uint64_t seed) noexcept : rng_(seed) {}
+
+    ::std::uint64_t operator()() noexcept {
+      if (next_ == lanes) {
+        rng_.next(buffer_);
+        next_ = 0;
+      }
+      return buffer_[next_++];
+    }
+
+  private:
+    rng_type rng_;
+    ::std::uint64_t buffer_[lanes];
+    ::std::size_t next_{lanes};
+  };
+
+  /**
+   * @brief splits flag thresholds into bit planes
+   * @details Plane j has flags whose threshold has bit j set, so all flags are compared
+   * with their random numbers at once, one random word per threshold bit. Thresholds are
+   * rounded to 16 bits (probability step 2^-16) to bound the number of planes
+   */
+  void build_planes() noexcept {
+    always_ = 0;
+    sampled_ = 0;
+    lowest_plane_ = 32;
+    for (auto &plane : planes_) {
+      plane = 0;
+    }
+    for (const rule &flag : flags_) {
+      const ::std::uint64_t threshold = (flag.threshold + 0x8000) & ~::std::uint64_t{0xFFFF};
+      if (threshold > 0xFFFFFFFFull) {
+        always_ |= flag.bits;
+      } else if (threshold != 0) {
+        sampled_ |= flag.bits;
+        for (::std::size_t bit = 16; bit < 32; ++bit) {
+          if ((threshold >> bit) & 1) {
+            planes_[bit] |= flag.bits;
+            lowest_plane_ = ::std::min(lowest_plane_, bit);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief draws mask from flag and group rules
+   * @details Bit-sliced `random < threshold` for every flag, from the most significant
+   * bit down until all flags are decided. Bits under the lowest plane are zero in every
+   * threshold, so equal prefixes there mean `random >= threshold`: probability 0.5 takes
+   * one random word per mask, 0.25 two, and so on
+   */
+  unsigned_type draw(word_source &words) const noexcept {
+    unsigned_type result = always_;
+    unsigned_type undecided = sampled_;
+    for (::std::size_t bit = 32; bit-- > lowest_plane_ && undecided != 0;) {
+      const auto random = static_cast<unsigned_type>(words());
+      result |= undecided & static_cast<unsigned_type>(~random) & planes_[bit];
+      undecided &= static_cast<unsigned_type>(~(random ^ planes_[bit]));
+    }
+    for (const rule &group : groups_) {
+      if ((words() & 0xFFFFFFFFull) < group.threshold) {
+        result |= group.bits;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief Vose's alias table for Zipf weights
+   */
+  void build_alias_table(::std::size_t entries, double exponent) {
+    ::std::vector<double> weights(entries);
+    double total = 0.0;
+    for (::std::size_t k = 0; k < entries; ++k) {
+      weights[k] = 1.0 / ::std::pow(static_cast<double>(k + 1), exponent);
+      total += weights[k];
+    }
+    ::std::vector<::std::size_t> small;
+    ::std::vector<::std::size_t> large;
+    for (::std::size_t k = 0; k < entries; ++k) {
+      weights[k] = weights[k] * static_cast<double>(entries) / total;
+      (weights[k] < 1.0 ? small : large).push_back(k);
+    }
+    alias_threshold_.assign(entries, ::deaddev::details::probability_threshold(1.0));
+    alias_index_.resize(entries);
+    for (::std::size_t k = 0; k < entries; ++k) {
+      alias_index_[k] = static_cast<::std::uint32_t>(k);
+    }
+    while (!small.empty() && !large.empty()) {
+      const ::std::size_t less = small.back();
+      const ::std::size_t more = large.back();
+      small.pop_back();
+      alias_threshold_[less] = ::deaddev::details::probability_threshold(weights[less]);
+      alias_index_[less] = static_cast<::std::uint32_t>(more);
+      weights[more] -= 1.0 - weights[less];
+      if (weights[more] < 1.0) {
+        large.pop_back();
+        small.push_back(more);
+      }
+    }
+  }
+
+  /**
+   * @brief generates one block from its own stream
+   */
+  void generate_block(bitmask_type *out, ::std::size_t count,
+                      ::std::uint64_t block) const {
+    word_source words(seed_ ^ (block * 0xD1B54A32D192ED03ull));
+    const ::std::uint64_t entries = dictionary_.size();
+    unsigned_type previous{0};
+    for (::std::size_t index = 0; index < count; ++index) {
+      unsigned_type mask;
+      if (entries != 0) {
+        const ::std::uint64_t random = words();
+        const auto entry = static_cast<::std::size_t>(((random >> 32) * entries) >> 32);
+        const bool keep = (random & 0xFFFFFFFFull) < alias_threshold_[entry];
+        mask = dictionary_[keep ? entry : alias_index_[entry]];
+      } else {
+        mask = draw(words);
+      }
+      if (index != 0 && repeat_threshold_ != 0 &&
+          (words() & 0xFFFFFFFFull) < repeat_threshold_) {
+        mask = previous;
+      }
+      previous = mask;
+      out[index] = bitmask_type(static_cast<mask_type>(mask));
+    }
+  }
+
+  ::std::uint64_t seed_;
+  ::std::vector<rule> flags_;
+  ::std::vector<rule> groups_;
+  unsigned_type always_{0};
+  unsigned_type sampled_{0};
+  unsigned_type planes_[32] = {};
+  ::std::size_t lowest_plane_{32};
+  ::std::vector<unsigned_type> dictionary_;
+  ::std::vector<::std::uint64_t> alias_threshold_;
+  ::std::vector<::std::uint32_t> alias_index_;
+  ::std::uint64_t repeat_threshold_{0};
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_BITMASK_WORKLOAD_HPP
@@ -0,0 +1,431 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Merkle digests of bitmask columns
+ * @details Every 4 KiB block of masks is hashed and the block hashes are arranged as a
+ * Merkle tree. Two replicas find the differing blocks by walking the tree one level per
+ * exchange and transfer only those blocks
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_COLUMN_DIGEST_HPP
+#define DEADDEV_COLUMN_DIGEST_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+#include <deaddev/column_file.hpp>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "deaddev/column_digest.hpp requires POSIX file descriptors"
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <unistd.h>
+
+namespace deaddev {
+
+namespace details {
+
+constexpr ::std::uint64_t digest_prime_1 = 0x9E3779B185EBCA87ull;
+constexpr ::std::uint64_t digest_prime_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr ::std::uint64_t digest_prime_3 = 0x165667B19E3779F9ull;
+
+/// final avalanche
+inline auto digest_mix(::std::uint64_t hash) noexcept -> ::std::uint64_t {
+  hash ^= hash >> 33;
+  hash *= digest_prime_2;
+  hash ^= hash >> 29;
+  hash *= digest_prime_3;
+  return hash ^ (hash >> 32);
+}
+
+/// accumulates one 64 byte stripe, 32x32->64 multiplies so the lanes vectorize
+inline void digest_stripe(::std::uint64_t (&accumulators)[8],
+                          const unsigned char *stripe) noexcept {
+  static constexpr ::std::uint64_t keys[8] = {
+      0xBE4BA423396CFEB8ull, 0x1CAD21F72C81017Cull, 0xDB979083E96DD4DEull,
+      0x1F67B3B7A4A44072ull, 0x78E5C0CC4EE679CBull, 0x2172FFCC7DD05A82ull,
+      0x8E2443F7744608B8ull, 0x4C263A81E69035E0ull};
+  ::std::uint64_t words[8];
+  ::std::memcpy(words, stripe, sizeof(words));
+  for (int lane = 0; lane < 8; ++lane) {
+    const ::std::uint64_t keyed = words[lane] ^ keys[lane];
+    accumulators[lane] += (keyed & 0xFFFFFFFFu) * (keyed >> 32) + words[lane ^ 1];
+  }
+}
+
+/// non-cryptographic 64-bit hash of a byte range
+inline auto digest_bytes(const void *data, ::std::size_t length, ::std::uint64_t seed) noexcept
+    -> ::std::uint64_t {
+  ::std::uint64_t accumulators[8];
+  for (int lane = 0; lane < 8; ++lane) {
+    accumulators[lane] = seed + digest_prime_1 * static_cast<::std::uint64_t>(lane + 1);
+  }
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  ::std::size_t offset = 0;
+  for (; offset + 64 <= length; offset += 64) {
+    digest_stripe(accumulators, bytes + offset);
+  }
+  if (offset != length) {
+    unsigned char tail[64] = {};
+    ::std::memcpy(tail, bytes + offset, length - offset);
+    digest_stripe(accumulators, tail);
+  }
+  ::std::uint64_t hash = static_cast<::std::uint64_t>(length) * digest_prime_1;
+  for (int lane = 0; lane < 8; ++lane) {
+    hash = (hash ^ digest_mix(accumulators[lane])) * digest_prime_1;
+  }
+  return digest_mix(hash);
+}
+
+/// hash of an inner node
+inline auto digest_pair(::std::uint64_t left, ::std::uint64_t right,
+                        ::std::size_t level) noexcept -> ::std::uint64_t {
+  const ::std::uint64_t children[2] = {left, right};
+  return digest_bytes(children, sizeof(children), level);
+}
+
+} // namespace details
+
+/**
+ * @brief Merkle tree over the 4 KiB blocks of a bitmask column
+ * @details level 0 holds one hash per block, every next level hashes pairs of the level
+ * below, the last level holds the root
+ * @tparam T enum type
+ */
+template <typename T> class column_digest {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// bytes per block
+  static constexpr ::std::size_t block_bytes = 4096;
+  /// masks per block
+  static constexpr ::std::size_t block_rows = block_bytes / sizeof(value_type);
+
+  column_digest() { assign(nullptr, 0); }
+  /// hashes a column
+  column_digest(const value_type *rows, ::std::size_t count) { assign(rows, count); }
+
+  /// rehashes a whole column
+  void assign(const value_type *rows, ::std::size_t count) {
+    rows_ = count;
+    const ::std::size_t blocks = count == 0 ? 1 : (count + block_rows - 1) / block_rows;
+    levels_.assign(1, ::std::vector<::std::uint64_t>(blocks));
+    for (::std::size_t block = 0; block < blocks; ++block) {
+      levels_[0][block] = hash_block(rows, block);
+    }
+    while (levels_.back().size() > 1) {
+      const ::std::size_t below = levels_.size() - 1;
+      levels_.emplace_back((levels_[below].size() + 1) / 2);
+      for (::std::size_t index = 0; index < levels_.back().size(); ++index) {
+        levels_.back()[index] = combine(below, index);
+      }
+    }
+  }
+
+  /**
+   * @brief Rehashes the blocks holding rows [first, last) and their ancestors
+   * @param rows the column, same size as when hashed
+   */
+  void update(const value_type *rows, ::std::size_t first, ::std::size_t last) {
+    if (first >= last || first >= rows_) {
+      return;
+    }
+    ::std::size_t low = first / block_rows;
+    ::std::size_t high = (::std::min(last, rows_) - 1) / block_rows;
+    for (::std::size_t block = low; block <= high; ++block) {
+      levels_[0][block] = hash_block(rows, block);
+    }
+    for (::std::size_t level = 1; level < levels_.size(); ++level) {
+      low /= 2;
+      high /= 2;
+      for (::std::size_t index = low; index <= high; ++index) {
+        levels_[level][index] = combine(level - 1, index);
+      }
+    }
+  }
+
+  /// root hash
+  DEADDEV_NODISCARD ::std::uint64_t root() const noexcept { return levels_.back()[0]; }
+  /// hashed rows
+  DEADDEV_NODISCARD ::std::size_t rows() const noexcept { return rows_; }
+  /// number of blocks, at least one
+  DEADDEV_NODISCARD ::std::size_t block_count() const noexcept { return levels_[0].size(); }
+  /// number of tree levels, the root level is levels() - 1
+  DEADDEV_NODISCARD ::std::size_t levels() const noexcept { return levels_.size(); }
+  /// number of nodes on a level
+  DEADDEV_NODISCARD ::std::size_t level_size(::std::size_t level) const noexcept {
+    return levels_[level].size();
+  }
+  /// node hash
+  DEADDEV_NODISCARD ::std::uint64_t node(::std::size_t level, ::std::size_t index) const noexcept {
+    return levels_[level][index];
+  }
+  /// masks in a block
+  DEADDEV_NODISCARD ::std::size_t block_length(::std::size_t block) const noexcept {
+    const ::std::size_t start = block * block_rows;
+    return start >= rows_ ? 0 : (rows_ - start < block_rows ? rows_ - start : block_rows);
+  }
+
+private:
+  ::std::uint64_t hash_block(const value_type *rows, ::std::size_t block) const noexcept {
+    const ::std::size_t length = block_length(block);
+    return ::deaddev::details::digest_bytes(length == 0 ? nullptr : rows + block * block_rows,
+                                            length * sizeof(value_type), block);
+  }
+
+  ::std::uint64_t combine(::std::size_t below, ::std::size_t index) const noexcept {
+    const auto &children = levels_[below];
+    const ::std::uint64_t left = children[index * 2];
+    const ::std::uint64_t right = index * 2 + 1 < children.size() ? children[index * 2 + 1] : 0;
+    return ::deaddev::details::digest_pair(left, right, below + 1);
+  }
+
+  ::std::size_t rows_ = 0;
+  ::std::vector<::std::vector<::std::uint64_t>> levels_;
+};
+
+/// outcome of pull_column_sync
+struct column_sync_result {
+  /// replica matches the source
+  bool ok = false;
+  /// request and response exchanges
+  ::std::size_t rounds = 0;
+  /// blocks transferred
+  ::std::size_t blocks = 0;
+};
+
+namespace details {
+
+/// sync protocol requests
+enum class column_sync_op : ::std::uint32_t {
+  info,
+  hashes,
+  blocks,
+  done,
+};
+
+/// sync request header, followed by count node or block indices
+struct column_sync_request {
+  column_sync_op op;
+  ::std::uint32_t level;
+  ::std::uint64_t count;
+};
+
+/// sync info response
+struct column_sync_info {
+  ::std::uint64_t rows;
+  ::std::uint64_t mask_size;
+  ::std::uint64_t root;
+};
+
+/// reads all bytes, false on error or end of stream
+inline bool read_full(int fd, void *data, ::std::size_t length) noexcept {
+  auto *bytes = static_cast<char *>(data);
+  while (length != 0) {
+    const ::ssize_t result = ::read(fd, bytes, length);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0) {
+      return false;
+    }
+    bytes += result;
+    length -= static_cast<::std::size_t>(result);
+  }
+  return true;
+}
+
+} // namespace details
+
+/**
+ * @brief Answers sync requests of a replica until it is done
+ * @param fd connected stream, pipe pair or socket, ignore SIGPIPE when using pipes
+ * @param digest digest of rows
+ * @param rows source column
+ * @return true if the replica finished, false on a transport or protocol error
+ */
+template <typename T>
+bool serve_column_sync(int fd, const column_digest<T> &digest,
+                       const ::deaddev::bitmask<T> *rows) {
+  using ::deaddev::details::column_sync_op;
+  ::deaddev::details::column_sync_request request;
+  ::std::vector<::std::uint64_t> indices;
+  ::std::vector<::std::uint64_t> hashes;
+  while (::deaddev::details::read_full(fd, &request, sizeof(request))) {
+    if (request.op == column_sync_op::done) {
+      return true;
+    }
+    if (request.op == column_sync_op::info) {
+      const ::deaddev::details::column_sync_info info{digest.rows(), sizeof(rows[0]),
+                                                      digest.root()};
+      if (!::deaddev::details::write_full(fd, &info, sizeof(info))) {
+        return false;
+      }
+      continue;
+    }
+    const ::std::size_t limit = request.op == column_sync_op::hashes
+                                    ? (request.level < digest.levels()
+                                           ? digest.level_size(request.level)
+                                           : 0)
+                                    : digest.block_count();
+    if (request.count > limit) {
+      return false;
+    }
+    indices.resize(static_cast<::std::size_t>(request.count));
+    if (!::deaddev::details::read_full(fd, indices.data(), indices.size() * sizeof(indices[0]))) {
+      return false;
+    }
+    for (const ::std::uint64_t index : indices) {
+      if (index >= limit) {
+        return false;
+      }
+    }
+    if (request.op == column_sync_op::hashes) {
+      hashes.clear();
+      for (const ::std::uint64_t index : indices) {
+        hashes.push_back(digest.node(request.level, static_cast<::std::size_t>(index)));
+      }
+      if (!::deaddev::details::write_full(fd, hashes.data(), hashes.size() * sizeof(hashes[0]))) {
+        return false;
+      }
+    } else if (request.op == column_sync_op::blocks) {
+      for (const ::std::uint64_t index : indices) {
+        const auto block = static_cast<::std::size_t>(index);
+        if (!::deaddev::details::write_full(fd, rows + block * column_digest<T>::block_rows,
+                                            digest.block_length(block) * sizeof(rows[0]))) {
+          return false;
+        }
+      }
+    } else {
+      return false;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Brings a replica up to date with the column served on the other end
+ * @details compares the trees from the root down, one exchange per level, then fetches the
+ * differing blocks and rehashes them. The replica must have the same number of rows
+ * @param fd connected stream, pipe pair or socket, ignore SIGPIPE when using pipes
+ * @param digest digest of rows, updated with the fetched blocks
+ * @param rows replica column
+ * @return column_sync_result
+ */
+template <typename T>
+column_sync_result pull_column_sync(int fd, column_digest<T> &digest,
+                                    ::deaddev::bitmask<T> *rows) {
+  using ::deaddev::details::column_sync_op;
+  column_sync_result result;
+  const auto exchange = [&](column_sync_op op, ::std::size_t level,
+                            const ::std::vector<::std::uint64_t> &indices, void *response,
+                            ::std::size_t response_bytes) {
+    const ::deaddev::details::column_sync_request request{
+        op, static_cast<::std::uint32_t>(level), indices.size()};
+    ++result.rounds;
+    return ::deaddev::details::write_full(fd, &request, sizeof(request)) &&
+           ::deaddev::details::write_full(fd, indices.data(),
+                                          indices.size() * sizeof(indices[0])) &&
+           ::deaddev::details::read_full(fd, response, response_bytes);
+  };
+  const auto finish = [&](bool ok) {
+    const ::deaddev::details::column_sync_request request{column_sync_op::done, 0, 0};
+    result.ok = ::deaddev::details::write_full(fd, &request, sizeof(request)) && ok;
+    return result;
+  };
+
+  ::std::vector<::std::uint64_t> differing;
+  ::deaddev::details::column_sync_info info;
+  if (!exchange(column_sync_op::info, 0, differing, &info, sizeof(info))) {
+    return result;
+  }
+  if (info.rows != digest.rows() || info.mask_size != sizeof(rows[0])) {
+    return finish(false);
+  }
+  if (info.root == digest.root()) {
+    return finish(true);
+  }
+
+  // both trees have the same shape, descend into the children of differing nodes
+  differing.push_back(0);
+  ::std::vector<::std::uint64_t> children;
+  ::std::vector<::std::uint64_t> hashes;
+  for (::std::size_t level = digest.levels() - 1; level-- > 0;) {
+    children.clear();
+    for (const ::std::uint64_t parent : differing) {
+      for (::std::uint64_t child = parent * 2; child < parent * 2 + 2; ++child) {
+        if (child < digest.level_size(level)) {
+          children.push_back(child);
+        }
+      }
+    }
+    hashes.resize(children.size());
+    if (!exchange(column_sync_op::hashes, level, children, hashes.data(),
+                  hashes.size() * sizeof(hashes[0]))) {
+      return result;
+    }
+    differing.clear();
+    for (::std::size_t i = 0; i < children.size(); ++i) {
+      if (hashes[i] != digest.node(level, static_cast<::std::size_t>(children[i]))) {
+        differing.push_back(children[i]);
+      }
+    }
+  }
+
+  // blocks come back in request order, each with its own length
+  const ::deaddev::details::column_sync_request request{
+      column_sync_op::blocks, 0, differing.size()};
+  ++result.rounds;
+  if (!::deaddev::details::write_full(fd, &request, sizeof(request)) ||
+      !::deaddev::details::write_full(fd, differing.data(),
+                                      differing.size() * sizeof(differing[0]))) {
+    return result;
+  }
+  for (const ::std::uint64_t index : differing) {
+    const auto block = static_cast<::std::size_t>(index);
+    const ::std::size_t first = block * column_digest<T>::block_rows;
+    const ::std::size_t length = digest.block_length(block);
+    if (!::deaddev::details::read_full(fd, rows + first, length * sizeof(rows[0]))) {
+      return result;
+    }
+    digest.update(rows, first, first + length);
+    ++result.blocks;
+  }
+  return finish(digest.root() == info.root);
+}
+
+} // namespace deaddev
+
+#endif // DEADDEV_COLUMN_DIGEST_HPP
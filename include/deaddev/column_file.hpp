@@ -0,0 +1,658 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Bitmask column files
+ * @details A 4 KiB header followed by the masks in native byte order. The bulk loader reads
+ * large aligned chunks through io_uring with O_DIRECT on Linux, validates every chunk as
+ * soon as it completes while the next reads are in flight, and falls back to `pread`
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_COLUMN_FILE_HPP
+#define DEADDEV_COLUMN_FILE_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "deaddev/column_file.hpp requires POSIX file I/O"
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace deaddev {
+
+/// column file header, padded to column_file_header::data_alignment bytes on disk
+struct column_file_header {
+  /// "DDBMCOL" and a zero byte
+  static const char *file_magic() noexcept { return "DDBMCOL"; }
+  /// format version
+  static constexpr ::std::uint32_t format_version = 1;
+  /// alignment of the mask data, allows O_DIRECT reads
+  static constexpr ::std::uint64_t data_alignment = 4096;
+
+  /// file_magic
+  char magic[8];
+  /// format_version
+  ::std::uint32_t version;
+  /// size of one mask in bytes
+  ::std::uint32_t mask_size;
+  /// number of masks
+  ::std::uint64_t rows;
+  /// offset of the first mask
+  ::std::uint64_t data_offset;
+};
+
+/// why loading a column failed
+enum class column_load_error {
+  /// loaded
+  none,
+  /// file could not be opened
+  open,
+  /// bad magic, version, mask size or file size
+  header,
+  /// a read failed
+  io,
+  /// the chunk callback rejected a chunk
+  validation,
+  /// buffer allocation failed
+  memory,
+};
+
+/// loader settings
+struct column_load_options {
+  /// bytes per read, rounded up to data_alignment
+  ::std::size_t chunk_bytes = ::std::size_t{1} << 20;
+  /// reads in flight
+  unsigned queue_depth = 16;
+  /// try io_uring before pread
+  bool use_io_uring = true;
+  /// try O_DIRECT, bypasses the page cache
+  bool use_direct_io = true;
+};
+
+template <typename T> class column_buffer;
+template <typename T> struct known_flags_validator;
+
+template <typename T, typename F = known_flags_validator<T>>
+column_buffer<T> load_column(const char *path, const column_load_options &options = {},
+                             F &&validate = F{});
+
+/**
+ * @brief Masks loaded from a column file
+ * @details storage is aligned to column_file_header::data_alignment
+ * @tparam T enum type
+ */
+template <typename T> class column_buffer {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+
+  column_buffer() = default;
+
+  /// first mask
+  DEADDEV_NODISCARD value_type *data() noexcept { return data_.get(); }
+  /// first mask
+  DEADDEV_NODISCARD const value_type *data() const noexcept { return data_.get(); }
+  /// number of masks
+  DEADDEV_NODISCARD ::std::size_t size() const noexcept { return size_; }
+  /// first mask
+  DEADDEV_NODISCARD const value_type *begin() const noexcept { return data_.get(); }
+  /// past the last mask
+  DEADDEV_NODISCARD const value_type *end() const noexcept { return data_.get() + size_; }
+  /// mask at index
+  DEADDEV_NODISCARD value_type operator[](::std::size_t index) const noexcept {
+    return data_.get()[index];
+  }
+
+  /// why the load failed, column_load_error::none if it did not
+  DEADDEV_NODISCARD column_load_error error() const noexcept { return error_; }
+  /// true if the file was loaded
+  DEADDEV_NODISCARD explicit operator bool() const noexcept {
+    return error_ == column_load_error::none;
+  }
+  /// true if io_uring did the reads
+  DEADDEV_NODISCARD bool used_io_uring() const noexcept { return used_io_uring_; }
+  /// true if the file was opened with O_DIRECT
+  DEADDEV_NODISCARD bool used_direct_io() const noexcept { return used_direct_io_; }
+
+private:
+  template <typename U, typename F>
+  friend column_buffer<U> load_column(const char *, const column_load_options &, F &&);
+
+  struct deleter {
+    void operator()(value_type *pointer) const noexcept { ::std::free(pointer); }
+  };
+
+  ::std::unique_ptr<value_type, deleter> data_;
+  ::std::size_t size_ = 0;
+  column_load_error error_ = column_load_error::none;
+  bool used_io_uring_ = false;
+  bool used_direct_io_ = false;
+};
+
+namespace details {
+
+/// closes a file descriptor
+class file_descriptor {
+public:
+  explicit file_descriptor(int fd = -1) noexcept : fd_(fd) {}
+  file_descriptor(const file_descriptor &) = delete;
+  file_descriptor &operator=(const file_descriptor &) = delete;
+  ~file_descriptor() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+  DEADDEV_NODISCARD int get() const noexcept { return fd_; }
+
+private:
+  int fd_;
+};
+
+/**
+ * @brief Writes all bytes to a file, pipe or socket
+ * @details Sockets are written with `MSG_NOSIGNAL` where available so a closed peer fails
+ * the write instead of raising SIGPIPE. Writes to a pipe still raise SIGPIPE, callers
+ * writing to pipes must ignore it
+ * @return true if every byte was written
+ */
+inline bool write_full(int fd, const void *data, ::std::size_t length) noexcept {
+  const auto *bytes = static_cast<const char *>(data);
+#if defined(MSG_NOSIGNAL)
+  bool socket = true;
+#endif
+  while (length != 0) {
+#if defined(MSG_NOSIGNAL)
+    ::ssize_t result = -1;
+    if (socket) {
+      result = ::send(fd, bytes, length, MSG_NOSIGNAL);
+      if (result < 0 && errno == ENOTSOCK) {
+        socket = false;
+        continue;
+      }
+    } else {
+      result = ::write(fd, bytes, length);
+    }
+#else
+    const ::ssize_t result = ::write(fd, bytes, length);
+#endif
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0) {
+      return false;
+    }
+    bytes += result;
+    length -= static_cast<::std::size_t>(result);
+  }
+  return true;
+}
+
+/// reads exactly length bytes unless the file ends, returns bytes read or -1
+inline auto pread_full(int fd, void *buffer, ::std::size_t length, ::std::uint64_t offset) noexcept
+    -> long long {
+  ::std::size_t done = 0;
+  while (done < length) {
+    const ::ssize_t result = ::pread(fd, static_cast<char *>(buffer) + done, length - done,
+                                     static_cast<::off_t>(offset + done));
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result < 0) {
+      return -1;
+    }
+    if (result == 0) {
+      break;
+    }
+    done += static_cast<::std::size_t>(result);
+  }
+  return static_cast<long long>(done);
+}
+
+#if defined(__linux__)
+/**
+ * @brief Minimal io_uring submission and completion rings for reads
+ * @details raw system calls, no liburing dependency
+ */
+class io_uring_reader {
+public:
+  io_uring_reader() = default;
+  io_uring_reader(const io_uring_reader &) = delete;
+  io_uring_reader &operator=(const io_uring_reader &) = delete;
+  ~io_uring_reader() {
+    if (sqes_ != nullptr) {
+      ::munmap(sqes_, sqes_size_);
+    }
+    if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+      ::munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_ != nullptr) {
+      ::munmap(sq_ring_, sq_ring_size_);
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  /// sets up rings, false if io_uring is unavailable
+  bool open(unsigned entries) noexcept {
+    ::io_uring_params params;
+    ::std::memset(&params, 0, sizeof(params));
+    fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (fd_ < 0) {
+      return false;
+    }
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+    const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) {
+      sq_ring_size_ = cq_ring_size_ = ::std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == nullptr) {
+      return false;
+    }
+    cq_ring_ = single ? sq_ring_ : map(cq_ring_size_, IORING_OFF_CQ_RING);
+    sqes_size_ = params.sq_entries * sizeof(::io_uring_sqe);
+    sqes_ = static_cast<::io_uring_sqe *>(map(sqes_size_, IORING_OFF_SQES));
+    if (cq_ring_ == nullptr || sqes_ == nullptr) {
+      return false;
+    }
+    auto *sq = static_cast<char *>(sq_ring_);
+    auto *cq = static_cast<char *>(cq_ring_);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    sq_entries_ = params.sq_entries;
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<::io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  /// number of submission entries
+  DEADDEV_NODISCARD unsigned capacity() const noexcept { return sq_entries_; }
+
+  /// queues a read, submitted by the next submit()
+  void read(int fd, void *buffer, unsigned length, ::std::uint64_t offset,
+            ::std::uint64_t user_data) noexcept {
+    const unsigned tail = *sq_tail_ + queued_;
+    const unsigned index = tail & sq_mask_;
+    ::io_uring_sqe &sqe = sqes_[index];
+    ::std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<::std::uint64_t>(buffer);
+    sqe.len = length;
+    sqe.off = offset;
+    sqe.user_data = user_data;
+    sq_array_[index] = index;
+    ++queued_;
+  }
+
+  /// submits queued reads and waits for at least one completion, false on error
+  bool submit_and_wait() noexcept {
+    __atomic_store_n(sq_tail_, *sq_tail_ + queued_, __ATOMIC_RELEASE);
+    unsubmitted_ += queued_;
+    queued_ = 0;
+    const long result = enter(unsubmitted_);
+    if (result < 0) {
+      return false;
+    }
+    unsubmitted_ -= static_cast<unsigned>(result);
+    return true;
+  }
+
+  /// waits for at least one completion without submitting, false on error
+  bool wait() noexcept { return enter(0) >= 0; }
+
+  /// queued reads the kernel has not taken, they never complete
+  DEADDEV_NODISCARD unsigned unsubmitted() const noexcept { return unsubmitted_ + queued_; }
+
+  /// calls complete(user_data, result) for every completion
+  template <typename F> void reap(F &&complete) {
+    unsigned head = *cq_head_;
+    const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+      const ::io_uring_cqe &cqe = cqes_[head & cq_mask_];
+      complete(cqe.user_data, cqe.res);
+      ++head;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+private:
+  void *map(::std::size_t size, ::off_t offset) const noexcept {
+    void *result =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+    return result == MAP_FAILED ? nullptr : result;
+  }
+
+  int fd_ = -1;
+  void *sq_ring_ = nullptr;
+  void *cq_ring_ = nullptr;
+  ::io_uring_sqe *sqes_ = nullptr;
+  ::std::size_t sq_ring_size_ = 0;
+  ::std::size_t cq_ring_size_ = 0;
+  ::std::size_t sqes_size_ = 0;
+  unsigned *sq_tail_ = nullptr;
+  unsigned *sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  unsigned *cq_head_ = nullptr;
+  unsigned *cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  ::io_uring_cqe *cqes_ = nullptr;
+  /// reads queued after the last submit
+  unsigned queued_ = 0;
+  /// reads published to the ring but not taken by the kernel
+  unsigned unsubmitted_ = 0;
+
+  long enter(unsigned submit) noexcept {
+    for (;;) {
+      const long result = ::syscall(__NR_io_uring_enter, fd_, submit, 1u,
+                                    IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (result >= 0 || errno != EINTR) {
+        return result;
+      }
+    }
+  }
+};
+#endif
+
+/**
+ * @brief Reads chunks through io_uring
+ * @return int 1 if loaded, 0 if io_uring is unavailable, -1 on read error, -2 if rejected,
+ * -3 if reads may still be in flight, the buffer must then never be freed or reused
+ */
+template <typename F>
+auto io_uring_read_chunks(int fd, unsigned char *buffer, ::std::uint64_t file_offset,
+                          ::std::uint64_t bytes, ::std::size_t chunk_bytes, unsigned depth,
+                          F &&chunk_done) -> int {
+#if defined(__linux__)
+  io_uring_reader ring;
+  if (!ring.open(::std::max(depth, 1u))) {
+    return 0;
+  }
+  depth = ring.capacity();
+  const ::std::uint64_t chunks = (bytes + chunk_bytes - 1) / chunk_bytes;
+  // the reads cover whole aligned blocks, the buffer is padded to match
+  const ::std::uint64_t padded = (bytes + column_file_header::data_alignment - 1) /
+                                 column_file_header::data_alignment *
+                                 column_file_header::data_alignment;
+  ::std::vector<::std::uint64_t> done(chunks, 0);
+  ::std::uint64_t next = 0;
+  ::std::uint64_t completed = 0;
+  unsigned in_flight = 0;
+  int status = 1;
+  const auto chunk_length = [&](::std::uint64_t chunk) {
+    return ::std::min<::std::uint64_t>(chunk_bytes, padded - chunk * chunk_bytes);
+  };
+  const auto queue = [&](::std::uint64_t chunk) {
+    const ::std::uint64_t start = chunk * chunk_bytes + done[chunk];
+    ring.read(fd, buffer + start, static_cast<unsigned>(chunk_length(chunk) - done[chunk]),
+              file_offset + start, chunk);
+    ++in_flight;
+  };
+  while (completed < chunks && status == 1) {
+    while (in_flight < depth && next < chunks) {
+      queue(next++);
+    }
+    if (!ring.submit_and_wait()) {
+      status = -1;
+      break;
+    }
+    ring.reap([&](::std::uint64_t chunk, int result) {
+      --in_flight;
+      if (status != 1) {
+        return;
+      }
+      if (result < 0) {
+        status = -1;
+        return;
+      }
+      done[chunk] += static_cast<::std::uint64_t>(result);
+      const ::std::uint64_t start = chunk * chunk_bytes;
+      const ::std::uint64_t wanted = ::std::min<::std::uint64_t>(chunk_bytes, bytes - start);
+      if (done[chunk] < wanted) {
+        if (result == 0) {
+          status = -1;
+        } else {
+          queue(chunk);
+        }
+        return;
+      }
+      ++completed;
+      if (!chunk_done(buffer + start, static_cast<::std::size_t>(wanted))) {
+        status = -2;
+      }
+    });
+  }
+  // reads still in flight target the buffer, wait for them before it can be freed
+  while (in_flight > ring.unsubmitted()) {
+    if (!ring.wait()) {
+      return -3;
+    }
+    ring.reap([&](::std::uint64_t, int) { --in_flight; });
+  }
+  return status;
+#else
+  static_cast<void>(fd);
+  static_cast<void>(buffer);
+  static_cast<void>(file_offset);
+  static_cast<void>(bytes);
+  static_cast<void>(chunk_bytes);
+  static_cast<void>(depth);
+  static_cast<void>(chunk_done);
+  return 0;
+#endif
+}
+
+} // namespace details
+
+/**
+ * @brief Rejects chunks with flags outside bitmask<T>::all_flags()
+ * @tparam T enum type
+ */
+template <typename T> struct known_flags_validator {
+  /// true if every mask only has known flags
+  bool operator()(const ::deaddev::bitmask<T> *rows, ::std::size_t count) const noexcept {
+    using mask_type = typename ::deaddev::bitmask<T>::mask_type;
+    constexpr auto unknown = static_cast<mask_type>(~static_cast<mask_type>(
+        ::deaddev::details::bitmask_all_flags_v<T>));
+    mask_type seen = 0;
+    // no early exit, the loop vectorizes
+    for (::std::size_t i = 0; i < count; ++i) {
+      seen = static_cast<mask_type>(seen | static_cast<mask_type>(rows[i]));
+    }
+    return (seen & unknown) == 0;
+  }
+};
+
+/**
+ * @brief Writes a column file
+ * @param path file path, replaced if it exists
+ * @param rows first mask
+ * @param count number of masks
+ * @return true if written
+ */
+template <typename T>
+bool write_column(const char *path, const ::deaddev::bitmask<T> *rows, ::std::size_t count) {
+  ::deaddev::details::file_descriptor file(::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644));
+  if (file.get() < 0) {
+    return false;
+  }
+  unsigned char header_block[column_file_header::data_alignment] = {};
+  column_file_header header;
+  ::std::memcpy(header.magic, column_file_header::file_magic(), sizeof(header.magic));
+  header.version = column_file_header::format_version;
+  header.mask_size = sizeof(typename ::deaddev::bitmask<T>::mask_type);
+  header.rows = count;
+  header.data_offset = column_file_header::data_alignment;
+  ::std::memcpy(header_block, &header, sizeof(header));
+  return ::deaddev::details::write_full(file.get(), header_block, sizeof(header_block)) &&
+         ::deaddev::details::write_full(file.get(), rows,
+                                        count * sizeof(::deaddev::bitmask<T>));
+}
+
+/**
+ * @brief Loads a column file
+ * @details Reads chunks in parallel through io_uring when available, otherwise with
+ * `pread`. Every chunk is passed to validate as soon as it is read, while later chunks
+ * are still being read
+ * @tparam T enum type
+ * @param path file path
+ * @param options chunk size, queue depth, io_uring and O_DIRECT use
+ * @param validate `bool(bitmask<T> *rows, size_t count)` callable, may rewrite the rows,
+ * returns false to reject the file
+ * @return column_buffer<T> masks, check error()
+ */
+template <typename T, typename F>
+column_buffer<T> load_column(const char *path, const column_load_options &options,
+                             F &&validate) {
+  using value_type = ::deaddev::bitmask<T>;
+  constexpr ::std::uint64_t alignment = column_file_header::data_alignment;
+  column_buffer<T> result;
+  int flags = O_RDONLY;
+#ifdef O_DIRECT
+  if (options.use_direct_io) {
+    flags |= O_DIRECT;
+  }
+#endif
+  ::deaddev::details::file_descriptor direct(::open(path, flags));
+  ::deaddev::details::file_descriptor buffered(direct.get() < 0 ? ::open(path, O_RDONLY) : -1);
+  const int fd = direct.get() >= 0 ? direct.get() : buffered.get();
+  if (fd < 0) {
+    result.error_ = column_load_error::open;
+    return result;
+  }
+  result.used_direct_io_ = direct.get() >= 0 && flags != O_RDONLY;
+
+  // O_DIRECT needs aligned buffers, offsets and lengths
+  column_file_header header;
+  void *memory = nullptr;
+  if (::posix_memalign(&memory, alignment, alignment) != 0) {
+    result.error_ = column_load_error::memory;
+    return result;
+  }
+  const ::std::unique_ptr<unsigned char, void (*)(void *)> header_buffer(
+      static_cast<unsigned char *>(memory), ::std::free);
+  struct ::stat status;
+  if (::fstat(fd, &status) != 0 ||
+      ::deaddev::details::pread_full(fd, header_buffer.get(), alignment, 0) <
+          static_cast<long long>(sizeof(header))) {
+    result.error_ = column_load_error::header;
+    return result;
+  }
+  ::std::memcpy(&header, header_buffer.get(), sizeof(header));
+  const auto file_size = static_cast<::std::uint64_t>(status.st_size);
+  if (::std::memcmp(header.magic, column_file_header::file_magic(), sizeof(header.magic)) != 0 ||
+      header.version != column_file_header::format_version ||
+      header.mask_size != sizeof(typename value_type::mask_type) ||
+      header.data_offset % alignment != 0 || header.data_offset < sizeof(header) ||
+      header.data_offset > file_size ||
+      header.rows > (file_size - header.data_offset) / sizeof(value_type)) {
+    result.error_ = column_load_error::header;
+    return result;
+  }
+
+  const ::std::uint64_t bytes = header.rows * sizeof(value_type);
+  const ::std::uint64_t padded = (bytes + alignment - 1) / alignment * alignment;
+  memory = nullptr;
+  if (::posix_memalign(&memory, alignment, ::std::max<::std::uint64_t>(padded, alignment)) != 0) {
+    result.error_ = column_load_error::memory;
+    return result;
+  }
+  result.data_.reset(static_cast<value_type *>(memory));
+  result.size_ = static_cast<::std::size_t>(header.rows);
+  auto *buffer = reinterpret_cast<unsigned char *>(result.data_.get());
+  const ::std::size_t chunk_bytes = static_cast<::std::size_t>(
+      (::std::max<::std::uint64_t>(options.chunk_bytes, 1) + alignment - 1) / alignment *
+      alignment);
+  const auto chunk_done = [&](unsigned char *rows, ::std::size_t length) {
+    return validate(reinterpret_cast<value_type *>(rows), length / sizeof(value_type));
+  };
+
+  int status_code = 0;
+  if (options.use_io_uring && bytes != 0) {
+    status_code = ::deaddev::details::io_uring_read_chunks(
+        fd, buffer, header.data_offset, bytes, chunk_bytes, options.queue_depth, chunk_done);
+    result.used_io_uring_ = status_code != 0;
+  }
+  if (status_code == 0) {
+    status_code = 1;
+    for (::std::uint64_t start = 0; start < bytes && status_code == 1; start += chunk_bytes) {
+      const ::std::uint64_t length = ::std::min<::std::uint64_t>(chunk_bytes, padded - start);
+      const ::std::uint64_t wanted = ::std::min<::std::uint64_t>(chunk_bytes, bytes - start);
+      const long long read = ::deaddev::details::pread_full(
+          fd, buffer + start, static_cast<::std::size_t>(length), header.data_offset + start);
+      if (read < static_cast<long long>(wanted)) {
+        status_code = -1;
+      } else if (!chunk_done(buffer + start, static_cast<::std::size_t>(wanted))) {
+        status_code = -2;
+      }
+    }
+  }
+  if (status_code == -3) {
+    // the kernel may still write to the buffer, leak it rather than free it
+    static_cast<void>(result.data_.release());
+    result.size_ = 0;
+    result.error_ = column_load_error::io;
+  } else if (status_code == -1) {
+    result.error_ = column_load_error::io;
+  } else if (status_code == -2) {
+    result.error_ = column_load_error::validation;
+  }
+  return result;
+}
+
+} // namespace deaddev
+
+#endif // DEADDEV_COLUMN_FILE_HPP
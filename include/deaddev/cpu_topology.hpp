@@ -0,0 +1,391 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief CPU sets, topology and pinned workers
+ * @details deaddev::cpu_mask is a wide bit mask of CPU numbers. deaddev::cpu_topology reads
+ * SMT sibling, package and NUMA node masks from sysfs, so placements are derived with set
+ * algebra. deaddev::pinned_worker_pool runs one worker pinned to each CPU of a mask
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_CPU_TOPOLOGY_HPP
+#define DEADDEV_CPU_TOPOLOGY_HPP
+#pragma once
+#include <deaddev/wide_bitmask.hpp>
+
+#if !defined(__linux__)
+#error "deaddev/cpu_topology.hpp requires Linux"
+#endif
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace deaddev {
+
+/// highest number of CPUs, the size of cpu_set_t
+constexpr ::std::size_t max_cpus = CPU_SETSIZE;
+
+/// set of CPU numbers
+using cpu_mask = ::deaddev::wide_bitmask<max_cpus>;
+
+/**
+ * @brief Parses a kernel CPU list
+ * @param text list like "0-3,8,10-11", surrounding whitespace is ignored
+ * @param cpus parsed CPUs, unchanged on failure
+ * @return true if parsed
+ */
+inline bool parse_cpu_list(const char *text, cpu_mask &cpus) noexcept {
+  cpu_mask result;
+  const auto is_space = [](char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r'; };
+  const auto number = [](const char *&position, ::std::size_t &value) {
+    if (*position < '0' || *position > '9') {
+      return false;
+    }
+    value = 0;
+    while (*position >= '0' && *position <= '9' && value < max_cpus) {
+      value = value * 10 + static_cast<::std::size_t>(*position++ - '0');
+    }
+    return value < max_cpus;
+  };
+  while (is_space(*text)) {
+    ++text;
+  }
+  while (*text != '\0' && !is_space(*text)) {
+    ::std::size_t first = 0;
+    ::std::size_t last = 0;
+    if (!number(text, first)) {
+      return false;
+    }
+    last = first;
+    if (*text == '-' && (!number(++text, last) || last < first)) {
+      return false;
+    }
+    for (::std::size_t cpu = first; cpu <= last; ++cpu) {
+      result.set(cpu);
+    }
+    if (*text == ',') {
+      ++text;
+    } else if (*text != '\0' && !is_space(*text)) {
+      return false;
+    }
+  }
+  cpus = result;
+  return true;
+}
+
+namespace details {
+
+/// reads a sysfs CPU list file
+inline bool read_cpu_list(const ::std::string &path, cpu_mask &cpus) {
+  ::std::unique_ptr<::std::FILE, int (*)(::std::FILE *)> file(::std::fopen(path.c_str(), "r"),
+                                                              ::std::fclose);
+  if (!file) {
+    return false;
+  }
+  char text[8192];
+  const ::std::size_t read = ::std::fread(text, 1, sizeof(text) - 1, file.get());
+  text[read] = '\0';
+  return parse_cpu_list(text, cpus);
+}
+
+} // namespace details
+
+/**
+ * @brief Pins the calling thread
+ * @param cpus allowed CPUs
+ * @return true if the affinity was set
+ */
+inline bool pin_current_thread(const cpu_mask &cpus) noexcept {
+  ::cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const ::std::size_t cpu : cpus) {
+    CPU_SET(cpu, &set);
+  }
+  return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+}
+
+/// CPUs the calling thread may run on
+inline cpu_mask current_affinity() noexcept {
+  cpu_mask result;
+  ::cpu_set_t set;
+  CPU_ZERO(&set);
+  if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (::std::size_t cpu = 0; cpu < max_cpus; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        result.set(cpu);
+      }
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief CPU topology read from sysfs
+ * @details CPUs without topology files are their own core, package and have no node
+ */
+class cpu_topology {
+public:
+  /// returned by node_of when the node is unknown
+  static constexpr ::std::size_t npos = ~::std::size_t{0};
+
+  /**
+   * @brief Reads the topology
+   * @param cpu_root directory with `online` and `cpuN/topology`
+   * @param node_root directory with `online` and `nodeN/cpulist`, node numbers may have gaps
+   * @return cpu_topology check ok()
+   */
+  static cpu_topology load(const ::std::string &cpu_root = "/sys/devices/system/cpu",
+                           const ::std::string &node_root = "/sys/devices/system/node") {
+    cpu_topology result;
+    if (!::deaddev::details::read_cpu_list(cpu_root + "/online", result.online_)) {
+      return result;
+    }
+    result.ok_ = true;
+    const ::std::size_t last = result.online_.find_last();
+    const ::std::size_t count = last == cpu_mask::npos ? 0 : last + 1;
+    result.siblings_.resize(count);
+    result.packages_.resize(count);
+    for (const ::std::size_t cpu : result.online_) {
+      const ::std::string topology = cpu_root + "/cpu" + ::std::to_string(cpu) + "/topology/";
+      if (!::deaddev::details::read_cpu_list(topology + "thread_siblings_list",
+                                             result.siblings_[cpu])) {
+        result.siblings_[cpu] = cpu_mask{cpu};
+      }
+      if (!::deaddev::details::read_cpu_list(topology + "package_cpus_list",
+                                             result.packages_[cpu]) &&
+          !::deaddev::details::read_cpu_list(topology + "core_siblings_list",
+                                             result.packages_[cpu])) {
+        result.packages_[cpu] = cpu_mask{cpu};
+      }
+    }
+    cpu_mask listed;
+    if (::deaddev::details::read_cpu_list(node_root + "/online", listed)) {
+      const ::std::size_t last_node = listed.find_last();
+      result.nodes_.resize(last_node == cpu_mask::npos ? 0 : last_node + 1);
+      for (const ::std::size_t id : listed) {
+        if (::deaddev::details::read_cpu_list(
+                node_root + "/node" + ::std::to_string(id) + "/cpulist", result.nodes_[id])) {
+          result.node_ids_.set(id);
+        }
+      }
+      return result;
+    }
+    // without a node list, nodes are numbered from 0 without gaps
+    cpu_mask node;
+    while (result.nodes_.size() < max_cpus &&
+           ::deaddev::details::read_cpu_list(
+               node_root + "/node" + ::std::to_string(result.nodes_.size()) + "/cpulist", node)) {
+      result.node_ids_.set(result.nodes_.size());
+      result.nodes_.push_back(node);
+    }
+    return result;
+  }
+
+  /// true if the online CPUs were read
+  DEADDEV_NODISCARD bool ok() const noexcept { return ok_; }
+  /// online CPUs
+  DEADDEV_NODISCARD const cpu_mask &online() const noexcept { return online_; }
+
+  /// cpu and its SMT siblings
+  DEADDEV_NODISCARD cpu_mask core(::std::size_t cpu) const {
+    return cpu < siblings_.size() && siblings_[cpu].any() ? siblings_[cpu] : cpu_mask{cpu};
+  }
+  /// CPUs in the same physical package as cpu
+  DEADDEV_NODISCARD cpu_mask package(::std::size_t cpu) const {
+    return cpu < packages_.size() && packages_[cpu].any() ? packages_[cpu] : cpu_mask{cpu};
+  }
+
+  /// number of NUMA nodes, 0 if unknown
+  DEADDEV_NODISCARD ::std::size_t node_count() const noexcept { return node_ids_.count(); }
+  /// numbers of the NUMA nodes, they may have gaps
+  DEADDEV_NODISCARD const cpu_mask &node_ids() const noexcept { return node_ids_; }
+  /// CPUs of the NUMA node with number id, empty if there is no such node
+  DEADDEV_NODISCARD cpu_mask node(::std::size_t id) const {
+    return id < nodes_.size() ? nodes_[id] : cpu_mask{};
+  }
+  /// number of the NUMA node of cpu or npos
+  DEADDEV_NODISCARD ::std::size_t node_of(::std::size_t cpu) const noexcept {
+    for (const ::std::size_t id : node_ids_) {
+      if (nodes_[id].is_set(cpu)) {
+        return id;
+      }
+    }
+    return npos;
+  }
+
+  /**
+   * @brief One CPU per physical core
+   * @param cpus candidate CPUs
+   * @return cpu_mask lowest CPU of each core that has one in cpus
+   */
+  DEADDEV_NODISCARD cpu_mask one_per_core(const cpu_mask &cpus) const {
+    cpu_mask result;
+    cpu_mask covered;
+    for (const ::std::size_t cpu : cpus) {
+      if (!covered.is_set(cpu)) {
+        result.set(cpu);
+        covered |= core(cpu);
+      }
+    }
+    return result;
+  }
+
+private:
+  bool ok_ = false;
+  cpu_mask online_;
+  /// SMT siblings by CPU
+  ::std::vector<cpu_mask> siblings_;
+  /// package CPUs by CPU
+  ::std::vector<cpu_mask> packages_;
+  /// numbers of the NUMA nodes
+  cpu_mask node_ids_;
+  /// CPUs by NUMA node number, empty for gaps
+  ::std::vector<cpu_mask> nodes_;
+};
+
+/**
+ * @brief Fork-join pool with one worker pinned to each CPU of a mask
+ * @details Workers keep their CPU for their lifetime, so data a worker touches stays in
+ * the caches and on the NUMA node of that CPU across runs. Usable with aggregate_on
+ */
+class pinned_worker_pool {
+public:
+  /**
+   * @brief Starts the workers
+   * @param cpus one worker per CPU, an empty mask starts one unpinned worker
+   */
+  explicit pinned_worker_pool(const cpu_mask &cpus) {
+    for (const ::std::size_t cpu : cpus) {
+      cpus_.push_back(cpu);
+    }
+    count_ = cpus_.empty() ? 1 : cpus_.size();
+    threads_.reserve(count_);
+    for (::std::size_t index = 0; index < count_; ++index) {
+      threads_.emplace_back([this, index] { work(index); });
+    }
+    // workers report their pinning before the first run
+    ::std::unique_lock<::std::mutex> guard(lock_);
+    done_.wait(guard, [&] { return started_ == count_; });
+  }
+  pinned_worker_pool(const pinned_worker_pool &) = delete;
+  pinned_worker_pool &operator=(const pinned_worker_pool &) = delete;
+  ~pinned_worker_pool() {
+    {
+      ::std::lock_guard<::std::mutex> guard(lock_);
+      stop_ = true;
+    }
+    ready_.notify_all();
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+  }
+
+  /// number of workers
+  DEADDEV_NODISCARD ::std::size_t size() const noexcept { return count_; }
+  /// CPU of a worker, max_cpus for an unpinned worker
+  DEADDEV_NODISCARD ::std::size_t cpu(::std::size_t index) const noexcept {
+    return index < cpus_.size() ? cpus_[index] : max_cpus;
+  }
+  /// true if every worker was pinned
+  DEADDEV_NODISCARD bool pinned() const noexcept {
+    return !cpus_.empty() && pinned_ == cpus_.size();
+  }
+
+  /**
+   * @brief Calls function(index) on every worker and waits for all of them
+   * @param function `void(::std::size_t worker_index)` callable
+   */
+  template <typename F> void run(F &&function) {
+    using function_type = typename ::std::remove_reference<F>::type;
+    ::std::unique_lock<::std::mutex> guard(lock_);
+    task_ = [](void *context, ::std::size_t index) {
+      (*static_cast<function_type *>(context))(index);
+    };
+    context_ = const_cast<void *>(static_cast<const void *>(::std::addressof(function)));
+    finished_ = 0;
+    ++generation_;
+    ready_.notify_all();
+    done_.wait(guard, [&] { return finished_ == count_; });
+  }
+
+private:
+  void work(::std::size_t index) {
+    const bool pinned = index < cpus_.size() && pin_current_thread(cpu_mask{cpus_[index]});
+    ::std::uint64_t seen = 0;
+    ::std::unique_lock<::std::mutex> guard(lock_);
+    pinned_ += pinned ? 1 : 0;
+    ++started_;
+    done_.notify_all();
+    for (;;) {
+      ready_.wait(guard, [&] { return stop_ || generation_ != seen; });
+      if (stop_) {
+        return;
+      }
+      seen = generation_;
+      void (*task)(void *, ::std::size_t) = task_;
+      void *context = context_;
+      guard.unlock();
+      task(context, index);
+      guard.lock();
+      if (++finished_ == count_) {
+        done_.notify_all();
+      }
+    }
+  }
+
+  ::std::vector<::std::size_t> cpus_;
+  ::std::size_t count_ = 0;
+  ::std::vector<::std::thread> threads_;
+  ::std::mutex lock_;
+  ::std::condition_variable ready_;
+  ::std::condition_variable done_;
+  void (*task_)(void *, ::std::size_t) = nullptr;
+  void *context_ = nullptr;
+  ::std::uint64_t generation_ = 0;
+  ::std::size_t finished_ = 0;
+  ::std::size_t started_ = 0;
+  ::std::size_t pinned_ = 0;
+  bool stop_ = false;
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_CPU_TOPOLOGY_HPP
@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Coalescing event mailbox
+ * @details Producers set event flags in an atomic mask, the consumer takes every pending
+ * event with one exchange. Repeated events of the same kind coalesce into one flag
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_EVENT_MAILBOX_HPP
+#define DEADDEV_EVENT_MAILBOX_HPP
+#pragma once
+#include <deaddev/atomic_bitmask.hpp>
+#include <deaddev/bit.hpp>
+#include <deaddev/bitmask.hpp>
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace deaddev {
+namespace details {
+
+/// latest payload per flag
+template <typename Payload, ::std::size_t Count> struct mailbox_payloads {
+  static_assert(::std::is_trivially_copyable<Payload>::value,
+                "mailbox payloads must be trivially copyable");
+  ::std::atomic<Payload> slots[Count];
+};
+
+/// no payloads
+template <::std::size_t Count> struct mailbox_payloads<void, Count> {};
+
+} // namespace details
+
+/**
+ * @brief Mailbox of event flags for one consumer thread
+ * @details post() is one `fetch_or` and wakes the consumer only when the mailbox goes from
+ * empty to non-empty. The consumer sleeps on a futex only while the mask is empty.
+ *
+ * With a payload type every flag has a slot with the latest posted payload. A payload is
+ * stored before its flag is set, so the payload read after drain() is the one of the
+ * drained event or a newer one whose flag is pending again.
+ * @tparam T enum type
+ * @tparam Payload trivially copyable payload type or void
+ */
+template <typename T, typename Payload = void> class event_mailbox {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// enum type
+  using enum_type = T;
+  /// payload type
+  using payload_type = Payload;
+  /// number of flags
+  static constexpr ::std::size_t flag_count =
+      sizeof(typename value_type::mask_type) * CHAR_BIT;
+
+  event_mailbox() = default;
+  event_mailbox(const event_mailbox &) = delete;
+  event_mailbox &operator=(const event_mailbox &) = delete;
+
+  /**
+   * @brief Posts events
+   * @param events flags to set
+   * @return true if the mailbox was empty
+   */
+  bool post(value_type events) noexcept {
+    const bool was_empty = pending_.fetch_or(events, ::std::memory_order_seq_cst) == 0;
+    if (was_empty) {
+      parking_.wake();
+    }
+    return was_empty;
+  }
+
+  /**
+   * @brief Posts event with payload
+   * @details replaces the payload of a pending event of the same kind
+   * @param event single flag
+   * @param payload payload
+   * @return true if the mailbox was empty
+   */
+  template <typename P = Payload, typename = ::std::enable_if_t<!::std::is_void<P>::value>>
+  bool post(enum_type event, const P &payload) noexcept {
+    payloads_.slots[::deaddev::details::flag_index(event)].store(payload,
+                                                                 ::std::memory_order_relaxed);
+    return post(value_type{event});
+  }
+
+  /**
+   * @brief Takes pending events without blocking
+   * @return value_type pending events, empty if there are none
+   */
+  value_type try_drain() noexcept {
+    if (pending_.load(::std::memory_order_relaxed) == 0) {
+      return value_type{};
+    }
+    return pending_.exchange(value_type{}, ::std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Takes pending events, sleeps while there are none
+   * @return value_type pending events, never empty
+   */
+  value_type drain() {
+    for (;;) {
+      const value_type events = try_drain();
+      if (events != 0) {
+        return events;
+      }
+      parking_.wait([this] { return pending_.load(::std::memory_order_seq_cst) != 0; });
+    }
+  }
+
+  /**
+   * @brief Latest payload of event
+   * @param event single flag
+   * @return payload_type payload
+   */
+  template <typename P = Payload, typename = ::std::enable_if_t<!::std::is_void<P>::value>>
+  DEADDEV_NODISCARD P payload(enum_type event) const noexcept {
+    return payloads_.slots[::deaddev::details::flag_index(event)].load(
+        ::std::memory_order_relaxed);
+  }
+
+  /// pending events without taking them
+  DEADDEV_NODISCARD value_type pending() const noexcept {
+    return pending_.load(::std::memory_order_acquire);
+  }
+
+private:
+  ::deaddev::atomic_bitmask<T> pending_;
+  ::deaddev::details::parking_word parking_;
+  ::deaddev::details::mailbox_payloads<Payload, flag_count> payloads_{};
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_EVENT_MAILBOX_HPP
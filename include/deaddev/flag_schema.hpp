@@ -0,0 +1,345 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Flags defined at run time
+ * @details deaddev::flag_schema assigns bit positions to names loaded from configuration.
+ * Masks are plain deaddev::bitmask values, so the bulk algorithms and operators run exactly
+ * as fast as with a compile-time enum. Frozen schemas look names up with a perfect hash
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_FLAG_SCHEMA_HPP
+#define DEADDEV_FLAG_SCHEMA_HPP
+#pragma once
+#include <deaddev/bit.hpp>
+#include <deaddev/bitmask.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace deaddev {
+
+/// flags whose bit positions come from a flag_schema, every bit is allowed
+enum class runtime_flag : ::std::uint64_t {};
+DEADDEV_ENABLE_BITMASK(runtime_flag, static_cast<runtime_flag>(~::std::uint64_t{0}));
+
+namespace details {
+
+/// FNV-1a, the perfect hash reseeds its output
+inline auto schema_hash(const char *name, ::std::size_t size) noexcept -> ::std::uint64_t {
+  ::std::uint64_t hash = 0xCBF29CE484222325ull;
+  for (::std::size_t i = 0; i < size; ++i) {
+    hash = (hash ^ static_cast<unsigned char>(name[i])) * 0x100000001B3ull;
+  }
+  return hash;
+}
+
+/// slot of a hash under a bucket seed
+inline auto schema_slot(::std::uint64_t hash, ::std::uint32_t seed, ::std::size_t mask) noexcept
+    -> ::std::size_t {
+  hash += (seed + 1) * 0x9E3779B97F4A7C15ull;
+  hash = (hash ^ (hash >> 31)) * 0xBF58476D1CE4E5B9ull;
+  return static_cast<::std::size_t>((hash ^ (hash >> 29)) & mask);
+}
+
+} // namespace details
+
+/**
+ * @brief Run-time registry of flag names
+ * @details add() names while loading, then freeze() to build the lookup table. Use a
+ * separate registered enum per schema to keep their masks apart at compile time
+ * @tparam T registered enum type, its width limits the number of flags
+ */
+template <typename T = runtime_flag> class flag_schema {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// underlying mask type
+  using mask_type = typename value_type::mask_type;
+  /// maximum number of flags
+  static constexpr ::std::size_t capacity = sizeof(mask_type) * CHAR_BIT;
+  /// returned when there's no such flag
+  static constexpr ::std::size_t npos = ~::std::size_t{0};
+
+  /**
+   * @brief Registers a flag on the next free bit
+   * @param name flag name, not empty, without '|' and whitespace
+   * @return ::std::size_t bit position or npos if frozen, full, invalid or a duplicate
+   */
+  ::std::size_t add(const ::std::string &name) {
+    if (frozen_ || names_.size() == capacity || name.empty() || find(name) != npos ||
+        name.find_first_of("| \t\r\n") != ::std::string::npos) {
+      return npos;
+    }
+    names_.push_back(name);
+    return names_.size() - 1;
+  }
+
+  /**
+   * @brief Builds the perfect hash, no flags can be added afterwards
+   * @return true if built, false if two names have the same 64-bit hash
+   */
+  bool freeze() {
+    if (frozen_) {
+      return true;
+    }
+    const ::std::size_t count = names_.size();
+    ::std::size_t size = 2;
+    while (size < count * 2) {
+      size *= 2;
+    }
+    slots_.assign(size, ::std::uint8_t{empty_slot});
+    seeds_.assign(count / 2 + 1, 0);
+    hashes_.resize(count);
+    ::std::vector<::std::vector<::std::uint8_t>> buckets(seeds_.size());
+    for (::std::size_t bit = 0; bit < count; ++bit) {
+      hashes_[bit] = ::deaddev::details::schema_hash(names_[bit].data(), names_[bit].size());
+      buckets[bucket(hashes_[bit])].push_back(static_cast<::std::uint8_t>(bit));
+    }
+    ::std::vector<::std::size_t> order(buckets.size());
+    for (::std::size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    ::std::sort(order.begin(), order.end(), [&](::std::size_t left, ::std::size_t right) {
+      return buckets[left].size() > buckets[right].size();
+    });
+    // largest buckets first, each searches a seed that puts all its names on free slots
+    ::std::vector<::std::size_t> taken;
+    for (const ::std::size_t index : order) {
+      const auto &keys = buckets[index];
+      ::std::uint32_t seed = 0;
+      for (;; ++seed) {
+        if (seed == (1u << 20)) {
+          slots_.clear();
+          return false;
+        }
+        taken.clear();
+        for (const ::std::uint8_t bit : keys) {
+          const ::std::size_t slot = ::deaddev::details::schema_slot(hashes_[bit], seed, size - 1);
+          if (slots_[slot] != empty_slot ||
+              ::std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+            break;
+          }
+          taken.push_back(slot);
+        }
+        if (taken.size() == keys.size()) {
+          break;
+        }
+      }
+      seeds_[index] = seed;
+      for (::std::size_t i = 0; i < keys.size(); ++i) {
+        slots_[taken[i]] = keys[i];
+      }
+    }
+    frozen_ = true;
+    return true;
+  }
+
+  /// true after freeze()
+  DEADDEV_NODISCARD bool frozen() const noexcept { return frozen_; }
+  /// number of flags
+  DEADDEV_NODISCARD ::std::size_t size() const noexcept { return names_.size(); }
+  /// all registered flags
+  DEADDEV_NODISCARD value_type all_flags() const noexcept {
+    return value_type(static_cast<mask_type>(::deaddev::details::low_bits(
+        static_cast<unsigned>(names_.size()))));
+  }
+
+  /**
+   * @brief bit position of a name
+   * @param name flag name
+   * @param size name length
+   * @return ::std::size_t bit position or npos
+   */
+  DEADDEV_NODISCARD ::std::size_t find(const char *name, ::std::size_t size) const noexcept {
+    if (!frozen_) {
+      for (::std::size_t bit = 0; bit < names_.size(); ++bit) {
+        if (matches(bit, name, size)) {
+          return bit;
+        }
+      }
+      return npos;
+    }
+    const ::std::uint64_t hash = ::deaddev::details::schema_hash(name, size);
+    const ::std::uint8_t bit = slots_[::deaddev::details::schema_slot(
+        hash, seeds_[bucket(hash)], slots_.size() - 1)];
+    return bit != empty_slot && hashes_[bit] == hash && matches(bit, name, size) ? bit : npos;
+  }
+  /// bit position of a name or npos
+  DEADDEV_NODISCARD ::std::size_t find(const ::std::string &name) const noexcept {
+    return find(name.data(), name.size());
+  }
+
+  /**
+   * @brief flag by name
+   * @param name flag name
+   * @return T single flag or no flags if the name is unknown
+   */
+  DEADDEV_NODISCARD T flag(const ::std::string &name) const noexcept {
+    const ::std::size_t bit = find(name);
+    return static_cast<T>(bit == npos ? mask_type{0} : static_cast<mask_type>(mask_type{1} << bit));
+  }
+
+  /**
+   * @brief flag name
+   * @param bit bit position, less than size()
+   * @return const ::std::string& name
+   */
+  DEADDEV_NODISCARD const ::std::string &name(::std::size_t bit) const noexcept {
+    return names_[bit];
+  }
+
+  /**
+   * @brief Formats a mask as names joined with '|'
+   * @details bits without a name are appended as one hexadecimal value
+   * @param mask mask
+   * @return ::std::string e.g. "read|write|0x100", empty for no flags
+   */
+  DEADDEV_NODISCARD ::std::string format(value_type mask) const {
+    ::std::string result;
+    auto bits = static_cast<::std::uint64_t>(static_cast<mask_type>(mask));
+    for (::std::uint64_t rest = bits & static_cast<mask_type>(all_flags()); rest != 0;
+         rest &= rest - 1) {
+      if (!result.empty()) {
+        result += '|';
+      }
+      result += names_[static_cast<::std::size_t>(::deaddev::details::countr_zero(rest))];
+    }
+    bits &= ~static_cast<::std::uint64_t>(static_cast<mask_type>(all_flags()));
+    if (bits != 0) {
+      static const char digits[] = "0123456789abcdef";
+      char hex[19] = {'0', 'x'};
+      ::std::size_t length = 2;
+      for (int shift = 60 - ::deaddev::details::countl_zero(bits) / 4 * 4; shift >= 0; shift -= 4) {
+        hex[length++] = digits[(bits >> shift) & 0xF];
+      }
+      if (!result.empty()) {
+        result += '|';
+      }
+      result.append(hex, length);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Parses names joined with '|', spaces around names are ignored
+   * @details accepts the hexadecimal values written by format()
+   * @param text text
+   * @param size text length
+   * @param mask parsed mask, unchanged on failure
+   * @return true if every name is known
+   */
+  bool parse(const char *text, ::std::size_t size, value_type &mask) const noexcept {
+    mask_type result = 0;
+    ::std::size_t position = 0;
+    while (position < size) {
+      ::std::size_t end = position;
+      while (end < size && text[end] != '|') {
+        ++end;
+      }
+      ::std::size_t first = position;
+      ::std::size_t last = end;
+      while (first < last && is_space(text[first])) {
+        ++first;
+      }
+      while (last > first && is_space(text[last - 1])) {
+        --last;
+      }
+      const ::std::size_t bit = find(text + first, last - first);
+      if (bit != npos) {
+        result = static_cast<mask_type>(result | (mask_type{1} << bit));
+      } else if (!parse_hex(text + first, last - first, result)) {
+        return false;
+      }
+      position = end + 1;
+    }
+    mask = value_type(result);
+    return true;
+  }
+  /// parses names joined with '|'
+  bool parse(const ::std::string &text, value_type &mask) const noexcept {
+    return parse(text.data(), text.size(), mask);
+  }
+
+private:
+  static constexpr ::std::uint8_t empty_slot = 0xFF;
+
+  ::std::size_t bucket(::std::uint64_t hash) const noexcept {
+    return static_cast<::std::size_t>((hash >> 32) % seeds_.size());
+  }
+
+  bool matches(::std::size_t bit, const char *name, ::std::size_t size) const noexcept {
+    return names_[bit].size() == size && ::std::memcmp(names_[bit].data(), name, size) == 0;
+  }
+
+  static bool is_space(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
+  static bool parse_hex(const char *text, ::std::size_t size, mask_type &result) noexcept {
+    if (size < 3 || size > 2 + sizeof(mask_type) * 2 || text[0] != '0' ||
+        (text[1] != 'x' && text[1] != 'X')) {
+      return false;
+    }
+    mask_type value = 0;
+    for (::std::size_t i = 2; i < size; ++i) {
+      const char c = text[i];
+      const int digit = c >= '0' && c <= '9'   ? c - '0'
+                        : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                        : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                                               : -1;
+      if (digit < 0) {
+        return false;
+      }
+      value = static_cast<mask_type>((value << 4) | static_cast<mask_type>(digit));
+    }
+    result = static_cast<mask_type>(result | value);
+    return true;
+  }
+
+  /// names by bit position
+  ::std::vector<::std::string> names_;
+  /// name hashes by bit position
+  ::std::vector<::std::uint64_t> hashes_;
+  /// per-bucket seeds
+  ::std::vector<::std::uint32_t> seeds_;
+  /// bit position per slot or empty_slot
+  ::std::vector<::std::uint8_t> slots_;
+  bool frozen_ = false;
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_FLAG_SCHEMA_HPP
@@ -0,0 +1,658 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Sparse or dense wide bit masks
+ * @details deaddev::hybrid_bitmask keeps a few set bits as a sorted inline index array and
+ * switches to heap-allocated words when it holds more than the inline capacity
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_HYBRID_BITMASK_HPP
+#define DEADDEV_HYBRID_BITMASK_HPP
+#pragma once
+#include <deaddev/bit.hpp>
+#include <deaddev/wide_bitmask.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace deaddev {
+
+/**
+ * @brief Wide bit mask with a sparse and a dense representation
+ * @details Up to InlineCapacity set bits are stored as sorted indices inside the object,
+ * more bits are stored in word_count heap words. Every value has one representation, sparse
+ * exactly when count() <= InlineCapacity. Set operations merge two sparse masks, probe the
+ * dense words with the indices of a sparse mask and run word loops over two dense masks
+ * @tparam Bits number of bits
+ * @tparam Index index type, integer or enum with bit positions as values
+ * @tparam InlineCapacity set bits stored inline
+ */
+template <::std::size_t Bits, typename Index = ::std::size_t, ::std::size_t InlineCapacity = 8>
+class hybrid_bitmask {
+  static_assert(Bits > 0, "hybrid_bitmask must have at least one bit");
+  static_assert(InlineCapacity > 0 && InlineCapacity < Bits,
+                "hybrid_bitmask inline capacity must be in [1, Bits)");
+
+public:
+  /// dense storage word
+  using word_type = ::std::uint64_t;
+  /// index type
+  using index_type = Index;
+  /// dense equivalent
+  using wide_type = ::deaddev::wide_bitmask<Bits, Index>;
+  /// number of bits
+  static constexpr ::std::size_t bits = Bits;
+  /// bits per word
+  static constexpr ::std::size_t word_bits = 64;
+  /// number of dense words
+  static constexpr ::std::size_t word_count = (Bits + word_bits - 1) / word_bits;
+  /// set bits stored inline
+  static constexpr ::std::size_t inline_capacity = InlineCapacity;
+  /// returned by find functions when there's no set bit
+  static constexpr ::std::size_t npos = Bits;
+
+  /// forward iterator over set bits
+  class iterator {
+  public:
+    /// iterator category
+    using iterator_category = ::std::forward_iterator_tag;
+    /// bit index
+    using value_type = Index;
+    /// difference type
+    using difference_type = ::std::ptrdiff_t;
+    /// not addressable
+    using pointer = void;
+    /// returned by value
+    using reference = Index;
+
+    /// end iterator
+    iterator() noexcept = default;
+
+    /// current bit index
+    DEADDEV_NODISCARD Index operator*() const noexcept { return static_cast<Index>(position_); }
+    /// next set bit
+    iterator &operator++() noexcept {
+      position_ = mask_->find_next(position_ + 1);
+      return *this;
+    }
+    /// next set bit
+    iterator operator++(int) noexcept {
+      iterator result = *this;
+      ++*this;
+      return result;
+    }
+    /// comparison operator
+    DEADDEV_NODISCARD friend bool operator==(const iterator &left,
+                                             const iterator &right) noexcept {
+      return left.position_ == right.position_;
+    }
+    /// comparison operator
+    DEADDEV_NODISCARD friend bool operator!=(const iterator &left,
+                                             const iterator &right) noexcept {
+      return left.position_ != right.position_;
+    }
+
+  private:
+    friend hybrid_bitmask;
+    iterator(const hybrid_bitmask *mask, ::std::size_t position) noexcept
+        : mask_(mask), position_(position) {}
+
+    const hybrid_bitmask *mask_{};
+    ::std::size_t position_{npos};
+  };
+
+  /// empty mask
+  hybrid_bitmask() noexcept = default;
+
+  /**
+   * @brief mask from bit list
+   * @param indices set bits
+   */
+  hybrid_bitmask(::std::initializer_list<Index> indices) {
+    for (const Index index : indices) {
+      set(index);
+    }
+  }
+
+  /**
+   * @brief mask from a dense mask
+   * @param mask dense mask
+   */
+  explicit hybrid_bitmask(const wide_type &mask) {
+    const ::std::size_t count = mask.count();
+    if (count <= InlineCapacity) {
+      for (const Index index : mask) {
+        storage_.sparse[count_++] = static_cast<small_index>(index);
+      }
+      return;
+    }
+    word_type *words = allocate();
+    ::std::memcpy(words, mask.data(), sizeof(word_type) * word_count);
+    storage_.dense = words;
+    count_ = count;
+  }
+
+  /// copy constructor
+  hybrid_bitmask(const hybrid_bitmask &other) : count_(other.count_), storage_(other.storage_) {
+    if (other.dense()) {
+      storage_.dense = allocate();
+      ::std::memcpy(storage_.dense, other.storage_.dense, sizeof(word_type) * word_count);
+    }
+  }
+  /// move constructor, leaves other empty
+  hybrid_bitmask(hybrid_bitmask &&other) noexcept
+      : count_(other.count_), storage_(other.storage_) {
+    other.count_ = 0;
+  }
+  /// copy assignment operator
+  hybrid_bitmask &operator=(const hybrid_bitmask &other) {
+    if (this != &other) {
+      hybrid_bitmask copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  /// move assignment operator, leaves other empty
+  hybrid_bitmask &operator=(hybrid_bitmask &&other) noexcept {
+    hybrid_bitmask moved(::std::move(other));
+    swap(moved);
+    return *this;
+  }
+  ~hybrid_bitmask() { release(); }
+
+  /// swaps two masks
+  void swap(hybrid_bitmask &other) noexcept {
+    ::std::swap(count_, other.count_);
+    ::std::swap(storage_, other.storage_);
+  }
+
+  /// true if the set bits are stored inline
+  DEADDEV_NODISCARD bool is_sparse() const noexcept { return !dense(); }
+
+  /**
+   * @brief Checks if bit is set
+   * @param index bit index
+   * @return true bit is set
+   */
+  DEADDEV_NODISCARD bool is_set(Index index) const noexcept {
+    const auto position = static_cast<::std::size_t>(index);
+    if (dense()) {
+      return test(storage_.dense, position);
+    }
+    const ::std::size_t slot = lower_bound(position);
+    return slot != count_ && storage_.sparse[slot] == position;
+  }
+
+  /**
+   * @brief Checks if all bits of other are set
+   * @param other mask
+   * @return true all bits of other are set
+   */
+  DEADDEV_NODISCARD bool is_set(const hybrid_bitmask &other) const noexcept {
+    if (other.count_ > count_) {
+      return false;
+    }
+    if (other.dense()) {
+      // both dense, other has more bits than the inline capacity
+      for (::std::size_t i = 0; i < word_count; ++i) {
+        if ((storage_.dense[i] & other.storage_.dense[i]) != other.storage_.dense[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+    for (::std::size_t i = 0; i < other.count_; ++i) {
+      if (!is_set(static_cast<Index>(other.storage_.sparse[i]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Checks if any bit of other is set
+   * @param other mask
+   * @return true masks intersect
+   */
+  DEADDEV_NODISCARD bool intersects(const hybrid_bitmask &other) const noexcept {
+    if (dense() && other.dense()) {
+      word_type result = 0;
+      for (::std::size_t i = 0; i < word_count; ++i) {
+        result |= storage_.dense[i] & other.storage_.dense[i];
+      }
+      return result != 0;
+    }
+    const hybrid_bitmask &sparse = dense() ? other : *this;
+    const hybrid_bitmask &probed = dense() ? *this : other;
+    for (::std::size_t i = 0; i < sparse.count_; ++i) {
+      if (probed.is_set(static_cast<Index>(sparse.storage_.sparse[i]))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Sets bit
+   * @param index bit index
+   * @return hybrid_bitmask& call chaining
+   */
+  hybrid_bitmask &set(Index index) {
+    const auto position = static_cast<::std::size_t>(index);
+    if (dense()) {
+      count_ += test(storage_.dense, position) ? 0 : 1;
+      flip_on(storage_.dense, position);
+      return *this;
+    }
+    const ::std::size_t slot = lower_bound(position);
+    if (slot != count_ && storage_.sparse[slot] == position) {
+      return *this;
+    }
+    if (count_ == InlineCapacity) {
+      word_type *words = allocate();
+      for (::std::size_t i = 0; i < count_; ++i) {
+        flip_on(words, storage_.sparse[i]);
+      }
+      flip_on(words, position);
+      storage_.dense = words;
+      ++count_;
+      return *this;
+    }
+    for (::std::size_t i = count_; i > slot; --i) {
+      storage_.sparse[i] = storage_.sparse[i - 1];
+    }
+    storage_.sparse[slot] = static_cast<small_index>(position);
+    ++count_;
+    return *this;
+  }
+
+  /**
+   * @brief Sets all bits of other
+   * @param other mask
+   * @return hybrid_bitmask& call chaining
+   */
+  hybrid_bitmask &set(const hybrid_bitmask &other) { return *this |= other; }
+
+  /**
+   * @brief Clears bit
+   * @param index bit index
+   * @return hybrid_bitmask& call chaining
+   */
+  hybrid_bitmask &remove(Index index) noexcept {
+    const auto position = static_cast<::std::size_t>(index);
+    if (dense()) {
+      if (test(storage_.dense, position)) {
+        storage_.dense[position / word_bits] &= ~(word_type{1} << (position % word_bits));
+        --count_;
+        normalize();
+      }
+      return *this;
+    }
+    const ::std::size_t slot = lower_bound(position);
+    if (slot == count_ || storage_.sparse[slot] != position) {
+      return *this;
+    }
+    for (::std::size_t i = slot + 1; i < count_; ++i) {
+      storage_.sparse[i - 1] = storage_.sparse[i];
+    }
+    --count_;
+    return *this;
+  }
+
+  /**
+   * @brief Clears all bits of other
+   * @param other mask
+   * @return hybrid_bitmask& call chaining
+   */
+  hybrid_bitmask &remove(const hybrid_bitmask &other) {
+    if (dense() && other.dense()) {
+      for (::std::size_t i = 0; i < word_count; ++i) {
+        storage_.dense[i] &= ~other.storage_.dense[i];
+      }
+      recount();
+    } else if (dense()) {
+      for (::std::size_t i = 0; i < other.count_; ++i) {
+        remove(static_cast<Index>(other.storage_.sparse[i]));
+      }
+    } else if (other.dense()) {
+      filter(other, false);
+    } else {
+      merge(other, true, false, false);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Clears all bits
+   * @return hybrid_bitmask& call chaining
+   */
+  hybrid_bitmask &clear() noexcept {
+    release();
+    count_ = 0;
+    return *this;
+  }
+
+  /// true if any bit is set
+  DEADDEV_NODISCARD bool any() const noexcept { return count_ != 0; }
+  /// true if no bit is set
+  DEADDEV_NODISCARD bool none() const noexcept { return count_ == 0; }
+  /// number of set bits
+  DEADDEV_NODISCARD ::std::size_t count() const noexcept { return count_; }
+
+  /// lowest set bit or npos
+  DEADDEV_NODISCARD ::std::size_t find_first() const noexcept { return find_next(0); }
+
+  /**
+   * @brief lowest set bit not less than position
+   * @param position first bit to check
+   * @return ::std::size_t bit index or npos
+   */
+  DEADDEV_NODISCARD ::std::size_t find_next(::std::size_t position) const noexcept {
+    if (position >= Bits) {
+      return npos;
+    }
+    if (!dense()) {
+      const ::std::size_t slot = lower_bound(position);
+      return slot == count_ ? npos : storage_.sparse[slot];
+    }
+    ::std::size_t word = position / word_bits;
+    word_type bits = storage_.dense[word] & (~word_type{0} << (position % word_bits));
+    while (bits == 0) {
+      if (++word == word_count) {
+        return npos;
+      }
+      bits = storage_.dense[word];
+    }
+    return word * word_bits + static_cast<::std::size_t>(::deaddev::details::countr_zero(bits));
+  }
+
+  /// highest set bit or npos
+  DEADDEV_NODISCARD ::std::size_t find_last() const noexcept {
+    if (!dense()) {
+      return count_ == 0 ? npos : storage_.sparse[count_ - 1];
+    }
+    for (::std::size_t word = word_count; word-- > 0;) {
+      if (storage_.dense[word] != 0) {
+        return word * word_bits + 63 -
+               static_cast<::std::size_t>(::deaddev::details::countl_zero(storage_.dense[word]));
+      }
+    }
+    return npos;
+  }
+
+  /// first set bit
+  DEADDEV_NODISCARD iterator begin() const noexcept { return iterator(this, find_first()); }
+  /// end iterator
+  DEADDEV_NODISCARD iterator end() const noexcept { return iterator(this, npos); }
+
+  /// dense copy
+  DEADDEV_NODISCARD wide_type to_wide() const noexcept {
+    if (dense()) {
+      return wide_type::from_words(storage_.dense);
+    }
+    wide_type result;
+    for (::std::size_t i = 0; i < count_; ++i) {
+      result.set(static_cast<Index>(storage_.sparse[i]));
+    }
+    return result;
+  }
+
+  /// comparison operator
+  DEADDEV_NODISCARD friend bool operator==(const hybrid_bitmask &left,
+                                           const hybrid_bitmask &right) noexcept {
+    if (left.count_ != right.count_) {
+      return false;
+    }
+    if (left.dense()) {
+      return ::std::memcmp(left.storage_.dense, right.storage_.dense,
+                           sizeof(word_type) * word_count) == 0;
+    }
+    for (::std::size_t i = 0; i < left.count_; ++i) {
+      if (left.storage_.sparse[i] != right.storage_.sparse[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  /// comparison operator
+  DEADDEV_NODISCARD friend bool operator!=(const hybrid_bitmask &left,
+                                           const hybrid_bitmask &right) noexcept {
+    return !(left == right);
+  }
+
+  /// bitwise "and" assignment operator
+  hybrid_bitmask &operator&=(const hybrid_bitmask &other) {
+    if (dense() && other.dense()) {
+      for (::std::size_t i = 0; i < word_count; ++i) {
+        storage_.dense[i] &= other.storage_.dense[i];
+      }
+      recount();
+    } else if (dense()) {
+      hybrid_bitmask result(other);
+      result.filter(*this, true);
+      swap(result);
+    } else if (other.dense()) {
+      filter(other, true);
+    } else {
+      merge(other, false, true, false);
+    }
+    return *this;
+  }
+  /// bitwise "or" assignment operator
+  hybrid_bitmask &operator|=(const hybrid_bitmask &other) {
+    if (dense() && other.dense()) {
+      for (::std::size_t i = 0; i < word_count; ++i) {
+        storage_.dense[i] |= other.storage_.dense[i];
+      }
+      recount();
+    } else if (dense()) {
+      for (::std::size_t i = 0; i < other.count_; ++i) {
+        set(static_cast<Index>(other.storage_.sparse[i]));
+      }
+    } else if (other.dense()) {
+      hybrid_bitmask result(other);
+      result |= *this;
+      swap(result);
+    } else {
+      merge(other, true, true, true);
+    }
+    return *this;
+  }
+  /// bitwise "xor" assignment operator
+  hybrid_bitmask &operator^=(const hybrid_bitmask &other) {
+    if (dense() && other.dense()) {
+      for (::std::size_t i = 0; i < word_count; ++i) {
+        storage_.dense[i] ^= other.storage_.dense[i];
+      }
+      recount();
+    } else if (dense()) {
+      for (::std::size_t i = 0; i < other.count_; ++i) {
+        const ::std::size_t position = other.storage_.sparse[i];
+        count_ = test(storage_.dense, position) ? count_ - 1 : count_ + 1;
+        storage_.dense[position / word_bits] ^= word_type{1} << (position % word_bits);
+      }
+      normalize();
+    } else if (other.dense()) {
+      hybrid_bitmask result(other);
+      result ^= *this;
+      swap(result);
+    } else {
+      merge(other, true, false, true);
+    }
+    return *this;
+  }
+  /// bitwise "and" operator
+  DEADDEV_NODISCARD friend hybrid_bitmask operator&(hybrid_bitmask left,
+                                                    const hybrid_bitmask &right) {
+    return left &= right;
+  }
+  /// bitwise "or" operator
+  DEADDEV_NODISCARD friend hybrid_bitmask operator|(hybrid_bitmask left,
+                                                    const hybrid_bitmask &right) {
+    return left |= right;
+  }
+  /// bitwise "xor" operator
+  DEADDEV_NODISCARD friend hybrid_bitmask operator^(hybrid_bitmask left,
+                                                    const hybrid_bitmask &right) {
+    return left ^= right;
+  }
+
+private:
+  /// smallest unsigned type holding every index
+  using small_index = typename ::std::conditional<
+      (Bits <= 0x100), ::std::uint8_t,
+      typename ::std::conditional<(Bits <= 0x10000), ::std::uint16_t,
+                                  ::std::uint32_t>::type>::type;
+
+  /// sorted indices or heap words
+  union storage {
+    small_index sparse[InlineCapacity];
+    word_type *dense;
+  };
+
+  DEADDEV_NODISCARD bool dense() const noexcept { return count_ > InlineCapacity; }
+
+  static word_type *allocate() { return new word_type[word_count](); }
+
+  static bool test(const word_type *words, ::std::size_t position) noexcept {
+    return (words[position / word_bits] >> (position % word_bits)) & 1;
+  }
+
+  static void flip_on(word_type *words, ::std::size_t position) noexcept {
+    words[position / word_bits] |= word_type{1} << (position % word_bits);
+  }
+
+  void release() noexcept {
+    if (dense()) {
+      delete[] storage_.dense;
+    }
+  }
+
+  /// first sparse slot not less than position, the array is short so scan linearly
+  ::std::size_t lower_bound(::std::size_t position) const noexcept {
+    ::std::size_t slot = 0;
+    while (slot != count_ && storage_.sparse[slot] < position) {
+      ++slot;
+    }
+    return slot;
+  }
+
+  /// popcount of dense words after a word loop
+  void recount() noexcept {
+    ::std::size_t total = 0;
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      total += static_cast<::std::size_t>(::deaddev::details::popcount(storage_.dense[i]));
+    }
+    count_ = total;
+    normalize();
+  }
+
+  /// converts dense words holding at most InlineCapacity bits back to indices
+  void normalize() noexcept {
+    if (count_ > InlineCapacity) {
+      return;
+    }
+    word_type *words = storage_.dense;
+    ::std::size_t slot = 0;
+    for (::std::size_t word = 0; word < word_count && slot != count_; ++word) {
+      for (word_type bits = words[word]; bits != 0; bits &= bits - 1) {
+        storage_.sparse[slot++] = static_cast<small_index>(
+            word * word_bits +
+            static_cast<::std::size_t>(::deaddev::details::countr_zero(bits)));
+      }
+    }
+    delete[] words;
+  }
+
+  /// keeps the sparse indices whose bit in the dense mask equals keep
+  void filter(const hybrid_bitmask &probed, bool keep) noexcept {
+    ::std::size_t size = 0;
+    for (::std::size_t i = 0; i < count_; ++i) {
+      if (test(probed.storage_.dense, storage_.sparse[i]) == keep) {
+        storage_.sparse[size++] = storage_.sparse[i];
+      }
+    }
+    count_ = size;
+  }
+
+  /// merges two sorted index arrays, emitting bits only here, in both or only in other
+  void merge(const hybrid_bitmask &other, bool left_only, bool both, bool right_only) {
+    small_index result[InlineCapacity * 2];
+    ::std::size_t size = 0;
+    ::std::size_t left = 0;
+    ::std::size_t right = 0;
+    while (left != count_ || right != other.count_) {
+      if (right == other.count_ ||
+          (left != count_ && storage_.sparse[left] < other.storage_.sparse[right])) {
+        if (left_only) {
+          result[size++] = storage_.sparse[left];
+        }
+        ++left;
+      } else if (left == count_ || other.storage_.sparse[right] < storage_.sparse[left]) {
+        if (right_only) {
+          result[size++] = other.storage_.sparse[right];
+        }
+        ++right;
+      } else {
+        if (both) {
+          result[size++] = storage_.sparse[left];
+        }
+        ++left;
+        ++right;
+      }
+    }
+    if (size <= InlineCapacity) {
+      ::std::memcpy(storage_.sparse, result, sizeof(small_index) * size);
+      count_ = size;
+      return;
+    }
+    word_type *words = allocate();
+    for (::std::size_t i = 0; i < size; ++i) {
+      flip_on(words, result[i]);
+    }
+    storage_.dense = words;
+    count_ = size;
+  }
+
+  /// set bits, decides the representation
+  ::std::size_t count_ = 0;
+  /// storage
+  storage storage_{};
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_HYBRID_BITMASK_HPP
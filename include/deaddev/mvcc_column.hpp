@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Multi-version bitmask column
+ * @details Readers pin consistent snapshots while a writer keeps updating rows. Blocks are
+ * copied on the first write of an epoch, unchanged blocks are shared between versions
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_MVCC_COLUMN_HPP
+#define DEADDEV_MVCC_COLUMN_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+#include <deaddev/bitmask_algorithm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace deaddev {
+
+/**
+ * @brief Multi-version bitmask column
+ * @details Rows live in blocks of BlockRows. Every block is tagged with the epoch that
+ * wrote it. Writes go to a private working version: a block of an older epoch is copied
+ * before its first write, later writes of the same epoch update the copy in place. commit()
+ * publishes the working version as a new epoch.
+ *
+ * A snapshot holds the blocks of one epoch and scans them as plain arrays, without
+ * version checks per row. Blocks are reference counted and freed when no version holds
+ * them any more.
+ * @tparam T enum type
+ * @tparam BlockRows rows per block
+ */
+template <typename T, ::std::size_t BlockRows = 4096> class mvcc_column {
+  static_assert(BlockRows > 0, "blocks must have rows");
+
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// rows per block
+  static constexpr ::std::size_t block_rows = BlockRows;
+
+private:
+  struct block {
+    ::std::uint64_t epoch;
+    value_type rows[BlockRows];
+  };
+
+  struct version {
+    ::std::uint64_t epoch;
+    ::std::size_t size;
+    ::std::vector<::std::shared_ptr<const block>> blocks;
+  };
+
+public:
+  /**
+   * @brief Consistent read-only view of one epoch
+   * @details cheap to copy, keeps its blocks alive
+   */
+  class snapshot {
+  public:
+    snapshot() = default;
+
+    /// epoch of the snapshot
+    DEADDEV_NODISCARD ::std::uint64_t epoch() const noexcept {
+      return version_ ? version_->epoch : 0;
+    }
+
+    /// number of rows
+    DEADDEV_NODISCARD ::std::size_t size() const noexcept {
+      return version_ ? version_->size : 0;
+    }
+
+    /// number of blocks
+    DEADDEV_NODISCARD ::std::size_t block_count() const noexcept {
+      return version_ ? version_->blocks.size() : 0;
+    }
+
+    /**
+     * @brief Rows of a block
+     * @param index block index
+     * @return const value_type* first row, block_size(index) rows
+     */
+    DEADDEV_NODISCARD const value_type *block_data(::std::size_t index) const noexcept {
+      return version_->blocks[index]->rows;
+    }
+
+    /**
+     * @brief Number of rows of a block
+     * @param index block index
+     * @return ::std::size_t BlockRows, less for the last block
+     */
+    DEADDEV_NODISCARD ::std::size_t block_size(::std::size_t index) const noexcept {
+      const ::std::size_t offset = index * BlockRows;
+      return version_->size - offset < BlockRows ? version_->size - offset : BlockRows;
+    }
+
+    /**
+     * @brief Epoch that last wrote a block
+     * @param index block index
+     * @return ::std::uint64_t epoch, blocks of equal epoch tags are the same
+     */
+    DEADDEV_NODISCARD ::std::uint64_t block_epoch(::std::size_t index) const noexcept {
+      return version_->blocks[index]->epoch;
+    }
+
+    /// row value
+    DEADDEV_NODISCARD value_type operator[](::std::size_t row) const noexcept {
+      return version_->blocks[row / BlockRows]->rows[row % BlockRows];
+    }
+
+    /**
+     * @brief Counts rows matching predicate
+     * @tparam Predicate `bool(bitmask<T>)` callable
+     * @param predicate predicate, e.g. deaddev::has_all(mask)
+     * @return ::std::size_t number of matching rows
+     */
+    template <typename Predicate>
+    DEADDEV_NODISCARD ::std::size_t count_if(const Predicate &predicate) const noexcept {
+      ::std::size_t result = 0;
+      for (::std::size_t i = 0; i < block_count(); ++i) {
+        result += ::deaddev::count_if(block_data(i), block_size(i), predicate);
+      }
+      return result;
+    }
+
+  private:
+    friend mvcc_column;
+    explicit snapshot(::std::shared_ptr<const version> pinned) noexcept
+        : version_(::std::move(pinned)) {}
+
+    ::std::shared_ptr<const version> version_;
+  };
+
+  /**
+   * @brief column of empty rows, published as epoch 1
+   * @param rows number of rows
+   */
+  explicit mvcc_column(::std::size_t rows = 0) {
+    resize(rows);
+    commit();
+  }
+
+  mvcc_column(const mvcc_column &) = delete;
+  mvcc_column &operator=(const mvcc_column &) = delete;
+
+  /**
+   * @brief Pins the latest published epoch
+   * @return snapshot snapshot
+   */
+  DEADDEV_NODISCARD snapshot read() const {
+    ::std::lock_guard<::std::mutex> lock(publish_lock_);
+    return snapshot{published_};
+  }
+
+  /**
+   * @brief Replaces a row in the working version
+   * @param row row index
+   * @param value new value
+   */
+  void assign(::std::size_t row, value_type value) {
+    ::std::lock_guard<::std::mutex> lock(write_lock_);
+    writable(row) = value;
+  }
+
+  /**
+   * @brief Sets flags of a row in the working version
+   * @param row row index
+   * @param flags flags
+   */
+  void set(::std::size_t row, value_type flags) {
+    ::std::lock_guard<::std::mutex> lock(write_lock_);
+    writable(row) |= flags;
+  }
+
+  /**
+   * @brief Clears flags of a row in the working version
+   * @param row row index
+   * @param flags flags
+   */
+  void remove(::std::size_t row, value_type flags) {
+    ::std::lock_guard<::std::mutex> lock(write_lock_);
+    writable(row) &= ~flags;
+  }
+
+  /**
+   * @brief Appends a row to the working version
+   * @param value value
+   */
+  void push_back(value_type value) {
+    ::std::lock_guard<::std::mutex> lock(write_lock_);
+    resize_locked(size_ + 1);
+    writable(size_ - 1) = value;
+  }
+
+  /**
+   * @brief Resizes the working version
+   * @param rows number of rows, new rows are empty
+   */
+  void resize(::std::size_t rows) {
+    ::std::lock_guard<::std::mutex> lock(write_lock_);
+    resize_locked(rows);
+  }
+
+  /**
+   * @brief Publishes the working version
+   * @details blocks written since the last commit become shared and are copied again on
+   * their next write
+   * @return ::std::uint64_t published epoch
+   */
+  ::std::uint64_t commit() {
+    ::std::lock_guard<::std::mutex> lock(write_lock_);
+    auto next = ::std::make_shared<version>();
+    next->epoch = epoch_;
+    next->size = size_;
+    next->blocks.assign(blocks_.begin(), blocks_.end());
+    {
+      ::std::lock_guard<::std::mutex> publish(publish_lock_);
+      published_ = ::std::move(next);
+    }
+    return epoch_++;
+  }
+
+  /// number of rows of the working version
+  DEADDEV_NODISCARD ::std::size_t size() const {
+    ::std::lock_guard<::std::mutex> lock(write_lock_);
+    return size_;
+  }
+
+private:
+  /// row of the working version, copies its block on the first write of the epoch
+  value_type &writable(::std::size_t row) {
+    ::std::shared_ptr<block> &target = blocks_[row / BlockRows];
+    if (target->epoch != epoch_) {
+      auto copy = ::std::make_shared<block>(*target);
+      copy->epoch = epoch_;
+      target = ::std::move(copy);
+    }
+    return target->rows[row % BlockRows];
+  }
+
+  void resize_locked(::std::size_t rows) {
+    const ::std::size_t count = (rows + BlockRows - 1) / BlockRows;
+    while (blocks_.size() < count) {
+      auto fresh = ::std::make_shared<block>();
+      fresh->epoch = epoch_;
+      blocks_.push_back(::std::move(fresh));
+    }
+    blocks_.resize(count);
+    // rows cut off and added again must read as empty
+    for (::std::size_t row = rows; row < size_ && row < count * BlockRows; ++row) {
+      writable(row) = value_type{};
+    }
+    size_ = rows;
+  }
+
+  mutable ::std::mutex write_lock_;
+  ::std::vector<::std::shared_ptr<block>> blocks_;
+  ::std::size_t size_ = 0;
+  ::std::uint64_t epoch_ = 1;
+
+  mutable ::std::mutex publish_lock_;
+  ::std::shared_ptr<const version> published_;
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_MVCC_COLUMN_HPP
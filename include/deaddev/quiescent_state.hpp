@@ -0,0 +1,282 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Quiescent-state based reclamation
+ * @details RCU-style grace periods tracked by an atomic wide bitmask of threads that still
+ * have to pass a quiescent point. Read-side sections cost nothing
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_QUIESCENT_STATE_HPP
+#define DEADDEV_QUIESCENT_STATE_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+#include <deaddev/wide_bitmask.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace deaddev {
+
+/**
+ * @brief Quiescent-state tracker
+ * @details Retired objects are batched per grace period. A period starts with the bits of
+ * all online threads set. A thread at a quiescent point, holding no references to shared
+ * objects, clears its bit with `fetch_and`; the thread that empties the mask runs the
+ * batch of the period and starts the next one if more objects were retired meanwhile.
+ *
+ * quiescent() is one load of the period counter and a compare with the thread's handle;
+ * the `fetch_and` happens once per period.
+ * @tparam MaxThreads maximum number of registered threads
+ */
+template <::std::size_t MaxThreads = 64> class quiescent_state_tracker {
+  using mask_type = ::deaddev::wide_bitmask<MaxThreads>;
+  using word_type = typename mask_type::word_type;
+  static constexpr ::std::size_t word_count = mask_type::word_count;
+  static constexpr ::std::size_t word_bits = sizeof(word_type) * 8;
+
+public:
+  /**
+   * @brief Registration of one thread
+   * @details owned by the thread, unregisters on destruction
+   */
+  class thread_handle {
+  public:
+    thread_handle() noexcept = default;
+    thread_handle(const thread_handle &) = delete;
+    thread_handle &operator=(const thread_handle &) = delete;
+    thread_handle(thread_handle &&other) noexcept
+        : tracker_(::std::exchange(other.tracker_, nullptr)), slot_(other.slot_),
+          seen_(other.seen_) {}
+    thread_handle &operator=(thread_handle &&other) noexcept {
+      if (this != &other) {
+        reset();
+        tracker_ = ::std::exchange(other.tracker_, nullptr);
+        slot_ = other.slot_;
+        seen_ = other.seen_;
+      }
+      return *this;
+    }
+    ~thread_handle() { reset(); }
+
+    /// true if registered
+    DEADDEV_NODISCARD explicit operator bool() const noexcept { return tracker_ != nullptr; }
+
+    /// thread slot
+    DEADDEV_NODISCARD ::std::size_t slot() const noexcept { return slot_; }
+
+    /// unregisters the thread
+    void reset() {
+      if (tracker_ != nullptr) {
+        ::std::exchange(tracker_, nullptr)->unregister_thread(slot_);
+      }
+    }
+
+  private:
+    friend quiescent_state_tracker;
+    thread_handle(quiescent_state_tracker *tracker, ::std::size_t slot,
+                  ::std::uint64_t seen) noexcept
+        : tracker_(tracker), slot_(slot), seen_(seen) {}
+
+    quiescent_state_tracker *tracker_ = nullptr;
+    ::std::size_t slot_ = 0;
+    ::std::uint64_t seen_ = 0;
+  };
+
+  quiescent_state_tracker() = default;
+  quiescent_state_tracker(const quiescent_state_tracker &) = delete;
+  quiescent_state_tracker &operator=(const quiescent_state_tracker &) = delete;
+
+  /// runs all retired callbacks, no thread may be registered
+  ~quiescent_state_tracker() {
+    run(waiting_);
+    run(next_);
+  }
+
+  /**
+   * @brief Registers the calling thread
+   * @details the thread does not hold up periods that started before
+   * @return thread_handle handle, empty if MaxThreads threads are registered
+   */
+  DEADDEV_NODISCARD thread_handle register_thread() {
+    ::std::lock_guard<::std::mutex> lock(lock_);
+    const ::std::size_t slot = (~slots_).find_first();
+    if (slot == mask_type::npos) {
+      return thread_handle{};
+    }
+    slots_.set(slot);
+    online_.set(slot);
+    return thread_handle{this, slot, period_.load(::std::memory_order_relaxed)};
+  }
+
+  /**
+   * @brief Reports a quiescent point of the thread
+   * @details call where the thread holds no references to shared objects
+   * @param thread handle of the calling thread
+   */
+  void quiescent(thread_handle &thread) {
+    const ::std::uint64_t period = period_.load(::std::memory_order_acquire);
+    if (thread.seen_ == period) {
+      return;
+    }
+    thread.seen_ = period;
+    report(thread.slot_);
+  }
+
+  /**
+   * @brief Calls callback(argument) after a grace period
+   * @param callback callback, runs on the thread that completes the period
+   * @param argument argument
+   */
+  void defer(void (*callback)(void *), void *argument) {
+    bool start = false;
+    {
+      ::std::lock_guard<::std::mutex> lock(lock_);
+      next_.push_back(deferred{callback, argument});
+      start = !running_;
+    }
+    if (start) {
+      start_period();
+    }
+  }
+
+  /**
+   * @brief Deletes object after a grace period
+   * @param object object unlinked from shared structures
+   */
+  template <typename U> void retire(U *object) {
+    defer([](void *pointer) { delete static_cast<U *>(pointer); }, object);
+  }
+
+  /// number of started grace periods
+  DEADDEV_NODISCARD ::std::uint64_t period() const noexcept {
+    return period_.load(::std::memory_order_acquire);
+  }
+
+  /// number of callbacks waiting for a grace period
+  DEADDEV_NODISCARD ::std::size_t pending() const {
+    ::std::lock_guard<::std::mutex> lock(lock_);
+    return waiting_.size() + next_.size();
+  }
+
+private:
+  struct deferred {
+    void (*callback)(void *);
+    void *argument;
+  };
+
+  static void run(::std::vector<deferred> &batch) {
+    for (const deferred &item : batch) {
+      item.callback(item.argument);
+    }
+    batch.clear();
+  }
+
+  /// clears the bit of slot, completes the period when the mask becomes empty
+  void report(::std::size_t slot) {
+    const word_type bit = word_type{1} << (slot % word_bits);
+    const word_type previous =
+        pending_[slot / word_bits].fetch_and(~bit, ::std::memory_order_acq_rel);
+    if (previous == bit && pending_words_.fetch_sub(1, ::std::memory_order_acq_rel) == 1) {
+      complete();
+    }
+  }
+
+  /// starts a period for the retired batch if none is running
+  void start_period() {
+    for (;;) {
+      ::std::vector<deferred> done;
+      {
+        ::std::lock_guard<::std::mutex> lock(lock_);
+        if (running_ || next_.empty()) {
+          return;
+        }
+        waiting_.swap(next_);
+        ::std::size_t words = 0;
+        for (::std::size_t i = 0; i < word_count; ++i) {
+          words += online_.word(i) != 0 ? 1 : 0;
+        }
+        // the counter goes first, a thread that clears a new bit decrements after it
+        pending_words_.store(words, ::std::memory_order_relaxed);
+        for (::std::size_t i = 0; i < word_count; ++i) {
+          pending_[i].store(online_.word(i), ::std::memory_order_release);
+        }
+        period_.fetch_add(1, ::std::memory_order_release);
+        if (words != 0) {
+          running_ = true;
+          return;
+        }
+        // no thread online, the period is over already
+        done.swap(waiting_);
+      }
+      run(done);
+    }
+  }
+
+  void complete() {
+    ::std::vector<deferred> done;
+    {
+      ::std::lock_guard<::std::mutex> lock(lock_);
+      done.swap(waiting_);
+      running_ = false;
+    }
+    run(done);
+    start_period();
+  }
+
+  void unregister_thread(::std::size_t slot) {
+    {
+      ::std::lock_guard<::std::mutex> lock(lock_);
+      online_.remove(slot);
+    }
+    // an offline thread is quiescent, its slot is reused only after the report
+    report(slot);
+    ::std::lock_guard<::std::mutex> lock(lock_);
+    slots_.remove(slot);
+  }
+
+  ::std::atomic<::std::uint64_t> period_{0};
+  ::std::atomic<word_type> pending_[word_count] = {};
+  ::std::atomic<::std::size_t> pending_words_{0};
+  mutable ::std::mutex lock_;
+  mask_type slots_;
+  mask_type online_;
+  bool running_ = false;
+  ::std::vector<deferred> waiting_;
+  ::std::vector<deferred> next_;
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_QUIESCENT_STATE_HPP
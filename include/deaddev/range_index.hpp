@@ -0,0 +1,307 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Range queries over a mutable bitmask column
+ * @details deaddev::range_index answers "which flags appear in rows [first, last)", "which
+ * flags are set in every row" and "how many rows have a flag" in logarithmic time and keeps
+ * the answers current under point updates
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_RANGE_INDEX_HPP
+#define DEADDEV_RANGE_INDEX_HPP
+#pragma once
+#include <deaddev/bit.hpp>
+#include <deaddev/bitmask.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deaddev {
+
+/**
+ * @brief Range OR/AND/count index over a bitmask column
+ * @details OR and AND use a B-ary tree stored level by level: every node folds Fanout
+ * consecutive nodes of the level below, so a query scans at most 2 * Fanout contiguous
+ * masks per level. The default fanout fills one cache line. Flag counts use one Fenwick
+ * tree per registered flag, interleaved so an update touches contiguous counters. Updates
+ * and queries are O(Fanout log n); count() is O(log n)
+ * @tparam T enum type
+ * @tparam Fanout children per tree node
+ */
+template <typename T,
+          ::std::size_t Fanout = 64 / sizeof(typename ::deaddev::bitmask<T>::mask_type)>
+class range_index {
+  static_assert(Fanout >= 2, "range_index fanout must be at least 2");
+
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// underlying mask type
+  using mask_type = typename value_type::mask_type;
+  /// children per tree node
+  static constexpr ::std::size_t fanout = Fanout;
+
+  range_index() = default;
+
+  /**
+   * @brief builds the index
+   * @param rows first mask
+   * @param count number of masks
+   */
+  range_index(const value_type *rows, ::std::size_t count) { assign(rows, count); }
+
+  /**
+   * @brief rebuilds the index over another column
+   * @param rows first mask
+   * @param count number of masks
+   */
+  void assign(const value_type *rows, ::std::size_t count) {
+    rows_.resize(count);
+    for (::std::size_t i = 0; i < count; ++i) {
+      rows_[i] = static_cast<mask_type>(rows[i]);
+    }
+    or_levels_.clear();
+    and_levels_.clear();
+    for (::std::size_t size = count; size > 1;) {
+      const ::std::size_t below = or_levels_.size();
+      size = (size + Fanout - 1) / Fanout;
+      or_levels_.emplace_back(size);
+      and_levels_.emplace_back(size);
+      const mask_type *below_or = below == 0 ? rows_.data() : or_levels_[below - 1].data();
+      const mask_type *below_and = below == 0 ? rows_.data() : and_levels_[below - 1].data();
+      const ::std::size_t below_size = below == 0 ? count : or_levels_[below - 1].size();
+      for (::std::size_t node = 0; node < size; ++node) {
+        or_levels_[below][node] = fold_or(below_or, below_size, node);
+        and_levels_[below][node] = fold_and(below_and, below_size, node);
+      }
+    }
+
+    // counters start as single rows, then every node adds itself to its parent
+    counts_.assign((count + 1) * flag_count, 0);
+    for (::std::size_t row = 0; row < count; ++row) {
+      ::std::uint32_t *node = &counts_[(row + 1) * flag_count];
+      for (::std::size_t flag = 0; flag < flag_count; ++flag) {
+        node[flag] = static_cast<::std::uint32_t>((rows_[row] >> flag_bit(flag)) & 1u);
+      }
+    }
+    for (::std::size_t node = 1; node <= count; ++node) {
+      const ::std::size_t parent = node + (node & (0 - node));
+      if (parent <= count) {
+        for (::std::size_t flag = 0; flag < flag_count; ++flag) {
+          counts_[parent * flag_count + flag] += counts_[node * flag_count + flag];
+        }
+      }
+    }
+  }
+
+  /// number of rows
+  DEADDEV_NODISCARD ::std::size_t size() const noexcept { return rows_.size(); }
+
+  /// mask at row
+  DEADDEV_NODISCARD value_type operator[](::std::size_t row) const noexcept {
+    return value_type(rows_[row]);
+  }
+
+  /**
+   * @brief Replaces the mask at row
+   * @param row row index
+   * @param value new mask
+   */
+  void set(::std::size_t row, value_type value) noexcept {
+    const mask_type old_mask = rows_[row];
+    const auto new_mask = static_cast<mask_type>(value);
+    if (old_mask == new_mask) {
+      return;
+    }
+    rows_[row] = new_mask;
+    const ::std::vector<mask_type> *below_or = &rows_;
+    const ::std::vector<mask_type> *below_and = &rows_;
+    ::std::size_t node = row;
+    for (::std::size_t level = 0; level < or_levels_.size(); ++level) {
+      node /= Fanout;
+      or_levels_[level][node] = fold_or(below_or->data(), below_or->size(), node);
+      and_levels_[level][node] = fold_and(below_and->data(), below_and->size(), node);
+      below_or = &or_levels_[level];
+      below_and = &and_levels_[level];
+    }
+
+    ::std::uint32_t delta[flag_count > 0 ? flag_count : 1];
+    for (::std::size_t flag = 0; flag < flag_count; ++flag) {
+      const unsigned bit = flag_bit(flag);
+      delta[flag] = static_cast<::std::uint32_t>((new_mask >> bit) & 1u) -
+                    static_cast<::std::uint32_t>((old_mask >> bit) & 1u);
+    }
+    for (::std::size_t index = row + 1; index <= rows_.size(); index += index & (0 - index)) {
+      ::std::uint32_t *counters = &counts_[index * flag_count];
+      for (::std::size_t flag = 0; flag < flag_count; ++flag) {
+        counters[flag] += delta[flag];
+      }
+    }
+  }
+
+  /**
+   * @brief Flags set in any row of [first, last)
+   * @return value_type OR of the rows, empty for an empty range
+   */
+  DEADDEV_NODISCARD value_type range_or(::std::size_t first, ::std::size_t last) const noexcept {
+    mask_type result = 0;
+    const mask_type *level = rows_.data();
+    for (::std::size_t above = 0; first < last; ++above) {
+      const ::std::size_t node_first = (first + Fanout - 1) / Fanout;
+      const ::std::size_t node_last = last / Fanout;
+      if (node_first >= node_last) {
+        for (::std::size_t i = first; i < last; ++i) {
+          result = static_cast<mask_type>(result | level[i]);
+        }
+        break;
+      }
+      for (::std::size_t i = first; i < node_first * Fanout; ++i) {
+        result = static_cast<mask_type>(result | level[i]);
+      }
+      for (::std::size_t i = node_last * Fanout; i < last; ++i) {
+        result = static_cast<mask_type>(result | level[i]);
+      }
+      first = node_first;
+      last = node_last;
+      level = or_levels_[above].data();
+    }
+    return value_type(result);
+  }
+
+  /**
+   * @brief Flags set in every row of [first, last)
+   * @return value_type AND of the rows, all flags for an empty range
+   */
+  DEADDEV_NODISCARD value_type range_and(::std::size_t first,
+                                         ::std::size_t last) const noexcept {
+    auto result = static_cast<mask_type>(::deaddev::details::bitmask_all_flags_v<T>);
+    const mask_type *level = rows_.data();
+    for (::std::size_t above = 0; first < last; ++above) {
+      const ::std::size_t node_first = (first + Fanout - 1) / Fanout;
+      const ::std::size_t node_last = last / Fanout;
+      if (node_first >= node_last) {
+        for (::std::size_t i = first; i < last; ++i) {
+          result = static_cast<mask_type>(result & level[i]);
+        }
+        break;
+      }
+      for (::std::size_t i = first; i < node_first * Fanout; ++i) {
+        result = static_cast<mask_type>(result & level[i]);
+      }
+      for (::std::size_t i = node_last * Fanout; i < last; ++i) {
+        result = static_cast<mask_type>(result & level[i]);
+      }
+      first = node_first;
+      last = node_last;
+      level = and_levels_[above].data();
+    }
+    return value_type(result);
+  }
+
+  /**
+   * @brief Counts rows of [first, last) with flag set
+   * @param flag registered flag
+   * @return ::std::size_t number of rows, 0 for a flag that is not registered
+   */
+  DEADDEV_NODISCARD ::std::size_t range_count(T flag, ::std::size_t first,
+                                              ::std::size_t last) const noexcept {
+    const ::std::size_t bit = ::deaddev::details::flag_index(flag);
+    // other flags have no counter, their slot would be another flag's
+    assert(((registered >> bit) & 1) != 0 && "range_count needs a registered flag");
+    if (((registered >> bit) & 1) == 0) {
+      return 0;
+    }
+    const auto slot = static_cast<::std::size_t>(::deaddev::details::popcount(
+        registered & ::deaddev::details::low_bits(static_cast<unsigned>(bit))));
+    return prefix_count(slot, last) - prefix_count(slot, first);
+  }
+
+private:
+  /// registered flags as a 64-bit mask
+  static constexpr ::std::uint64_t registered = static_cast<::std::uint64_t>(
+      static_cast<mask_type>(::deaddev::details::bitmask_all_flags_v<T>));
+  /// number of registered flags, one Fenwick counter each
+  static constexpr ::std::size_t flag_count = ::deaddev::details::constexpr_popcount(registered);
+
+  /// bit position of the flag-th registered flag
+  static unsigned flag_bit(::std::size_t flag) noexcept {
+    ::std::uint64_t bits = registered;
+    for (; flag != 0; --flag) {
+      bits &= bits - 1;
+    }
+    return static_cast<unsigned>(::deaddev::details::countr_zero(bits));
+  }
+
+  static mask_type fold_or(const mask_type *below, ::std::size_t size,
+                           ::std::size_t node) noexcept {
+    const ::std::size_t first = node * Fanout;
+    const ::std::size_t last = first + Fanout < size ? first + Fanout : size;
+    mask_type result = 0;
+    for (::std::size_t i = first; i < last; ++i) {
+      result = static_cast<mask_type>(result | below[i]);
+    }
+    return result;
+  }
+
+  static mask_type fold_and(const mask_type *below, ::std::size_t size,
+                            ::std::size_t node) noexcept {
+    const ::std::size_t first = node * Fanout;
+    const ::std::size_t last = first + Fanout < size ? first + Fanout : size;
+    auto result = static_cast<mask_type>(~mask_type{0});
+    for (::std::size_t i = first; i < last; ++i) {
+      result = static_cast<mask_type>(result & below[i]);
+    }
+    return result;
+  }
+
+  ::std::size_t prefix_count(::std::size_t slot, ::std::size_t rows) const noexcept {
+    ::std::size_t result = 0;
+    for (; rows != 0; rows &= rows - 1) {
+      result += counts_[rows * flag_count + slot];
+    }
+    return result;
+  }
+
+  /// the column
+  ::std::vector<mask_type> rows_;
+  /// OR tree levels above the rows, the last one holds the root
+  ::std::vector<::std::vector<mask_type>> or_levels_;
+  /// AND tree levels above the rows
+  ::std::vector<::std::vector<mask_type>> and_levels_;
+  /// interleaved Fenwick counters, flag_count per node, node 0 unused
+  ::std::vector<::std::uint32_t> counts_;
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_RANGE_INDEX_HPP
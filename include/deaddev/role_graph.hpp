@@ -0,0 +1,278 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Effective permissions of inheriting roles
+ * @details deaddev::role_graph keeps the OR of every role's permissions with those of all its
+ * ancestors precomputed, so checking a role is one load. Changes recompute only the
+ * descendants whose effective permissions actually change
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_ROLE_GRAPH_HPP
+#define DEADDEV_ROLE_GRAPH_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+#include <deaddev/bitmask_algorithm.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace deaddev {
+
+/**
+ * @brief Role inheritance graph with precomputed effective permissions
+ * @details Roles are kept in topological order. A change pushes the role into a queue
+ * ordered by that order, and a role's children are queued only if its effective mask
+ * changed. Not thread-safe, readers need external synchronization
+ * @tparam T enum type
+ */
+template <typename T> class role_graph {
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// underlying mask type
+  using mask_type = typename value_type::mask_type;
+  /// role identifier
+  using role_id = ::std::uint32_t;
+
+  /**
+   * @brief Adds a role without parents
+   * @param permissions own permissions
+   * @return role_id new role
+   */
+  role_id add_role(value_type permissions = value_type{}) {
+    const auto role = static_cast<role_id>(own_.size());
+    own_.push_back(static_cast<mask_type>(permissions));
+    effective_.push_back(static_cast<mask_type>(permissions));
+    parents_.emplace_back();
+    children_.emplace_back();
+    rank_.push_back(order_.size());
+    order_.push_back(role);
+    queued_.push_back(0);
+    return role;
+  }
+
+  /**
+   * @brief Makes role inherit the permissions of parent
+   * @return true if added, false for unknown roles, existing edges and cycles
+   */
+  bool add_parent(role_id role, role_id parent) {
+    if (role >= size() || parent >= size() || role == parent ||
+        ::std::find(parents_[role].begin(), parents_[role].end(), parent) !=
+            parents_[role].end() ||
+        reaches(role, parent)) {
+      return false;
+    }
+    parents_[role].push_back(parent);
+    children_[parent].push_back(role);
+    if (rank_[parent] > rank_[role]) {
+      reorder();
+    }
+    propagate(role);
+    return true;
+  }
+
+  /**
+   * @brief Stops role inheriting from parent
+   * @return true if there was such an edge
+   */
+  bool remove_parent(role_id role, role_id parent) {
+    if (role >= size() || parent >= size() || !erase(parents_[role], parent)) {
+      return false;
+    }
+    erase(children_[parent], role);
+    propagate(role);
+    return true;
+  }
+
+  /**
+   * @brief Replaces the own permissions of role
+   * @return ::std::size_t number of roles whose effective permissions changed
+   */
+  ::std::size_t set_permissions(role_id role, value_type permissions) {
+    own_[role] = static_cast<mask_type>(permissions);
+    return propagate(role);
+  }
+
+  /// number of roles
+  DEADDEV_NODISCARD ::std::size_t size() const noexcept { return own_.size(); }
+  /// own permissions of role
+  DEADDEV_NODISCARD value_type permissions(role_id role) const noexcept {
+    return value_type(own_[role]);
+  }
+  /// permissions of role and all its ancestors
+  DEADDEV_NODISCARD value_type effective(role_id role) const noexcept {
+    return value_type(effective_[role]);
+  }
+  /// direct parents of role
+  DEADDEV_NODISCARD const ::std::vector<role_id> &parents(role_id role) const noexcept {
+    return parents_[role];
+  }
+
+  /**
+   * @brief Effective permissions of many roles
+   * @param roles first role
+   * @param count number of roles
+   * @param out count masks
+   */
+  void gather(const role_id *roles, ::std::size_t count, value_type *out) const noexcept {
+    const mask_type *effective = effective_.data();
+    for (::std::size_t i = 0; i < count; ++i) {
+      out[i] = value_type(effective[roles[i]]);
+    }
+  }
+
+  /**
+   * @brief Evaluates predicate on the effective permissions of many roles
+   * @details gathers 64 masks at a time and evaluates them with deaddev::match_word
+   * @tparam Predicate `bool(bitmask<T>)` callable, e.g. deaddev::has_all(flags)
+   * @param roles first role, e.g. the role of every user in a batch
+   * @param count number of roles
+   * @param predicate predicate
+   * @param words output, (count + 63) / 64 match words
+   */
+  template <typename Predicate>
+  void match_words(const role_id *roles, ::std::size_t count, const Predicate &predicate,
+                   ::std::uint64_t *words) const noexcept {
+    value_type batch[match_word_rows];
+    for (::std::size_t offset = 0; offset < count; offset += match_word_rows) {
+      const ::std::size_t rest = count - offset;
+      const ::std::size_t size = rest < match_word_rows ? rest : match_word_rows;
+      gather(roles + offset, size, batch);
+      *words++ = ::deaddev::match_word(batch, size, predicate);
+    }
+  }
+
+private:
+  static bool erase(::std::vector<role_id> &roles, role_id role) {
+    const auto found = ::std::find(roles.begin(), roles.end(), role);
+    if (found == roles.end()) {
+      return false;
+    }
+    *found = roles.back();
+    roles.pop_back();
+    return true;
+  }
+
+  /// true if target is role or one of its descendants
+  bool reaches(role_id role, role_id target) const {
+    ::std::vector<char> seen(size(), 0);
+    ::std::vector<role_id> stack{role};
+    seen[role] = 1;
+    while (!stack.empty()) {
+      const role_id current = stack.back();
+      stack.pop_back();
+      if (current == target) {
+        return true;
+      }
+      for (const role_id child : children_[current]) {
+        if (!seen[child]) {
+          seen[child] = 1;
+          stack.push_back(child);
+        }
+      }
+    }
+    return false;
+  }
+
+  /// rebuilds the topological order
+  void reorder() {
+    ::std::vector<::std::size_t> pending(size());
+    order_.clear();
+    for (role_id role = 0; role < size(); ++role) {
+      pending[role] = parents_[role].size();
+      if (pending[role] == 0) {
+        order_.push_back(role);
+      }
+    }
+    for (::std::size_t i = 0; i < order_.size(); ++i) {
+      for (const role_id child : children_[order_[i]]) {
+        if (--pending[child] == 0) {
+          order_.push_back(child);
+        }
+      }
+    }
+    for (::std::size_t i = 0; i < order_.size(); ++i) {
+      rank_[order_[i]] = i;
+    }
+  }
+
+  /// recomputes role and the descendants whose effective masks change
+  ::std::size_t propagate(role_id role) {
+    ::std::priority_queue<::std::size_t, ::std::vector<::std::size_t>,
+                          ::std::greater<::std::size_t>>
+        ranks;
+    ranks.push(rank_[role]);
+    queued_[role] = 1;
+    ::std::size_t changed = 0;
+    while (!ranks.empty()) {
+      const role_id current = order_[ranks.top()];
+      ranks.pop();
+      queued_[current] = 0;
+      mask_type mask = own_[current];
+      for (const role_id parent : parents_[current]) {
+        mask = static_cast<mask_type>(mask | effective_[parent]);
+      }
+      if (mask == effective_[current]) {
+        continue;
+      }
+      effective_[current] = mask;
+      ++changed;
+      for (const role_id child : children_[current]) {
+        if (!queued_[child]) {
+          queued_[child] = 1;
+          ranks.push(rank_[child]);
+        }
+      }
+    }
+    return changed;
+  }
+
+  /// own permissions by role
+  ::std::vector<mask_type> own_;
+  /// own permissions ORed with those of all ancestors
+  ::std::vector<mask_type> effective_;
+  ::std::vector<::std::vector<role_id>> parents_;
+  ::std::vector<::std::vector<role_id>> children_;
+  /// roles in topological order
+  ::std::vector<role_id> order_;
+  /// position of each role in order_
+  ::std::vector<::std::size_t> rank_;
+  /// role is in the propagation queue
+  ::std::vector<char> queued_;
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_ROLE_GRAPH_HPP
@@ -0,0 +1,300 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Priority run queues with occupancy bit masks
+ * @details A mask of non-empty levels is kept next to per-level intrusive FIFOs, so the
+ * highest non-empty level is found with one clz per 64 levels instead of a scan
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_RUN_QUEUE_HPP
+#define DEADDEV_RUN_QUEUE_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+#include <deaddev/wide_bitmask.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace deaddev {
+
+/**
+ * @brief Intrusive run queue link
+ * @details derive queued items from it, an item can be in one queue at a time
+ */
+struct run_queue_node {
+  /// previous item of the same level
+  run_queue_node *prev = nullptr;
+  /// next item of the same level
+  run_queue_node *next = nullptr;
+};
+
+/**
+ * @brief Multi-level run queue
+ * @details Higher level means higher priority. Items of one level are served in FIFO
+ * order. Not thread-safe, see deaddev::per_cpu_run_queue
+ * @tparam Levels number of priority levels
+ */
+template <::std::size_t Levels = 64> class priority_run_queue {
+public:
+  /// mask of non-empty levels
+  using occupancy_type = ::deaddev::wide_bitmask<Levels>;
+  /// number of levels
+  static constexpr ::std::size_t levels = Levels;
+  /// returned by top_level when the queue is empty
+  static constexpr ::std::size_t npos = occupancy_type::npos;
+
+  /// empty queue
+  priority_run_queue() noexcept = default;
+  priority_run_queue(const priority_run_queue &) = delete;
+  priority_run_queue &operator=(const priority_run_queue &) = delete;
+
+  /**
+   * @brief Appends item to its level
+   * @param node item, must not be queued
+   * @param level priority level in [0, Levels)
+   */
+  void push(run_queue_node &node, ::std::size_t level) noexcept {
+    fifo &queue = queues_[level];
+    node.prev = queue.tail;
+    node.next = nullptr;
+    if (queue.tail != nullptr) {
+      queue.tail->next = &node;
+    } else {
+      queue.head = &node;
+      occupancy_.set(level);
+    }
+    queue.tail = &node;
+    ++size_;
+  }
+
+  /**
+   * @brief Removes the oldest item of the highest non-empty level
+   * @return run_queue_node* item or nullptr if the queue is empty
+   */
+  DEADDEV_NODISCARD run_queue_node *pop() noexcept {
+    const ::std::size_t level = occupancy_.find_last();
+    if (level == npos) {
+      return nullptr;
+    }
+    run_queue_node *node = queues_[level].head;
+    remove(*node, level);
+    return node;
+  }
+
+  /**
+   * @brief Removes queued item
+   * @param node item queued with `level`
+   * @param level level of the item
+   */
+  void remove(run_queue_node &node, ::std::size_t level) noexcept {
+    fifo &queue = queues_[level];
+    (node.prev != nullptr ? node.prev->next : queue.head) = node.next;
+    (node.next != nullptr ? node.next->prev : queue.tail) = node.prev;
+    node.prev = nullptr;
+    node.next = nullptr;
+    if (queue.head == nullptr) {
+      occupancy_.remove(level);
+    }
+    --size_;
+  }
+
+  /**
+   * @brief Oldest item of the highest non-empty level
+   * @return run_queue_node* item or nullptr if the queue is empty
+   */
+  DEADDEV_NODISCARD run_queue_node *top() const noexcept {
+    const ::std::size_t level = occupancy_.find_last();
+    return level == npos ? nullptr : queues_[level].head;
+  }
+
+  /// highest non-empty level or npos
+  DEADDEV_NODISCARD ::std::size_t top_level() const noexcept {
+    return occupancy_.find_last();
+  }
+
+  /// mask of non-empty levels
+  DEADDEV_NODISCARD const occupancy_type &occupancy() const noexcept { return occupancy_; }
+
+  /// true if there are no items
+  DEADDEV_NODISCARD bool empty() const noexcept { return size_ == 0; }
+
+  /// number of items
+  DEADDEV_NODISCARD ::std::size_t size() const noexcept { return size_; }
+
+private:
+  /// intrusive FIFO of one level
+  struct fifo {
+    run_queue_node *head = nullptr;
+    run_queue_node *tail = nullptr;
+  };
+
+  fifo queues_[Levels];
+  occupancy_type occupancy_;
+  ::std::size_t size_ = 0;
+};
+
+/**
+ * @brief Per-CPU run queues with work stealing
+ * @details Every CPU owns a locked deaddev::priority_run_queue and publishes its highest
+ * non-empty level. A CPU with an empty queue scans the published levels of its peers
+ * without taking their locks and steals from the peer with the highest one
+ * @tparam Levels number of priority levels
+ */
+template <::std::size_t Levels = 64> class per_cpu_run_queue {
+public:
+  /// queue of one CPU
+  using queue_type = ::deaddev::priority_run_queue<Levels>;
+  /// returned by top_level when the queue is empty
+  static constexpr ::std::size_t npos = queue_type::npos;
+
+  /**
+   * @brief empty queues
+   * @param cpus number of CPUs
+   */
+  explicit per_cpu_run_queue(::std::size_t cpus)
+      : cpus_(new cpu_queue[cpus]), cpu_count_(cpus) {}
+
+  /**
+   * @brief Appends item to the queue of a CPU
+   * @param cpu CPU index
+   * @param node item, must not be queued
+   * @param level priority level in [0, Levels)
+   */
+  void push(::std::size_t cpu, run_queue_node &node, ::std::size_t level) {
+    cpu_queue &queue = cpus_[cpu];
+    ::std::lock_guard<::std::mutex> lock(queue.lock);
+    queue.queue.push(node, level);
+    queue.publish();
+  }
+
+  /**
+   * @brief Removes the highest priority item of a CPU, steals when it has none
+   * @param cpu CPU index
+   * @return run_queue_node* item or nullptr if all queues are empty
+   */
+  DEADDEV_NODISCARD run_queue_node *pop(::std::size_t cpu) {
+    if (run_queue_node *node = pop_local(cpu)) {
+      return node;
+    }
+    return steal(cpu);
+  }
+
+  /**
+   * @brief Removes the highest priority item of a CPU
+   * @param cpu CPU index
+   * @return run_queue_node* item or nullptr if the queue of the CPU is empty
+   */
+  DEADDEV_NODISCARD run_queue_node *pop_local(::std::size_t cpu) {
+    cpu_queue &queue = cpus_[cpu];
+    if (queue.top.load(::std::memory_order_relaxed) == npos) {
+      return nullptr;
+    }
+    ::std::lock_guard<::std::mutex> lock(queue.lock);
+    run_queue_node *node = queue.queue.pop();
+    queue.publish();
+    return node;
+  }
+
+  /**
+   * @brief Steals the highest priority item of the peers
+   * @param cpu CPU index of the thief
+   * @return run_queue_node* item or nullptr if all peers are empty
+   */
+  DEADDEV_NODISCARD run_queue_node *steal(::std::size_t cpu) {
+    for (;;) {
+      ::std::size_t victim = cpu_count_;
+      ::std::size_t best = npos;
+      for (::std::size_t peer = 0; peer < cpu_count_; ++peer) {
+        const ::std::size_t level = cpus_[peer].top.load(::std::memory_order_relaxed);
+        if (peer != cpu && level != npos && (best == npos || level > best)) {
+          best = level;
+          victim = peer;
+        }
+      }
+      if (victim == cpu_count_) {
+        return nullptr;
+      }
+      // the victim may have been drained after the scan, scan again then
+      if (run_queue_node *node = pop_local(victim)) {
+        return node;
+      }
+    }
+  }
+
+  /**
+   * @brief Removes queued item
+   * @param cpu CPU index the item is queued on
+   * @param node item
+   * @param level level of the item
+   */
+  void remove(::std::size_t cpu, run_queue_node &node, ::std::size_t level) {
+    cpu_queue &queue = cpus_[cpu];
+    ::std::lock_guard<::std::mutex> lock(queue.lock);
+    queue.queue.remove(node, level);
+    queue.publish();
+  }
+
+  /**
+   * @brief published highest non-empty level of a CPU
+   * @param cpu CPU index
+   * @return ::std::size_t level or npos
+   */
+  DEADDEV_NODISCARD ::std::size_t top_level(::std::size_t cpu) const noexcept {
+    return cpus_[cpu].top.load(::std::memory_order_relaxed);
+  }
+
+  /// number of CPUs
+  DEADDEV_NODISCARD ::std::size_t cpu_count() const noexcept { return cpu_count_; }
+
+private:
+  /// queue, lock and published level of one CPU on its own cache line
+#ifdef __cpp_aligned_new
+  struct alignas(64) cpu_queue {
+#else
+  struct cpu_queue {
+#endif
+    ::std::mutex lock;
+    queue_type queue;
+    ::std::atomic<::std::size_t> top{npos};
+
+    /// must be called with lock held
+    void publish() noexcept { top.store(queue.top_level(), ::std::memory_order_relaxed); }
+  };
+
+  ::std::unique_ptr<cpu_queue[]> cpus_;
+  ::std::size_t cpu_count_;
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_RUN_QUEUE_HPP
@@ -0,0 +1,284 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Process-shared atomic bitmask
+ * @details Lives in `shm_open`, `memfd_create` or other `MAP_SHARED` memory. Processes wait
+ * on it with shared futexes, so a signal costs a cache line transfer and a wake syscall only
+ * when somebody sleeps. Linux only
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_SHARED_BITMASK_HPP
+#define DEADDEV_SHARED_BITMASK_HPP
+#pragma once
+#include <deaddev/bitmask.hpp>
+
+#if !defined(__linux__)
+#error "deaddev/shared_bitmask.hpp requires Linux futexes"
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <new>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace deaddev {
+
+/**
+ * @brief Atomic bitmask shared between processes
+ * @details The layout does not depend on T: a header with magic, layout version and mask
+ * size, the futex words, and the mask stored as 64 bits. create() initializes it and
+ * publishes the magic last, attach() accepts only a fully initialized segment of the same
+ * layout and mask size. The object takes one cache line.
+ *
+ * A process that dies while waiting leaves the waiter count raised, which only costs
+ * setters a wake syscall.
+ * @tparam T enum type
+ */
+template <typename T> class alignas(64) shared_bitmask {
+  static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+                "shared_bitmask needs address-free lock-free atomics");
+
+public:
+  /// bitmask type
+  using value_type = ::deaddev::bitmask<T>;
+  /// enum type
+  using enum_type = T;
+  /// "DDBM"
+  static constexpr ::std::uint32_t magic = 0x4D424444;
+  /// layout version, bumped on incompatible changes
+  static constexpr ::std::uint16_t layout_version = 1;
+
+  shared_bitmask(const shared_bitmask &) = delete;
+  shared_bitmask &operator=(const shared_bitmask &) = delete;
+
+  /**
+   * @brief Initializes a bitmask in shared memory
+   * @details only one process may create, the others attach after it returns
+   * @param memory start of the segment, aligned to 64 bytes
+   * @param size segment size
+   * @return shared_bitmask* bitmask or nullptr if memory is too small or misaligned
+   */
+  static shared_bitmask *create(void *memory, ::std::size_t size) noexcept {
+    if (!fits(memory, size)) {
+      return nullptr;
+    }
+    auto *result = ::new (memory) shared_bitmask();
+    result->magic_.store(magic, ::std::memory_order_release);
+    return result;
+  }
+
+  /**
+   * @brief Attaches to a bitmask created by another process
+   * @param memory start of the segment
+   * @param size segment size
+   * @return shared_bitmask* bitmask or nullptr if the segment is not initialized yet,
+   * too small or has another layout or mask size
+   */
+  static shared_bitmask *attach(void *memory, ::std::size_t size) noexcept {
+    if (!fits(memory, size)) {
+      return nullptr;
+    }
+    auto *result = static_cast<shared_bitmask *>(memory);
+    if (result->magic_.load(::std::memory_order_acquire) != magic ||
+        result->version_ != layout_version || result->mask_size_ != sizeof(mask_type)) {
+      return nullptr;
+    }
+    return result;
+  }
+
+  /// current mask
+  DEADDEV_NODISCARD value_type load() const noexcept {
+    return from_word(mask_.load(::std::memory_order_seq_cst));
+  }
+
+  /**
+   * @brief Sets flags and wakes waiters
+   * @param flags flags to set
+   * @return value_type previous mask
+   */
+  value_type set(value_type flags) noexcept {
+    const ::std::uint64_t bits = to_word(flags);
+    const ::std::uint64_t previous = mask_.fetch_or(bits, ::std::memory_order_seq_cst);
+    if ((bits & ~previous) != 0) {
+      wake();
+    }
+    return from_word(previous);
+  }
+
+  /**
+   * @brief Clears flags
+   * @details never wakes, waits only wait for flags to be set
+   * @param flags flags to clear
+   * @return value_type previous mask
+   */
+  value_type remove(value_type flags) noexcept {
+    return from_word(mask_.fetch_and(~to_word(flags), ::std::memory_order_seq_cst));
+  }
+
+  /**
+   * @brief Replaces the mask and wakes waiters if flags were set
+   * @param value new mask
+   * @return value_type previous mask
+   */
+  value_type exchange(value_type value) noexcept {
+    const ::std::uint64_t bits = to_word(value);
+    const ::std::uint64_t previous = mask_.exchange(bits, ::std::memory_order_seq_cst);
+    if ((bits & ~previous) != 0) {
+      wake();
+    }
+    return from_word(previous);
+  }
+
+  /**
+   * @brief Blocks until a flag of mask is set
+   * @param mask flags
+   * @return value_type mask that satisfied the wait
+   */
+  value_type wait_any(value_type mask) noexcept {
+    const ::std::uint64_t want = to_word(mask);
+    return from_word(wait([want](::std::uint64_t bits) { return (bits & want) != 0; }, nullptr));
+  }
+
+  /**
+   * @brief Blocks until every flag of mask is set
+   * @param mask flags
+   * @return value_type mask that satisfied the wait
+   */
+  value_type wait_all(value_type mask) noexcept {
+    const ::std::uint64_t want = to_word(mask);
+    return from_word(wait([want](::std::uint64_t bits) { return (bits & want) == want; }, nullptr));
+  }
+
+  /**
+   * @brief Blocks until a flag of mask is set or timeout passes
+   * @param mask flags
+   * @param timeout timeout
+   * @return true if a flag was set
+   */
+  bool wait_any_for(value_type mask, ::std::chrono::nanoseconds timeout) noexcept {
+    const ::std::uint64_t want = to_word(mask);
+    const ::timespec when = deadline(timeout);
+    return (wait([want](::std::uint64_t bits) { return (bits & want) != 0; }, &when) & want) != 0;
+  }
+
+  /**
+   * @brief Blocks until every flag of mask is set or timeout passes
+   * @param mask flags
+   * @param timeout timeout
+   * @return true if every flag was set
+   */
+  bool wait_all_for(value_type mask, ::std::chrono::nanoseconds timeout) noexcept {
+    const ::std::uint64_t want = to_word(mask);
+    const ::timespec when = deadline(timeout);
+    return (wait([want](::std::uint64_t bits) { return (bits & want) == want; }, &when) &
+            want) == want;
+  }
+
+private:
+  using mask_type = typename value_type::mask_type;
+
+  shared_bitmask() noexcept = default;
+
+  static bool fits(void *memory, ::std::size_t size) noexcept {
+    return memory != nullptr && size >= sizeof(shared_bitmask) &&
+           reinterpret_cast<::std::uintptr_t>(memory) % alignof(shared_bitmask) == 0;
+  }
+
+  static ::std::uint64_t to_word(value_type value) noexcept {
+    using unsigned_type = ::std::make_unsigned_t<mask_type>;
+    return static_cast<unsigned_type>(static_cast<mask_type>(value));
+  }
+
+  static value_type from_word(::std::uint64_t word) noexcept {
+    return value_type{static_cast<mask_type>(word)};
+  }
+
+  /// absolute CLOCK_MONOTONIC time after timeout
+  static ::timespec deadline(::std::chrono::nanoseconds timeout) noexcept {
+    ::timespec now{};
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    const auto nanoseconds = timeout.count() < 0 ? 0 : timeout.count();
+    const long long total = now.tv_nsec + nanoseconds % 1000000000;
+    now.tv_sec += static_cast<::time_t>(nanoseconds / 1000000000 + total / 1000000000);
+    now.tv_nsec = static_cast<long>(total % 1000000000);
+    return now;
+  }
+
+  /// waits until ready(mask) or the deadline, returns the last mask seen
+  template <typename F> ::std::uint64_t wait(F ready, const ::timespec *when) noexcept {
+    for (;;) {
+      ::std::uint64_t bits = mask_.load(::std::memory_order_seq_cst);
+      if (ready(bits)) {
+        return bits;
+      }
+      waiters_.fetch_add(1, ::std::memory_order_seq_cst);
+      const ::std::uint32_t epoch = epoch_.load(::std::memory_order_seq_cst);
+      bits = mask_.load(::std::memory_order_seq_cst);
+      long result = 0;
+      if (!ready(bits)) {
+        result = ::syscall(SYS_futex, reinterpret_cast<::std::uint32_t *>(&epoch_),
+                           FUTEX_WAIT_BITSET, epoch, when, nullptr, FUTEX_BITSET_MATCH_ANY);
+      }
+      waiters_.fetch_sub(1, ::std::memory_order_seq_cst);
+      if (result == -1 && errno == ETIMEDOUT) {
+        return mask_.load(::std::memory_order_seq_cst);
+      }
+    }
+  }
+
+  void wake() noexcept {
+    if (waiters_.load(::std::memory_order_seq_cst) == 0) {
+      return;
+    }
+    epoch_.fetch_add(1, ::std::memory_order_seq_cst);
+    ::syscall(SYS_futex, reinterpret_cast<::std::uint32_t *>(&epoch_), FUTEX_WAKE, INT_MAX,
+              nullptr, nullptr, 0);
+  }
+
+  ::std::atomic<::std::uint32_t> magic_{0};
+  ::std::uint16_t version_ = layout_version;
+  ::std::uint16_t mask_size_ = sizeof(mask_type);
+  ::std::atomic<::std::uint32_t> epoch_{0};
+  ::std::atomic<::std::uint32_t> waiters_{0};
+  ::std::atomic<::std::uint64_t> mask_{0};
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_SHARED_BITMASK_HPP
@@ -0,0 +1,303 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Hierarchical timing wheel with slot occupancy masks
+ * @details Every level has 64 slots and a 64-bit mask of non-empty slots, so the next
+ * tick with work is found with one ctz per level and empty spans are skipped in O(1)
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_TIMING_WHEEL_HPP
+#define DEADDEV_TIMING_WHEEL_HPP
+#pragma once
+#include <deaddev/bit.hpp>
+#include <deaddev/bitmask.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace deaddev {
+
+/**
+ * @brief Intrusive timer
+ * @details derive timers from it, a timer can be in one wheel at a time
+ */
+struct timer_node {
+  /// previous timer in the slot
+  timer_node *prev = nullptr;
+  /// next timer in the slot
+  timer_node *next = nullptr;
+  /// expiration tick
+  ::std::uint64_t expires = 0;
+  /// wheel level, `unlinked` if not scheduled
+  ::std::uint8_t level = unlinked;
+  /// slot in the level
+  ::std::uint8_t slot = 0;
+
+  /// level value of timers that are not scheduled
+  static constexpr ::std::uint8_t unlinked = 0xFF;
+};
+
+/**
+ * @brief Hierarchical timing wheel
+ * @details Level k has 64 slots of 64^k ticks. A timer goes to the level of the highest
+ * bit where its expiration tick differs from the current one, and is moved one level down
+ * when the current tick reaches its slot. Timers beyond the last level wait in an overflow
+ * list that is re-sorted once per 64^Levels ticks.
+ *
+ * schedule and cancel are O(1). advance jumps straight to the next tick with work.
+ * @tparam Levels number of levels, 64^Levels ticks are covered without overflow
+ */
+template <::std::size_t Levels = 4> class timing_wheel {
+  static_assert(Levels >= 1 && Levels <= 10, "timing_wheel supports 1 to 10 levels");
+
+public:
+  /// slots per level
+  static constexpr ::std::size_t slots = 64;
+  /// bits of tick per level
+  static constexpr unsigned slot_bits = 6;
+  /// number of levels
+  static constexpr ::std::size_t levels = Levels;
+  /// returned by next_event when there are no timers
+  static constexpr ::std::uint64_t never = ::std::numeric_limits<::std::uint64_t>::max();
+
+  /**
+   * @brief empty wheel
+   * @param now current tick
+   */
+  explicit timing_wheel(::std::uint64_t now = 0) noexcept : current_(now) {}
+  timing_wheel(const timing_wheel &) = delete;
+  timing_wheel &operator=(const timing_wheel &) = delete;
+
+  /**
+   * @brief Schedules timer
+   * @details timers that are already due expire on the next advance
+   * @param timer timer, rescheduled if it is already in this wheel
+   * @param expires expiration tick
+   */
+  void schedule(timer_node &timer, ::std::uint64_t expires) noexcept {
+    cancel(timer);
+    timer.expires = expires;
+    link(timer);
+    ++size_;
+  }
+
+  /**
+   * @brief Cancels timer
+   * @param timer timer
+   * @return true if timer was scheduled
+   */
+  bool cancel(timer_node &timer) noexcept {
+    if (timer.level == timer_node::unlinked) {
+      return false;
+    }
+    unlink(timer);
+    --size_;
+    return true;
+  }
+
+  /**
+   * @brief Expires timers up to now
+   * @details Calls `expire(timer_node &)` for every timer with `expires <= now`, in tick
+   * order. The callback may schedule and cancel timers, including the expired one, and
+   * must not throw
+   * @param now current tick, not less than the previous one
+   * @param expire callback
+   * @return ::std::size_t number of expired timers
+   */
+  template <typename F> ::std::size_t advance(::std::uint64_t now, F &&expire) {
+    ::std::size_t expired = 0;
+    while (current_ <= now) {
+      const ::std::uint64_t tick = next_event();
+      if (tick > now) {
+        break;
+      }
+      current_ = tick;
+      if (overflow_ != nullptr && overflow_tick_ <= tick) {
+        relink(detach(overflow_));
+      }
+      for (::std::size_t level = Levels - 1; level >= 1; --level) {
+        // the current slot of an upper level has timers only at its first tick
+        const auto slot = static_cast<::std::size_t>((tick >> shift(level)) % slots);
+        if ((occupancy_[level] >> slot) & 1) {
+          occupancy_[level] &= ~(::std::uint64_t{1} << slot);
+          relink(detach(slots_[level][slot]));
+        }
+      }
+      // one timer at a time from the slot head, so callbacks can cancel or reschedule the
+      // other due timers, and timers they schedule for this tick expire in this pass
+      const auto slot = static_cast<::std::size_t>(tick % slots);
+      while ((occupancy_[0] >> slot) & 1) {
+        timer_node &timer = *slots_[0][slot];
+        unlink(timer);
+        --size_;
+        ++expired;
+        expire(timer);
+      }
+      ++current_;
+    }
+    if (current_ <= now) {
+      current_ = now + 1;
+    }
+    return expired;
+  }
+
+  /**
+   * @brief Next tick advance has work at
+   * @details A lower bound of the next expiration: either the expiration itself or the
+   * tick where timers of an upper level move down
+   * @return ::std::uint64_t tick or `never` if there are no timers
+   */
+  DEADDEV_NODISCARD ::std::uint64_t next_event() const noexcept {
+    ::std::uint64_t result = never;
+    for (::std::size_t level = 0; level < Levels; ++level) {
+      const auto current_slot =
+          static_cast<unsigned>((current_ >> shift(level)) % slots);
+      const ::std::uint64_t pending = occupancy_[level] & (~::std::uint64_t{0} << current_slot);
+      if (pending != 0) {
+        const auto slot = static_cast<::std::uint64_t>(::deaddev::details::countr_zero(pending));
+        const ::std::uint64_t tick =
+            (current_ & ~span_mask(level + 1)) | (slot << shift(level));
+        result = tick < result ? tick : result;
+      }
+    }
+    if (overflow_ != nullptr) {
+      result = overflow_tick_ < result ? overflow_tick_ : result;
+    }
+    return result < current_ ? current_ : result;
+  }
+
+  /// next tick to be processed
+  DEADDEV_NODISCARD ::std::uint64_t now() const noexcept { return current_; }
+
+  /// number of scheduled timers
+  DEADDEV_NODISCARD ::std::size_t size() const noexcept { return size_; }
+
+  /// true if there are no timers
+  DEADDEV_NODISCARD bool empty() const noexcept { return size_ == 0; }
+
+  /**
+   * @brief mask of non-empty slots
+   * @param level level
+   * @return ::std::uint64_t bit i is set if slot i has timers
+   */
+  DEADDEV_NODISCARD ::std::uint64_t occupancy(::std::size_t level) const noexcept {
+    return occupancy_[level];
+  }
+
+private:
+  static constexpr unsigned shift(::std::size_t level) noexcept {
+    return static_cast<unsigned>(level * slot_bits);
+  }
+
+  /// mask of ticks inside one slot of level, level == Levels for the whole wheel
+  static constexpr ::std::uint64_t span_mask(::std::size_t level) noexcept {
+    return shift(level) >= 64 ? ~::std::uint64_t{0}
+                              : (::std::uint64_t{1} << shift(level)) - 1;
+  }
+
+  /// puts timer in its slot relative to the current tick
+  void link(timer_node &timer) noexcept {
+    const ::std::uint64_t expires = timer.expires < current_ ? current_ : timer.expires;
+    const ::std::uint64_t difference = expires ^ current_;
+    const ::std::size_t level =
+        difference == 0
+            ? 0
+            : static_cast<::std::size_t>(63 - ::deaddev::details::countl_zero(difference)) /
+                  slot_bits;
+    timer.prev = nullptr;
+    if (level >= Levels) {
+      // re-sorted when the current tick leaves the last level
+      const ::std::uint64_t boundary = (current_ | span_mask(Levels)) + 1;
+      if (overflow_ == nullptr || boundary < overflow_tick_) {
+        overflow_tick_ = boundary;
+      }
+      timer.level = static_cast<::std::uint8_t>(Levels);
+      timer.slot = 0;
+      push(overflow_, timer);
+      return;
+    }
+    const auto slot = static_cast<::std::size_t>((expires >> shift(level)) % slots);
+    timer.level = static_cast<::std::uint8_t>(level);
+    timer.slot = static_cast<::std::uint8_t>(slot);
+    push(slots_[level][slot], timer);
+    occupancy_[level] |= ::std::uint64_t{1} << slot;
+  }
+
+  void unlink(timer_node &timer) noexcept {
+    timer_node *&head =
+        timer.level == Levels ? overflow_ : slots_[timer.level][timer.slot];
+    (timer.prev != nullptr ? timer.prev->next : head) = timer.next;
+    if (timer.next != nullptr) {
+      timer.next->prev = timer.prev;
+    }
+    if (head == nullptr && timer.level != Levels) {
+      occupancy_[timer.level] &= ~(::std::uint64_t{1} << timer.slot);
+    }
+    timer.prev = nullptr;
+    timer.next = nullptr;
+    timer.level = timer_node::unlinked;
+  }
+
+  static void push(timer_node *&head, timer_node &timer) noexcept {
+    timer.next = head;
+    if (head != nullptr) {
+      head->prev = &timer;
+    }
+    head = &timer;
+  }
+
+  static timer_node *detach(timer_node *&head) noexcept {
+    timer_node *list = head;
+    head = nullptr;
+    return list;
+  }
+
+  /// moves detached timers to their new slots
+  void relink(timer_node *timer) noexcept {
+    while (timer != nullptr) {
+      timer_node *next = timer->next;
+      link(*timer);
+      timer = next;
+    }
+  }
+
+  timer_node *slots_[Levels][slots] = {};
+  ::std::uint64_t occupancy_[Levels] = {};
+  timer_node *overflow_ = nullptr;
+  ::std::uint64_t overflow_tick_ = never;
+  ::std::uint64_t current_;
+  ::std::size_t size_ = 0;
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_TIMING_WHEEL_HPP
@@ -0,0 +1,401 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Bit masks wider than 64 bits
+ * @details deaddev::wide_bitmask stores bit indices (integers or enums whose values are
+ * bit positions) in an array of 64-bit words
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+
+/// include guard
+#ifndef DEADDEV_WIDE_BITMASK_HPP
+#define DEADDEV_WIDE_BITMASK_HPP
+#pragma once
+#include <deaddev/bit.hpp>
+#include <deaddev/bitmask.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
+namespace deaddev {
+
+/**
+ * @brief Wide bit mask
+ * @details Fixed size set of bit indices. Operations touch `word_count` words, lookups of
+ * the lowest/highest set bit are one ctz/clz per word
+ * @tparam Bits number of bits
+ * @tparam Index index type, integer or enum with bit positions as values
+ */
+template <::std::size_t Bits, typename Index = ::std::size_t> class wide_bitmask {
+  static_assert(Bits > 0, "wide_bitmask must have at least one bit");
+
+public:
+  /// storage word
+  using word_type = ::std::uint64_t;
+  /// index type
+  using index_type = Index;
+  /// number of bits
+  static constexpr ::std::size_t bits = Bits;
+  /// bits per word
+  static constexpr ::std::size_t word_bits = 64;
+  /// number of words
+  static constexpr ::std::size_t word_count = (Bits + word_bits - 1) / word_bits;
+  /// returned by find functions when there's no set bit
+  static constexpr ::std::size_t npos = Bits;
+
+  /// forward iterator over set bits
+  class iterator {
+  public:
+    /// iterator category
+    using iterator_category = ::std::forward_iterator_tag;
+    /// bit index
+    using value_type = Index;
+    /// difference type
+    using difference_type = ::std::ptrdiff_t;
+    /// not addressable
+    using pointer = void;
+    /// returned by value
+    using reference = Index;
+
+    /// end iterator
+    constexpr iterator() noexcept = default;
+
+    /// current bit index
+    DEADDEV_NODISCARD constexpr Index operator*() const noexcept {
+      return static_cast<Index>(position_);
+    }
+    /// next set bit
+    iterator &operator++() noexcept {
+      position_ = mask_->find_next(position_ + 1);
+      return *this;
+    }
+    /// next set bit
+    iterator operator++(int) noexcept {
+      iterator result = *this;
+      ++*this;
+      return result;
+    }
+    /// comparison operator
+    DEADDEV_NODISCARD friend constexpr bool operator==(const iterator &left,
+                                                       const iterator &right) noexcept {
+      return left.position_ == right.position_;
+    }
+    /// comparison operator
+    DEADDEV_NODISCARD friend constexpr bool operator!=(const iterator &left,
+                                                       const iterator &right) noexcept {
+      return left.position_ != right.position_;
+    }
+
+  private:
+    friend wide_bitmask;
+    constexpr iterator(const wide_bitmask *mask, ::std::size_t position) noexcept
+        : mask_(mask), position_(position) {}
+
+    const wide_bitmask *mask_{};
+    ::std::size_t position_{npos};
+  };
+
+  /// empty mask
+  constexpr wide_bitmask() noexcept = default;
+
+  /**
+   * @brief mask from bit list
+   * @param indices set bits
+   */
+  constexpr wide_bitmask(::std::initializer_list<Index> indices) noexcept {
+    for (const Index index : indices) {
+      set(index);
+    }
+  }
+
+  /**
+   * @brief returns mask with all bits set
+   * @return wide_bitmask all bits
+   */
+  DEADDEV_NODISCARD static constexpr wide_bitmask all() noexcept {
+    wide_bitmask result;
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      result.words_[i] = ~word_type{0};
+    }
+    result.trim();
+    return result;
+  }
+
+  /**
+   * @brief mask from words
+   * @param words word_count words, bits over Bits are ignored
+   * @return wide_bitmask mask
+   */
+  DEADDEV_NODISCARD static constexpr wide_bitmask from_words(const word_type *words) noexcept {
+    wide_bitmask result;
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      result.words_[i] = words[i];
+    }
+    result.trim();
+    return result;
+  }
+
+  /**
+   * @brief Checks if bit is set
+   * @param index bit index
+   * @return true bit is set
+   */
+  DEADDEV_NODISCARD constexpr bool is_set(Index index) const noexcept {
+    const auto position = static_cast<::std::size_t>(index);
+    return (words_[position / word_bits] >> (position % word_bits)) & 1;
+  }
+
+  /**
+   * @brief Checks if all bits of other are set
+   * @param other mask
+   * @return true all bits of other are set
+   */
+  DEADDEV_NODISCARD constexpr bool is_set(const wide_bitmask &other) const noexcept {
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      if ((words_[i] & other.words_[i]) != other.words_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Checks if any bit of other is set
+   * @param other mask
+   * @return true masks intersect
+   */
+  DEADDEV_NODISCARD constexpr bool intersects(const wide_bitmask &other) const noexcept {
+    word_type result = 0;
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      result |= words_[i] & other.words_[i];
+    }
+    return result != 0;
+  }
+
+  /**
+   * @brief Sets bit
+   * @param index bit index
+   * @return wide_bitmask& call chaining
+   */
+  constexpr wide_bitmask &set(Index index) noexcept {
+    const auto position = static_cast<::std::size_t>(index);
+    words_[position / word_bits] |= word_type{1} << (position % word_bits);
+    return *this;
+  }
+
+  /**
+   * @brief Sets all bits of other
+   * @param other mask
+   * @return wide_bitmask& call chaining
+   */
+  constexpr wide_bitmask &set(const wide_bitmask &other) noexcept { return *this |= other; }
+
+  /**
+   * @brief Clears bit
+   * @param index bit index
+   * @return wide_bitmask& call chaining
+   */
+  constexpr wide_bitmask &remove(Index index) noexcept {
+    const auto position = static_cast<::std::size_t>(index);
+    words_[position / word_bits] &= ~(word_type{1} << (position % word_bits));
+    return *this;
+  }
+
+  /**
+   * @brief Clears all bits of other
+   * @param other mask
+   * @return wide_bitmask& call chaining
+   */
+  constexpr wide_bitmask &remove(const wide_bitmask &other) noexcept {
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      words_[i] &= ~other.words_[i];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Clears all bits
+   * @return wide_bitmask& call chaining
+   */
+  constexpr wide_bitmask &clear() noexcept {
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      words_[i] = 0;
+    }
+    return *this;
+  }
+
+  /// true if any bit is set
+  DEADDEV_NODISCARD constexpr bool any() const noexcept {
+    word_type result = 0;
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      result |= words_[i];
+    }
+    return result != 0;
+  }
+
+  /// true if no bit is set
+  DEADDEV_NODISCARD constexpr bool none() const noexcept { return !any(); }
+
+  /// number of set bits
+  DEADDEV_NODISCARD ::std::size_t count() const noexcept {
+    ::std::size_t result = 0;
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      result += static_cast<::std::size_t>(::deaddev::details::popcount(words_[i]));
+    }
+    return result;
+  }
+
+  /// lowest set bit or npos
+  DEADDEV_NODISCARD ::std::size_t find_first() const noexcept { return find_next(0); }
+
+  /**
+   * @brief lowest set bit not less than position
+   * @param position first bit to check
+   * @return ::std::size_t bit index or npos
+   */
+  DEADDEV_NODISCARD ::std::size_t find_next(::std::size_t position) const noexcept {
+    if (position >= Bits) {
+      return npos;
+    }
+    ::std::size_t word = position / word_bits;
+    word_type bits = words_[word] & (~word_type{0} << (position % word_bits));
+    while (bits == 0) {
+      if (++word == word_count) {
+        return npos;
+      }
+      bits = words_[word];
+    }
+    return word * word_bits + static_cast<::std::size_t>(::deaddev::details::countr_zero(bits));
+  }
+
+  /// highest set bit or npos
+  DEADDEV_NODISCARD ::std::size_t find_last() const noexcept {
+    for (::std::size_t word = word_count; word-- > 0;) {
+      if (words_[word] != 0) {
+        return word * word_bits + 63 -
+               static_cast<::std::size_t>(::deaddev::details::countl_zero(words_[word]));
+      }
+    }
+    return npos;
+  }
+
+  /// first set bit
+  DEADDEV_NODISCARD iterator begin() const noexcept { return iterator(this, find_first()); }
+  /// end iterator
+  DEADDEV_NODISCARD iterator end() const noexcept { return iterator(this, npos); }
+
+  /**
+   * @brief storage word
+   * @param index word index
+   * @return word_type word
+   */
+  DEADDEV_NODISCARD constexpr word_type word(::std::size_t index) const noexcept {
+    return words_[index];
+  }
+  /// storage words
+  DEADDEV_NODISCARD constexpr const word_type *data() const noexcept { return words_; }
+
+  /// comparison operator
+  DEADDEV_NODISCARD friend constexpr bool operator==(const wide_bitmask &left,
+                                                     const wide_bitmask &right) noexcept {
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      if (left.words_[i] != right.words_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  /// comparison operator
+  DEADDEV_NODISCARD friend constexpr bool operator!=(const wide_bitmask &left,
+                                                     const wide_bitmask &right) noexcept {
+    return !(left == right);
+  }
+
+  /// bitwise negation operator
+  DEADDEV_NODISCARD constexpr wide_bitmask operator~() const noexcept {
+    wide_bitmask result;
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      result.words_[i] = ~words_[i];
+    }
+    result.trim();
+    return result;
+  }
+  /// bitwise "and" assignment operator
+  constexpr wide_bitmask &operator&=(const wide_bitmask &other) noexcept {
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      words_[i] &= other.words_[i];
+    }
+    return *this;
+  }
+  /// bitwise "or" assignment operator
+  constexpr wide_bitmask &operator|=(const wide_bitmask &other) noexcept {
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      words_[i] |= other.words_[i];
+    }
+    return *this;
+  }
+  /// bitwise "xor" assignment operator
+  constexpr wide_bitmask &operator^=(const wide_bitmask &other) noexcept {
+    for (::std::size_t i = 0; i < word_count; ++i) {
+      words_[i] ^= other.words_[i];
+    }
+    return *this;
+  }
+  /// bitwise "and" operator
+  DEADDEV_NODISCARD friend constexpr wide_bitmask operator&(wide_bitmask left,
+                                                            const wide_bitmask &right) noexcept {
+    return left &= right;
+  }
+  /// bitwise "or" operator
+  DEADDEV_NODISCARD friend constexpr wide_bitmask operator|(wide_bitmask left,
+                                                            const wide_bitmask &right) noexcept {
+    return left |= right;
+  }
+  /// bitwise "xor" operator
+  DEADDEV_NODISCARD friend constexpr wide_bitmask operator^(wide_bitmask left,
+                                                            const wide_bitmask &right) noexcept {
+    return left ^= right;
+  }
+
+private:
+  /// clears bits over Bits in the last word
+  constexpr void trim() noexcept {
+    words_[word_count - 1] &= ::deaddev::details::low_bits(
+        static_cast<unsigned>(Bits - (word_count - 1) * word_bits));
+  }
+
+  /// storage
+  word_type words_[word_count]{};
+};
+
+} // namespace deaddev
+
+#endif // DEADDEV_WIDE_BITMASK_HPP
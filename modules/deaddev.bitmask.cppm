@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////////////
+//                                                                                   //
+//  MIT License                                                                      //
+//                                                                                   //
+//  Copyright (c) 2025 DeadDev                                                       //
+//                                                                                   //
+//  Permission is hereby granted, free of charge, to any person obtaining a copy     //
+//  of this software and associated documentation files (the "Software"), to deal    //
+//  in the Software without restriction, including without limitation the rights     //
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        //
+//  copies of the Software, and to permit persons to whom the Software is            //
+//  furnished to do so, subject to the following conditions:                         //
+//                                                                                   //
+//  The above copyright notice and this permission notice shall be included in all   //
+//  copies or substantial portions of the Software.                                  //
+//                                                                                   //
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       //
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         //
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      //
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           //
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    //
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE    //
+//  SOFTWARE.                                                                        //
+//                                                                                   //
+///////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief C++20 module interface for deaddev::bitmask
+ * @details Exports the bitmask class, the traits used by registration and the free
+ * operators. Registration macros are in deaddev/bitmask_macros.hpp:
+ * @code
+ * import deaddev.bitmask;
+ * #include <deaddev/bitmask_macros.hpp>
+ *
+ * enum class my_flag_bits { a = 1, b = 2 };
+ * DEADDEV_ENABLE_BITMASK(my_flag_bits, my_flag_bits::a, my_flag_bits::b);
+ * @endcode
+ * Configuration macros (e.g. `DEADDEV_ENABLE_BITMASKS_FOR_SCOPED_ENUMS`) must be defined
+ * when the module itself is built
+ * @author DeadDev https://github.com/imdeaddev
+ * @date 2025-12-09
+ * @copyright DeadDev (C) 2025, MIT license
+ */
+module;
+
+#include <deaddev/bitmask.hpp>
+
+export module deaddev.bitmask;
+
+export namespace deaddev {
+using ::deaddev::bitmask;
+using ::deaddev::bitmask_operation;
+
+namespace details {
+// used by the expansion of the registration macros
+using ::deaddev::details::adl_bitmask_operations_check;
+using ::deaddev::details::bitmask_operations_check_traits;
+using ::deaddev::details::bitmask_traits;
+using ::deaddev::details::calculate_all_flags;
+using ::deaddev::details::combine_flags;
+using ::deaddev::details::empty_bitmask_traits;
+using ::deaddev::details::adl_bitmask_instrumentation;
+using ::deaddev::details::bitmask_instrumentation_traits;
+using ::deaddev::details::disabled_bitmask_instrumentation;
+using ::deaddev::details::enabled_bitmask_instrumentation;
+using ::deaddev::details::instrument_bitmask;
+// type traits
+using ::deaddev::details::bitmask_all_flags_v;
+using ::deaddev::details::enable_if_bitmask_t;
+using ::deaddev::details::is_bitmask;
+using ::deaddev::details::is_bitmask_v;
+} // namespace details
+} // namespace deaddev
+
+// free operators live in the global namespace, see deaddev/bitmask.hpp
+export using ::operator==;
+export using ::operator!=;
+export using ::operator<=;
+export using ::operator>=;
+export using ::operator<;
+export using ::operator>;
+export using ::operator~;
+export using ::operator^;
+export using ::operator|;
+export using ::operator&;
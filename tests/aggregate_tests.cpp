@@ -0,0 +1,146 @@
+#include <deaddev/bitmask_aggregate.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace aggregate_ns {
+enum class small_bits : uint8_t {
+  option_0_bit = 0x01,
+  option_1_bit = 0x02,
+  option_5_bit = 0x20,
+  option_7_bit = 0x80,
+};
+DEADDEV_ENABLE_BITMASK(small_bits, small_bits::option_0_bit, small_bits::option_1_bit,
+                       small_bits::option_5_bit, small_bits::option_7_bit);
+enum class wide_bits : uint32_t {
+  option_0_bit = 0x00000001,
+  option_31_bit = 0x80000000,
+};
+DEADDEV_ENABLE_BITMASK(wide_bits, wide_bits::option_0_bit, wide_bits::option_31_bit);
+} // namespace aggregate_ns
+using small_bits = aggregate_ns::small_bits;
+using small_flags = deaddev::bitmask<small_bits>;
+using wide_bits = aggregate_ns::wide_bits;
+using wide_flags = deaddev::bitmask<wide_bits>;
+
+namespace {
+std::vector<small_flags> small_column(std::size_t count) {
+  std::vector<small_flags> column;
+  for (std::size_t i = 0; i < count; ++i) {
+    column.emplace_back(static_cast<uint8_t>((i * 2654435761u) >> 13));
+  }
+  return column;
+}
+
+// throws when given the slice starting at poison, which is the calling thread's slice
+struct throwing_aggregator {
+  using value_type = small_flags;
+  using enum_type = small_bits;
+
+  const small_flags *poison;
+
+  void add(const value_type *rows, std::size_t) const {
+    if (rows == poison) {
+      throw std::runtime_error("poisoned slice");
+    }
+  }
+  void merge(const throwing_aggregator &) const noexcept {}
+  throwing_aggregator split() const noexcept { return *this; }
+};
+} // namespace
+
+TEST(aggregate, flag_and_pair_counts) {
+  const auto column = small_column(10007);
+  deaddev::flag_counts<small_bits> flags;
+  deaddev::cooccurrence_counts<small_bits> pairs;
+  deaddev::aggregate(column.data(), column.size(), 3, flags, pairs);
+  ASSERT_EQ(flags.rows(), column.size());
+  for (std::size_t first = 0; first < 8; ++first) {
+    std::uint64_t single = 0;
+    for (const auto row : column) {
+      single += (static_cast<uint8_t>(row) >> first) & 1u;
+    }
+    ASSERT_EQ(flags[first], single);
+    ASSERT_EQ(pairs(first, first), single);
+    for (std::size_t second = 0; second < 8; ++second) {
+      std::uint64_t both = 0;
+      for (const auto row : column) {
+        both += (static_cast<uint8_t>(row) >> first) & (static_cast<uint8_t>(row) >> second) & 1u;
+      }
+      ASSERT_EQ(pairs(first, second), both);
+    }
+  }
+  ASSERT_EQ(pairs.count(small_bits::option_5_bit, small_bits::option_7_bit), pairs(5, 7));
+  ASSERT_EQ(flags.count(small_bits::option_1_bit), flags[1]);
+}
+
+TEST(aggregate, histogram_spills_and_merges) {
+  std::vector<wide_flags> column;
+  std::map<uint32_t, std::uint64_t> expected;
+  for (uint32_t i = 0; i < 20000; ++i) {
+    const uint32_t mask = (i * 7919u) % 3001u * 65537u | (i % 3 == 0 ? 0x80000000u : 0u);
+    column.emplace_back(mask);
+    ++expected[mask];
+  }
+  deaddev::mask_histogram<wide_bits> histogram(100);
+  deaddev::cooccurrence_counts<wide_bits> pairs;
+  deaddev::aggregate(column.data(), column.size(), 2, histogram, pairs);
+  std::uint64_t both = 0;
+  for (const auto &entry : expected) {
+    both += (entry.first & 0x80000001u) == 0x80000001u ? entry.second : 0;
+  }
+  ASSERT_EQ(pairs.count(wide_bits::option_0_bit, wide_bits::option_31_bit), both);
+  ASSERT_GT(both, 0u);
+  ASSERT_EQ(pairs(31, 0), both);
+  ASSERT_GT(histogram.spilled_runs(), 0u);
+  std::map<uint32_t, std::uint64_t> actual;
+  uint32_t previous = 0;
+  histogram.for_each([&](wide_flags mask, std::uint64_t count) {
+    ASSERT_TRUE(actual.empty() || static_cast<uint32_t>(mask) > previous);
+    previous = static_cast<uint32_t>(mask);
+    actual[previous] = count;
+  });
+  ASSERT_EQ(actual, expected);
+}
+
+TEST(aggregate, file_in_chunks) {
+  const auto column = small_column(5000);
+  const std::string path = testing::TempDir() + "deaddev_aggregate_test.bin";
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  const char header[16] = "mask column v1";
+  std::fwrite(header, 1, sizeof(header), file);
+  std::fwrite(column.data(), sizeof(small_flags), column.size(), file);
+  std::fclose(file);
+
+  deaddev::aggregate_options options;
+  options.chunk_rows = 333;
+  options.threads = 3;
+  options.offset = sizeof(header);
+  deaddev::flag_counts<small_bits> from_file;
+  deaddev::mask_histogram<small_bits> histogram;
+  const auto result = deaddev::aggregate_file(path.c_str(), options, from_file, histogram);
+  ASSERT_TRUE(result.ok);
+  ASSERT_EQ(result.rows, column.size());
+  deaddev::flag_counts<small_bits> in_memory;
+  deaddev::aggregate(column.data(), column.size(), 1, in_memory);
+  std::uint64_t total = 0;
+  histogram.for_each([&](small_flags, std::uint64_t count) { total += count; });
+  ASSERT_EQ(total, column.size());
+  for (std::size_t bit = 0; bit < 8; ++bit) {
+    ASSERT_EQ(from_file[bit], in_memory[bit]);
+  }
+  ASSERT_FALSE(deaddev::aggregate_file("/nonexistent/deaddev", options, from_file).ok);
+  std::remove(path.c_str());
+}
+
+TEST(aggregate, joins_workers_when_add_throws) {
+  const auto column = small_column(1000);
+  throwing_aggregator aggregator{column.data()};
+  ASSERT_THROW(deaddev::aggregate(column.data(), column.size(), 4, aggregator),
+               std::runtime_error);
+}
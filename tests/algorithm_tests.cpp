@@ -0,0 +1,370 @@
+#include <deaddev/bitmask_algorithm.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace algorithm_ns {
+enum class algorithm_flag_bits : uint8_t {
+  option_0_bit = 0x01,
+  option_1_bit = 0x02,
+  option_2_bit = 0x04,
+};
+DEADDEV_ENABLE_BITMASK(algorithm_flag_bits, algorithm_flag_bits::option_0_bit,
+                       algorithm_flag_bits::option_1_bit,
+                       algorithm_flag_bits::option_2_bit);
+} // namespace algorithm_ns
+using algorithm_flag_bits = algorithm_ns::algorithm_flag_bits;
+using algorithm_flags = deaddev::bitmask<algorithm_flag_bits>;
+
+namespace algorithm_ns {
+enum class event_bits : uint32_t {
+  option_0_bit = 0x00000001,
+  option_4_bit = 0x00000010,
+  option_9_bit = 0x00000200,
+  option_30_bit = 0x40000000,
+};
+DEADDEV_ENABLE_BITMASK(event_bits, event_bits::option_0_bit, event_bits::option_4_bit,
+                       event_bits::option_9_bit, event_bits::option_30_bit);
+} // namespace algorithm_ns
+using event_bits = algorithm_ns::event_bits;
+using event_flags = deaddev::bitmask<event_bits>;
+
+namespace algorithm_ns {
+// default int underlying type
+enum class int_bits {
+  option_0_bit = 0x00000001,
+  option_1_bit = 0x00000002,
+  option_2_bit = 0x00000004,
+  option_30_bit = 0x40000000,
+};
+DEADDEV_ENABLE_BITMASK(int_bits, int_bits::option_0_bit, int_bits::option_1_bit,
+                       int_bits::option_2_bit, int_bits::option_30_bit);
+// signed with the sign bit as a flag
+enum class signed_bits : int8_t {
+  option_0_bit = 0x01,
+  option_3_bit = 0x08,
+  option_7_bit = -0x80,
+};
+DEADDEV_ENABLE_BITMASK(signed_bits, signed_bits::option_0_bit, signed_bits::option_3_bit,
+                       signed_bits::option_7_bit);
+} // namespace algorithm_ns
+using int_flags = deaddev::bitmask<algorithm_ns::int_bits>;
+using signed_flags = deaddev::bitmask<algorithm_ns::signed_bits>;
+
+namespace {
+std::vector<algorithm_flags> make_column(std::size_t count) {
+  std::vector<algorithm_flags> column;
+  for (std::size_t i = 0; i < count; ++i) {
+    column.emplace_back(static_cast<uint8_t>(i % 8));
+  }
+  return column;
+}
+
+// mostly all flags with rare random rows, so running ANDs do not clear at once
+template <typename Flags> std::vector<Flags> event_column(std::size_t count) {
+  std::vector<Flags> column;
+  std::uint32_t state = 12345;
+  for (std::size_t i = 0; i < count; ++i) {
+    state = state * 1664525u + 1013904223u;
+    auto row = Flags::all_flags();
+    if ((state >> 24) < 3) {
+      row = Flags(static_cast<typename Flags::mask_type>(state >> 8)) & Flags::all_flags();
+    }
+    column.push_back(row);
+  }
+  return column;
+}
+
+template <typename Flags, typename Operation>
+std::vector<Flags> serial_scan(const std::vector<Flags> &rows, Flags value, bool inclusive) {
+  std::vector<Flags> result;
+  for (const auto row : rows) {
+    const auto next = Operation::apply(value, row);
+    result.push_back(inclusive ? next : value);
+    value = next;
+  }
+  return result;
+}
+
+// runs every worker on its own thread
+struct thread_pool {
+  std::size_t workers;
+  std::size_t size() const { return workers; }
+  template <typename F> void run(F &&function) {
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < workers; ++index) {
+      threads.emplace_back([&function, index] { function(index); });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+};
+
+template <typename Flags> void check_scans() {
+  const auto column = event_column<Flags>(1000);
+  for (const std::size_t count : {0u, 1u, 7u, 64u, 65u, 1000u}) {
+    const std::vector<Flags> rows(column.begin(), column.begin() + count);
+    std::vector<Flags> out(count);
+    const auto total =
+        deaddev::inclusive_scan(rows.data(), count, out.data(), deaddev::scan_or);
+    ASSERT_EQ(out, (serial_scan<Flags, deaddev::scan_or_t>(rows, Flags{}, true)));
+    ASSERT_EQ(total, count == 0 ? Flags{} : out.back());
+    deaddev::exclusive_scan(rows.data(), count, out.data(), deaddev::scan_or);
+    ASSERT_EQ(out, (serial_scan<Flags, deaddev::scan_or_t>(rows, Flags{}, false)));
+    deaddev::inclusive_scan(rows.data(), count, out.data(), deaddev::scan_and);
+    ASSERT_EQ(out, (serial_scan<Flags, deaddev::scan_and_t>(rows, Flags::all_flags(), true)));
+    deaddev::exclusive_scan(rows.data(), count, out.data(), deaddev::scan_and);
+    ASSERT_EQ(out, (serial_scan<Flags, deaddev::scan_and_t>(rows, Flags::all_flags(), false)));
+  }
+
+  // a stream in uneven chunks equals one scan over everything
+  const auto expected = serial_scan<Flags, deaddev::scan_and_t>(column, Flags::all_flags(), true);
+  std::vector<Flags> streamed(column);
+  auto carry = Flags::all_flags();
+  for (std::size_t first = 0; first < column.size(); first += 77) {
+    const std::size_t count = std::min<std::size_t>(77, column.size() - first);
+    carry = deaddev::inclusive_scan(streamed.data() + first, count, streamed.data() + first,
+                                    deaddev::scan_and, carry);
+  }
+  ASSERT_EQ(streamed, expected);
+  ASSERT_EQ(carry, expected.back());
+  ASSERT_NE(expected[100], Flags::all_flags());
+}
+} // namespace
+
+TEST(algorithm, match_word) {
+  const auto column = make_column(70);
+  ASSERT_EQ(deaddev::match_word(column.data(), 64,
+                                deaddev::has_all(algorithm_flag_bits::option_2_bit)),
+            0xF0F0F0F0F0F0F0F0ull);
+  ASSERT_EQ(deaddev::match_word(column.data() + 64, 6,
+                                deaddev::has_none(algorithm_flag_bits::option_0_bit)),
+            0x15ull);
+}
+
+TEST(algorithm, count_if) {
+  const auto column = make_column(1000);
+  ASSERT_EQ(deaddev::count_if(column.data(), column.size(),
+                              deaddev::has_any(algorithm_flag_bits::option_0_bit |
+                                               algorithm_flag_bits::option_1_bit)),
+            750u);
+  ASSERT_EQ(deaddev::count_if(column.data(), column.size(),
+                              deaddev::query(algorithm_flags(algorithm_flag_bits::option_0_bit),
+                                             algorithm_flags(algorithm_flag_bits::option_1_bit))),
+            250u);
+  ASSERT_EQ(deaddev::count_if(column.data(), 0, deaddev::has_none(algorithm_flags{})), 0u);
+}
+
+TEST(algorithm, scans) {
+  check_scans<algorithm_flags>();
+  check_scans<event_flags>();
+  check_scans<int_flags>();
+  check_scans<signed_flags>();
+
+  using algorithm_ns::int_bits;
+  const int_flags rows[8] = {int_flags(int_bits::option_0_bit), int_flags(int_bits::option_1_bit),
+                             int_flags(int_bits::option_2_bit), int_flags{},
+                             int_flags(int_bits::option_30_bit), int_flags{},
+                             int_flags(int_bits::option_0_bit), int_flags{}};
+  int_flags out[8];
+  deaddev::inclusive_scan(rows, 8, out, deaddev::scan_or);
+  ASSERT_EQ(out[3], int_bits::option_0_bit | int_bits::option_1_bit | int_bits::option_2_bit);
+  ASSERT_EQ(out[7], int_flags::all_flags());
+}
+
+TEST(algorithm, segmented_scans) {
+  const auto column = event_column<event_flags>(300);
+  // segments start at 0, 5, 6, 64, 200 and 299
+  std::vector<std::uint64_t> starts((column.size() + 63) / 64);
+  for (const std::size_t start : {0u, 5u, 6u, 64u, 200u, 299u}) {
+    starts[start / 64] |= std::uint64_t{1} << (start % 64);
+  }
+  for (const bool inclusive : {true, false}) {
+    std::vector<event_flags> expected;
+    auto value = event_flags{};
+    for (std::size_t i = 0; i < column.size(); ++i) {
+      if ((starts[i / 64] >> (i % 64)) & 1u) {
+        value = event_flags{};
+      }
+      const auto next = value | column[i];
+      expected.push_back(inclusive ? next : value);
+      value = next;
+    }
+    std::vector<event_flags> out(column.size());
+    if (inclusive) {
+      deaddev::segmented_inclusive_scan(column.data(), column.size(), starts.data(), out.data(),
+                                        deaddev::scan_or);
+    } else {
+      deaddev::segmented_exclusive_scan(column.data(), column.size(), starts.data(), out.data(),
+                                        deaddev::scan_or);
+    }
+    ASSERT_EQ(out, expected);
+  }
+}
+
+TEST(algorithm, parallel_scans) {
+  const auto column = event_column<event_flags>(10007);
+  for (const std::size_t workers : {1u, 3u, 8u}) {
+    thread_pool pool{workers};
+    std::vector<event_flags> out(column.size());
+    ASSERT_EQ(deaddev::inclusive_scan_on(pool, column.data(), column.size(), out.data(),
+                                         deaddev::scan_and),
+              column.empty() ? event_flags::all_flags() : out.back());
+    ASSERT_EQ(out, (serial_scan<event_flags, deaddev::scan_and_t>(
+                       column, event_flags::all_flags(), true)));
+    deaddev::exclusive_scan_on(pool, column.data(), column.size(), out.data(), deaddev::scan_or);
+    ASSERT_EQ(out, (serial_scan<event_flags, deaddev::scan_or_t>(column, event_flags{}, false)));
+  }
+}
+
+namespace {
+// runs of repeated rows, so most neighbours are equal
+template <typename Flags> std::vector<Flags> run_column(std::size_t count) {
+  std::vector<Flags> column;
+  std::uint32_t state = 777;
+  auto row = Flags{};
+  for (std::size_t i = 0; i < count; ++i) {
+    state = state * 1664525u + 1013904223u;
+    if ((state >> 26) == 0) {
+      row = Flags(static_cast<typename Flags::mask_type>(state >> 4)) & Flags::all_flags();
+    }
+    column.push_back(row);
+  }
+  return column;
+}
+
+template <typename Flags> void check_edges(std::size_t bit) {
+  using mask_type = typename Flags::mask_type;
+  const auto column = run_column<Flags>(5000);
+  const auto previous = Flags::all_flags();
+  std::vector<std::vector<std::uint64_t>> rises(sizeof(mask_type) * 8);
+  std::vector<std::vector<std::uint64_t>> falls(sizeof(mask_type) * 8);
+  for (std::size_t i = 0; i < column.size(); ++i) {
+    const auto before = static_cast<mask_type>(i == 0 ? previous : column[i - 1]);
+    const auto current = static_cast<mask_type>(column[i]);
+    for (std::size_t bit = 0; bit < rises.size(); ++bit) {
+      if ((current >> bit & 1u) > (before >> bit & 1u)) {
+        rises[bit].push_back(i);
+      } else if ((current >> bit & 1u) < (before >> bit & 1u)) {
+        falls[bit].push_back(i);
+      }
+    }
+  }
+
+  // uneven chunks stream across buffer boundaries
+  deaddev::flag_edges<typename Flags::enum_type> edges(previous);
+  std::size_t changes = 0;
+  auto last = previous;
+  for (std::size_t first = 0; first < column.size(); first += 13 + first % 50) {
+    const std::size_t count = std::min<std::size_t>(13 + first % 50, column.size() - first);
+    edges.add(column.data() + first, count);
+    last = deaddev::for_each_edge(column.data() + first, count, last,
+                                  [&](std::size_t index, Flags rise, Flags fall) {
+                                    ASSERT_NE(column[first + index],
+                                              first + index == 0 ? previous
+                                                                 : column[first + index - 1]);
+                                    ASSERT_NE(rise | fall, Flags{});
+                                    ++changes;
+                                  });
+  }
+  ASSERT_EQ(last, column.back());
+  ASSERT_EQ(edges.previous(), column.back());
+  ASSERT_EQ(edges.rows(), column.size());
+  ASSERT_GT(changes, 10u);
+  ASSERT_LT(changes, 500u);
+  for (std::size_t bit = 0; bit < rises.size(); ++bit) {
+    ASSERT_EQ(edges.rises(bit), rises[bit]);
+    ASSERT_EQ(edges.falls(bit), falls[bit]);
+  }
+
+  std::vector<std::uint64_t> rise_words((column.size() + 63) / 64, ~0ull);
+  std::vector<std::uint64_t> fall_words(rise_words.size(), ~0ull);
+  deaddev::edge_words(column.data(), column.size(), previous,
+                      Flags(static_cast<mask_type>(std::make_unsigned_t<mask_type>{1} << bit)),
+                      rise_words.data(),
+                      fall_words.data());
+  for (std::size_t i = 0; i < column.size(); ++i) {
+    const bool rose = (rise_words[i / 64] >> (i % 64)) & 1u;
+    const bool fell = (fall_words[i / 64] >> (i % 64)) & 1u;
+    ASSERT_EQ(rose, std::count(rises[bit].begin(), rises[bit].end(), i) == 1);
+    ASSERT_EQ(fell, std::count(falls[bit].begin(), falls[bit].end(), i) == 1);
+  }
+}
+} // namespace
+
+TEST(algorithm, edges) {
+  check_edges<algorithm_flags>(4);
+  check_edges<event_flags>(4);
+  check_edges<int_flags>(30);
+  check_edges<signed_flags>(7);
+  deaddev::flag_edges<algorithm_flag_bits> edges;
+  const auto column = make_column(20);
+  edges.add(column.data(), column.size());
+  ASSERT_EQ(edges.rises(algorithm_flag_bits::option_2_bit),
+            (std::vector<std::uint64_t>{4, 12}));
+  ASSERT_EQ(edges.falls(algorithm_flag_bits::option_2_bit), (std::vector<std::uint64_t>{8, 16}));
+
+  // the sign bit of a signed mask is lane data, not a lane mask
+  using algorithm_ns::signed_bits;
+  std::vector<signed_flags> signed_rows(16, signed_flags(signed_bits::option_7_bit));
+  signed_rows[3] = signed_flags(signed_bits::option_0_bit);
+  signed_rows[9] = signed_bits::option_7_bit | signed_bits::option_3_bit;
+  deaddev::flag_edges<signed_bits> signed_edges;
+  signed_edges.add(signed_rows.data(), signed_rows.size());
+  ASSERT_EQ(signed_edges.rises(signed_bits::option_7_bit), (std::vector<std::uint64_t>{0, 4}));
+  ASSERT_EQ(signed_edges.falls(signed_bits::option_7_bit), std::vector<std::uint64_t>{3});
+  ASSERT_EQ(signed_edges.rises(signed_bits::option_3_bit), std::vector<std::uint64_t>{9});
+  ASSERT_EQ(signed_edges.falls(signed_bits::option_3_bit), std::vector<std::uint64_t>{10});
+  std::size_t changes = 0;
+  deaddev::for_each_edge(signed_rows.data(), signed_rows.size(), signed_flags{},
+                         [&](std::size_t, signed_flags, signed_flags) { ++changes; });
+  ASSERT_EQ(changes, 5u);
+}
+
+namespace {
+template <typename V, typename Predicate>
+void check_select(const std::vector<algorithm_flags> &column, const Predicate &predicate) {
+  std::vector<V> a;
+  std::vector<V> b;
+  for (std::size_t i = 0; i < column.size(); ++i) {
+    a.push_back(static_cast<V>(i % 100) + static_cast<V>(1));
+    b.push_back(-static_cast<V>(i % 50));
+  }
+  std::vector<V> out(column.size());
+  deaddev::select_if(column.data(), column.size(), predicate, a.data(), b.data(), out.data());
+  for (std::size_t i = 0; i < column.size(); ++i) {
+    ASSERT_EQ(out[i], predicate(column[i]) ? a[i] : b[i]);
+  }
+  // in place over b
+  deaddev::select_if(column.data(), column.size(), predicate, a.data(), b.data(), b.data());
+  ASSERT_EQ(b, out);
+}
+} // namespace
+
+TEST(algorithm, select) {
+  const auto rows = make_column(203);
+  check_select<std::int8_t>(rows, deaddev::has_all(algorithm_flag_bits::option_1_bit));
+  check_select<std::int16_t>(rows, deaddev::has_any(algorithm_flag_bits::option_0_bit |
+                                                    algorithm_flag_bits::option_2_bit));
+  check_select<float>(rows, deaddev::query(algorithm_flags(algorithm_flag_bits::option_0_bit),
+                                           algorithm_flags(algorithm_flag_bits::option_1_bit)));
+  check_select<double>(rows, deaddev::has_none(algorithm_flag_bits::option_2_bit));
+  check_select<std::int64_t>(rows, [](algorithm_flags row) {
+    return row == algorithm_flags(algorithm_flag_bits::option_0_bit);
+  });
+
+  std::vector<std::uint32_t> a(rows.size(), 7);
+  std::vector<std::uint32_t> b(rows.size(), 9);
+  std::vector<std::uint32_t> out(rows.size());
+  deaddev::select_by_flag(rows.data(), rows.size(), algorithm_flag_bits::option_2_bit, a.data(),
+                          b.data(), out.data());
+  ASSERT_EQ(out[3], 9u);
+  ASSERT_EQ(out[4], 7u);
+  deaddev::select_by_flag(rows.data(), rows.size(),
+                          algorithm_flag_bits::option_0_bit | algorithm_flag_bits::option_1_bit,
+                          a.data(), b.data(), out.data());
+  ASSERT_EQ(std::count(out.begin(), out.end(), 7u), 50);
+}
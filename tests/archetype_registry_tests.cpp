@@ -0,0 +1,188 @@
+#include <deaddev/archetype_registry.hpp>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace archetype_ns {
+enum class component_bits : uint8_t {
+  position_bit = 0x01,
+  velocity_bit = 0x02,
+  health_bit = 0x04,
+  name_bit = 0x08,
+  frozen_bit = 0x10,
+};
+DEADDEV_ENABLE_BITMASK(component_bits, component_bits::position_bit,
+                       component_bits::velocity_bit, component_bits::health_bit,
+                       component_bits::name_bit, component_bits::frozen_bit);
+} // namespace archetype_ns
+using component_bits = archetype_ns::component_bits;
+using components = deaddev::bitmask<component_bits>;
+
+namespace {
+struct position {
+  float x = 0;
+  float y = 0;
+};
+struct velocity {
+  float x = 0;
+  float y = 0;
+};
+struct health {
+  int points = 100;
+};
+
+using registry = deaddev::archetype_registry<components, 4, position, velocity, health, std::string>;
+
+constexpr auto moving = component_bits::position_bit | component_bits::velocity_bit;
+
+// runs every worker on its own thread
+struct thread_pool {
+  std::size_t size() const { return 3; }
+  template <typename F> void run(F &&function) {
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < size(); ++index) {
+      threads.emplace_back([&function, index] { function(index); });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+};
+} // namespace
+
+TEST(archetype_registry, create_get_destroy) {
+  registry entities;
+  std::vector<deaddev::entity> handles;
+  for (int i = 0; i < 11; ++i) {
+    handles.push_back(entities.create(moving | component_bits::name_bit));
+    entities.get<position>(handles.back())->x = static_cast<float>(i);
+    *entities.get<std::string>(handles.back()) = "entity " + std::to_string(i);
+  }
+  ASSERT_EQ(entities.size(), 11u);
+  ASSERT_EQ(entities.archetype_count(), 1u);
+  ASSERT_EQ(entities.get<health>(handles[0]), nullptr);
+  ASSERT_EQ(entities.get<velocity>(handles[3])->x, 0.0f);
+
+  // the last row moves into the holes, handles stay valid
+  ASSERT_TRUE(entities.destroy(handles[2]));
+  ASSERT_TRUE(entities.destroy(handles[5]));
+  ASSERT_FALSE(entities.destroy(handles[5]));
+  ASSERT_FALSE(entities.alive(handles[2]));
+  ASSERT_EQ(entities.get<position>(handles[2]), nullptr);
+  ASSERT_EQ(entities.archetype_size(0), 9u);
+  for (int i = 0; i < 11; ++i) {
+    if (i != 2 && i != 5) {
+      ASSERT_EQ(entities.get<position>(handles[i])->x, static_cast<float>(i));
+      ASSERT_EQ(*entities.get<std::string>(handles[i]), "entity " + std::to_string(i));
+    }
+  }
+
+  // slots are reused with a new generation
+  const auto reused = entities.create(component_bits::health_bit);
+  ASSERT_EQ(reused.index, handles[5].index);
+  ASSERT_NE(reused, handles[5]);
+  ASSERT_FALSE(entities.alive(handles[5]));
+  ASSERT_EQ(entities.get<health>(reused)->points, 100);
+  ASSERT_EQ(entities.signature(reused), components{component_bits::health_bit});
+}
+
+TEST(archetype_registry, change_moves_components) {
+  registry entities;
+  const auto first = entities.create(moving);
+  const auto second = entities.create(moving);
+  entities.get<position>(first)->y = 3;
+  entities.get<position>(second)->y = 4;
+  ASSERT_TRUE(entities.change(first, component_bits::position_bit | component_bits::name_bit));
+  ASSERT_EQ(entities.get<position>(first)->y, 3.0f);
+  ASSERT_EQ(entities.get<velocity>(first), nullptr);
+  ASSERT_TRUE(entities.get<std::string>(first)->empty());
+  ASSERT_EQ(entities.get<position>(second)->y, 4.0f);
+  ASSERT_EQ(entities.archetype_size(0), 1u);
+  ASSERT_EQ(entities.archetype_size(1), 1u);
+  ASSERT_TRUE(entities.destroy(second));
+  ASSERT_FALSE(entities.change(second, moving));
+}
+
+TEST(archetype_registry, cached_queries) {
+  registry entities;
+  entities.create(moving);
+  entities.create(moving | component_bits::frozen_bit);
+  entities.create(component_bits::position_bit);
+  const components none{};
+  ASSERT_EQ(entities.match(moving, component_bits::frozen_bit), std::vector<std::size_t>{0});
+  ASSERT_EQ(entities.match(component_bits::position_bit), (std::vector<std::size_t>{0, 1, 2}));
+  ASSERT_EQ(entities.match(none, moving), std::vector<std::size_t>{});
+  ASSERT_EQ(entities.cached_queries(), 3u);
+
+  // a new archetype extends the cached results, existing ones do not
+  entities.create(moving | component_bits::health_bit);
+  entities.create(moving);
+  ASSERT_EQ(entities.archetype_count(), 4u);
+  ASSERT_EQ(entities.match(moving, component_bits::frozen_bit),
+            (std::vector<std::size_t>{0, 3}));
+  ASSERT_EQ(entities.match(component_bits::position_bit),
+            (std::vector<std::size_t>{0, 1, 2, 3}));
+  ASSERT_EQ(entities.cached_queries(), 3u);
+
+  std::size_t rows = 0;
+  entities.for_each_chunk(moving, component_bits::frozen_bit, [&](const registry::chunk &chunk) {
+    ASSERT_NE(chunk.column<velocity>(), nullptr);
+    ASSERT_FALSE(chunk.signature().is_set(component_bits::frozen_bit));
+    rows += chunk.size();
+  });
+  ASSERT_EQ(rows, 3u);
+}
+
+TEST(archetype_registry, parallel_chunks) {
+  registry entities;
+  std::map<std::uint32_t, float> expected;
+  for (int i = 0; i < 101; ++i) {
+    auto signature = components{moving};
+    if (i % 3 == 0) {
+      signature |= component_bits::health_bit;
+    }
+    if (i % 7 == 0) {
+      signature |= component_bits::frozen_bit;
+    }
+    const auto handle = entities.create(signature);
+    entities.get<velocity>(handle)->x = static_cast<float>(i);
+    expected[handle.index] = i % 7 == 0 ? 0.0f : static_cast<float>(i);
+  }
+  thread_pool pool;
+  std::vector<std::size_t> chunks(pool.size());
+  entities.for_each_chunk_on(pool, moving, component_bits::frozen_bit,
+                             [&](const registry::chunk &chunk, std::size_t worker) {
+                               position *positions = chunk.column<position>();
+                               const velocity *velocities = chunk.column<velocity>();
+                               for (std::size_t row = 0; row < chunk.size(); ++row) {
+                                 positions[row].x += velocities[row].x;
+                               }
+                               ++chunks[worker];
+                             });
+  std::size_t total = 0;
+  for (const std::size_t count : chunks) {
+    total += count;
+  }
+  // 57 unfrozen rows without health and 29 with it, 4 rows per chunk
+  ASSERT_EQ(total, 15u + 8u);
+  for (const auto &item : expected) {
+    const deaddev::entity handle{item.first, 0};
+    ASSERT_EQ(entities.get<position>(handle)->x, item.second);
+  }
+}
+
+TEST(archetype_registry, wide_signature) {
+  using wide_components = deaddev::wide_bitmask<256>;
+  deaddev::archetype_registry<wide_components, 8, position, health> entities;
+  const auto tagged = entities.create(wide_components{0, 200});
+  const auto plain = entities.create(wide_components{1});
+  ASSERT_NE(entities.get<position>(tagged), nullptr);
+  ASSERT_EQ(entities.get<health>(tagged), nullptr);
+  ASSERT_NE(entities.get<health>(plain), nullptr);
+  ASSERT_EQ(entities.match(wide_components{200}), std::vector<std::size_t>{0});
+  ASSERT_EQ(entities.match(wide_components{}, wide_components{200}),
+            std::vector<std::size_t>{1});
+}
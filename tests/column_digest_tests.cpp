@@ -0,0 +1,117 @@
+#if defined(__unix__) || defined(__APPLE__)
+#include <deaddev/column_digest.hpp>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace column_digest_ns {
+enum class replica_bits : uint32_t {
+  option_0_bit = 0x00000001,
+  option_31_bit = 0x80000000,
+};
+DEADDEV_ENABLE_BITMASK(replica_bits, replica_bits::option_0_bit, replica_bits::option_31_bit);
+} // namespace column_digest_ns
+using replica_bits = column_digest_ns::replica_bits;
+using replica_flags = deaddev::bitmask<replica_bits>;
+using replica_digest = deaddev::column_digest<replica_bits>;
+
+namespace {
+std::vector<replica_flags> column(std::size_t count) {
+  std::vector<replica_flags> rows;
+  for (std::size_t i = 0; i < count; ++i) {
+    rows.emplace_back(static_cast<uint32_t>(i * 2654435761u));
+  }
+  return rows;
+}
+} // namespace
+
+TEST(column_digest, update_touches_one_path) {
+  auto rows = column(replica_digest::block_rows * 9 + 17);
+  replica_digest digest(rows.data(), rows.size());
+  ASSERT_EQ(digest.block_count(), 10u);
+  ASSERT_EQ(digest.levels(), 5u);
+  ASSERT_EQ(digest.block_length(9), 17u);
+  const replica_digest before = digest;
+  rows[replica_digest::block_rows * 4 + 3] ^= replica_bits::option_31_bit;
+  digest.update(rows.data(), replica_digest::block_rows * 4 + 3,
+                replica_digest::block_rows * 4 + 4);
+  ASSERT_EQ(digest.root(), replica_digest(rows.data(), rows.size()).root());
+  ASSERT_NE(digest.root(), before.root());
+  for (std::size_t block = 0; block < digest.block_count(); ++block) {
+    ASSERT_EQ(digest.node(0, block) != before.node(0, block), block == 4);
+  }
+  const replica_digest empty;
+  ASSERT_EQ(empty.block_count(), 1u);
+  ASSERT_EQ(empty.levels(), 1u);
+  ASSERT_EQ(empty.root(), replica_digest(rows.data(), 0).root());
+}
+
+TEST(column_digest, syncs_over_socketpair) {
+  const std::size_t count = replica_digest::block_rows * 300 + 5;
+  const auto source = column(count);
+  auto replica = source;
+  const std::size_t changed[] = {0, 77, 212, 300};
+  for (const auto block : changed) {
+    replica[block * replica_digest::block_rows] = replica_flags(0xDEADu);
+  }
+  int sockets[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    close(sockets[0]);
+    const replica_digest digest(source.data(), source.size());
+    _exit(deaddev::serve_column_sync(sockets[1], digest, source.data()) ? 0 : 1);
+  }
+  close(sockets[1]);
+  replica_digest digest(replica.data(), replica.size());
+  const auto result = deaddev::pull_column_sync(sockets[0], digest, replica.data());
+  ASSERT_TRUE(result.ok);
+  ASSERT_EQ(result.blocks, 4u);
+  // info, one exchange per level below the root, blocks
+  ASSERT_EQ(result.rounds, digest.levels() + 1);
+  ASSERT_EQ(replica, source);
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+  close(sockets[0]);
+}
+
+TEST(column_digest, rejects_other_shape) {
+  const auto source = column(1000);
+  auto replica = column(999);
+  int sockets[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    close(sockets[0]);
+    const replica_digest digest(source.data(), source.size());
+    _exit(deaddev::serve_column_sync(sockets[1], digest, source.data()) ? 0 : 1);
+  }
+  close(sockets[1]);
+  replica_digest digest(replica.data(), replica.size());
+  const auto result = deaddev::pull_column_sync(sockets[0], digest, replica.data());
+  ASSERT_FALSE(result.ok);
+  ASSERT_EQ(result.blocks, 0u);
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+  close(sockets[0]);
+}
+
+TEST(column_digest, closed_peer_fails_without_signal) {
+  const auto source = column(1000);
+  int sockets[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+  close(sockets[1]);
+  ASSERT_FALSE(deaddev::details::write_full(sockets[0], source.data(),
+                                            source.size() * sizeof(source[0])));
+  close(sockets[0]);
+}
+#endif
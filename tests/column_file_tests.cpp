@@ -0,0 +1,78 @@
+#if defined(__unix__) || defined(__APPLE__)
+#include <deaddev/column_file.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace column_file_ns {
+enum class column_bits : uint16_t {
+  option_0_bit = 0x0001,
+  option_3_bit = 0x0008,
+  option_9_bit = 0x0200,
+};
+DEADDEV_ENABLE_BITMASK(column_bits, column_bits::option_0_bit, column_bits::option_3_bit,
+                       column_bits::option_9_bit);
+} // namespace column_file_ns
+using column_bits = column_file_ns::column_bits;
+using column_flags = deaddev::bitmask<column_bits>;
+
+namespace {
+std::vector<column_flags> column(std::size_t count) {
+  std::vector<column_flags> rows;
+  for (std::size_t i = 0; i < count; ++i) {
+    rows.emplace_back(static_cast<uint16_t>(((i * 2654435761u) >> 7) & 0x0209));
+  }
+  return rows;
+}
+} // namespace
+
+TEST(column_file, round_trip) {
+  const auto rows = column(100003);
+  const std::string path = testing::TempDir() + "deaddev_column_round_trip.bin";
+  ASSERT_TRUE(deaddev::write_column(path.c_str(), rows.data(), rows.size()));
+  for (const bool use_io_uring : {true, false}) {
+    deaddev::column_load_options options;
+    options.chunk_bytes = 10000;
+    options.queue_depth = 4;
+    options.use_io_uring = use_io_uring;
+    std::size_t chunked = 0;
+    const auto loaded = deaddev::load_column<column_bits>(
+        path.c_str(), options, [&](column_flags *chunk, std::size_t count) {
+          chunked += count;
+          return deaddev::known_flags_validator<column_bits>{}(chunk, count);
+        });
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(chunked, rows.size());
+    ASSERT_FALSE(!use_io_uring && loaded.used_io_uring());
+    ASSERT_EQ(loaded.size(), rows.size());
+    ASSERT_TRUE(std::equal(loaded.begin(), loaded.end(), rows.begin()));
+  }
+  std::remove(path.c_str());
+}
+
+TEST(column_file, empty_and_rejected) {
+  const std::string path = testing::TempDir() + "deaddev_column_rejected.bin";
+  ASSERT_TRUE(deaddev::write_column<column_bits>(path.c_str(), nullptr, 0));
+  const auto empty = deaddev::load_column<column_bits>(path.c_str());
+  ASSERT_TRUE(empty);
+  ASSERT_EQ(empty.size(), 0u);
+
+  auto rows = column(5000);
+  rows[4321] = column_flags(static_cast<uint16_t>(0x8000));
+  ASSERT_TRUE(deaddev::write_column(path.c_str(), rows.data(), rows.size()));
+  ASSERT_EQ(deaddev::load_column<column_bits>(path.c_str()).error(),
+            deaddev::column_load_error::validation);
+
+  std::FILE *file = std::fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  std::fputc('X', file);
+  std::fclose(file);
+  ASSERT_EQ(deaddev::load_column<column_bits>(path.c_str()).error(),
+            deaddev::column_load_error::header);
+  ASSERT_EQ(deaddev::load_column<column_bits>((path + ".missing").c_str()).error(),
+            deaddev::column_load_error::open);
+  std::remove(path.c_str());
+}
+#endif
@@ -0,0 +1,151 @@
+#include <deaddev/bitmask_coroutine.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace coroutine_ns {
+enum class state_bits : uint8_t {
+  connected_bit = 0x01,
+  authenticated_bit = 0x02,
+  closed_bit = 0x80,
+};
+DEADDEV_ENABLE_BITMASK(state_bits, state_bits::connected_bit, state_bits::authenticated_bit,
+                       state_bits::closed_bit);
+} // namespace coroutine_ns
+using state_bits = coroutine_ns::state_bits;
+using states = deaddev::bitmask<state_bits>;
+
+namespace {
+/// eagerly started coroutine that nobody awaits
+struct detached {
+  struct promise_type {
+    detached get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+struct queue_executor {
+  void post(std::coroutine_handle<> handle) { handles.push_back(handle); }
+  void run() {
+    while (!handles.empty()) {
+      auto handle = handles.front();
+      handles.pop_front();
+      handle.resume();
+    }
+  }
+  std::deque<std::coroutine_handle<>> handles;
+};
+
+detached wait_all(deaddev::awaitable_bitmask<state_bits> &flags, states mask,
+                  std::atomic<int> &resumed) {
+  const states value = co_await flags.when_all(mask);
+  EXPECT_TRUE(value.is_set(mask));
+  ++resumed;
+}
+
+detached wait_record(deaddev::awaitable_bitmask<state_bits> &flags, states mask,
+                     std::vector<int> &order, int id) {
+  co_await flags.when_all(mask);
+  order.push_back(id);
+}
+
+detached wait_any(deaddev::awaitable_bitmask<state_bits> &flags, states mask,
+                  queue_executor &executor, std::atomic<int> &resumed) {
+  co_await flags.when_any(mask, executor);
+  ++resumed;
+}
+} // namespace
+
+TEST(coroutine, when_all_resumes_on_setter) {
+  deaddev::awaitable_bitmask<state_bits> flags;
+  std::atomic<int> resumed{0};
+  wait_all(flags, state_bits::connected_bit | state_bits::authenticated_bit, resumed);
+  ASSERT_EQ(resumed.load(), 0);
+  flags.set(state_bits::connected_bit);
+  ASSERT_EQ(resumed.load(), 0);
+  flags.set(state_bits::authenticated_bit);
+  ASSERT_EQ(resumed.load(), 1);
+  // already satisfied, does not suspend
+  wait_all(flags, state_bits::connected_bit, resumed);
+  ASSERT_EQ(resumed.load(), 2);
+}
+
+TEST(coroutine, when_any_resumes_on_executor) {
+  deaddev::awaitable_bitmask<state_bits> flags;
+  queue_executor executor;
+  std::atomic<int> resumed{0};
+  wait_any(flags, state_bits::closed_bit | state_bits::authenticated_bit, executor, resumed);
+  wait_any(flags, state_bits::connected_bit, executor, resumed);
+  flags.set(state_bits::closed_bit);
+  ASSERT_EQ(executor.handles.size(), 1u);
+  ASSERT_EQ(resumed.load(), 0);
+  executor.run();
+  ASSERT_EQ(resumed.load(), 1);
+  flags.remove(state_bits::closed_bit);
+  ASSERT_EQ(flags.load(), 0);
+  flags.set(state_bits::connected_bit);
+  executor.run();
+  ASSERT_EQ(resumed.load(), 2);
+}
+
+TEST(coroutine, set_skips_waiters_on_other_flags) {
+  // a set() that visits waiters files them again, which changes their resume order
+  const auto resume_order = [](bool set_other) {
+    deaddev::awaitable_bitmask<state_bits> flags;
+    std::vector<int> order;
+    std::atomic<int> resumed{0};
+    for (int id = 0; id < 4; ++id) {
+      wait_record(flags, state_bits::authenticated_bit, order, id);
+    }
+    wait_all(flags, state_bits::connected_bit, resumed);
+    if (set_other) {
+      flags.set(state_bits::connected_bit);
+      EXPECT_EQ(resumed.load(), 1);
+    }
+    flags.set(state_bits::authenticated_bit);
+    return order;
+  };
+  const auto untouched = resume_order(false);
+  ASSERT_EQ(untouched.size(), 4u);
+  ASSERT_EQ(resume_order(true), untouched);
+}
+
+TEST(coroutine, set_between_ready_and_suspend) {
+  deaddev::awaitable_bitmask<state_bits> flags;
+  std::atomic<int> resumed{0};
+  wait_all(flags, state_bits::closed_bit, resumed);
+  auto awaiter = flags.when_all(state_bits::connected_bit);
+  ASSERT_FALSE(awaiter.await_ready());
+  flags.set(state_bits::connected_bit);
+  // satisfied before suspending: continues without suspending and resumes nobody
+  ASSERT_FALSE(awaiter.await_suspend(std::noop_coroutine()));
+  ASSERT_TRUE(awaiter.await_resume().is_set(state_bits::connected_bit));
+  ASSERT_EQ(resumed.load(), 0);
+  flags.set(state_bits::closed_bit);
+  ASSERT_EQ(resumed.load(), 1);
+}
+
+TEST(coroutine, concurrent_setters) {
+  for (int round = 0; round < 200; ++round) {
+    deaddev::awaitable_bitmask<state_bits> flags;
+    std::atomic<int> resumed{0};
+    std::thread waiter([&] {
+      wait_all(flags, state_bits::connected_bit | state_bits::authenticated_bit, resumed);
+      wait_all(flags, state_bits::closed_bit, resumed);
+    });
+    std::thread first([&] { flags.set(state_bits::connected_bit); });
+    std::thread second([&] { flags.set(state_bits::authenticated_bit | state_bits::closed_bit); });
+    waiter.join();
+    first.join();
+    second.join();
+    ASSERT_EQ(resumed.load(), 2);
+  }
+}
@@ -0,0 +1,161 @@
+#if defined(__linux__)
+#include <deaddev/bitmask_aggregate.hpp>
+#include <deaddev/cpu_topology.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+namespace cpu_topology_ns {
+enum class task_bits : uint8_t {
+  option_0_bit = 0x01,
+  option_2_bit = 0x04,
+  option_6_bit = 0x40,
+};
+DEADDEV_ENABLE_BITMASK(task_bits, task_bits::option_0_bit, task_bits::option_2_bit,
+                       task_bits::option_6_bit);
+} // namespace cpu_topology_ns
+using task_bits = cpu_topology_ns::task_bits;
+using task_flags = deaddev::bitmask<task_bits>;
+
+namespace {
+void write_text(const std::string &path, const char *text) {
+  std::FILE *file = std::fopen(path.c_str(), "w");
+  ASSERT_NE(file, nullptr);
+  std::fputs(text, file);
+  std::fclose(file);
+}
+
+void make_directories(const std::string &path) {
+  for (std::size_t slash = path.find('/', 1); slash != std::string::npos;
+       slash = path.find('/', slash + 1)) {
+    ::mkdir(path.substr(0, slash).c_str(), 0755);
+  }
+  ::mkdir(path.c_str(), 0755);
+}
+
+// nodes 0 and 2, each one package of two cores with two SMT threads, cpu 5 offline
+std::string fake_sysfs() {
+  const std::string root = testing::TempDir() + "deaddev_cpu_topology";
+  const char *siblings[] = {"0,4", "1,5", "2,6", "3,7", "0,4", "1,5", "2,6", "3,7"};
+  const char *packages[] = {"0-1,4-5", "0-1,4-5", "2-3,6-7", "2-3,6-7",
+                            "0-1,4-5", "0-1,4-5", "2-3,6-7", "2-3,6-7"};
+  make_directories(root + "/cpu");
+  write_text(root + "/cpu/online", "0-4,6-7\n");
+  for (int cpu = 0; cpu < 8; ++cpu) {
+    const std::string topology = root + "/cpu/cpu" + std::to_string(cpu) + "/topology";
+    make_directories(topology);
+    write_text(topology + "/thread_siblings_list", siblings[cpu]);
+    write_text(topology + "/package_cpus_list", packages[cpu]);
+  }
+  make_directories(root + "/node/node0");
+  make_directories(root + "/node/node2");
+  write_text(root + "/node/online", "0,2\n");
+  write_text(root + "/node/node0/cpulist", "0-1,4-5\n");
+  write_text(root + "/node/node2/cpulist", "2-3,6-7\n");
+  return root;
+}
+} // namespace
+
+TEST(cpu_topology, parse_cpu_list) {
+  deaddev::cpu_mask cpus;
+  ASSERT_TRUE(deaddev::parse_cpu_list("0-3,8,10-11\n", cpus));
+  ASSERT_EQ(cpus, (deaddev::cpu_mask{0, 1, 2, 3, 8, 10, 11}));
+  ASSERT_TRUE(deaddev::parse_cpu_list(" \n", cpus));
+  ASSERT_TRUE(cpus.none());
+  cpus.set(1);
+  ASSERT_FALSE(deaddev::parse_cpu_list("3-1", cpus));
+  ASSERT_FALSE(deaddev::parse_cpu_list("0,x", cpus));
+  ASSERT_FALSE(deaddev::parse_cpu_list("4096", cpus));
+  ASSERT_EQ(cpus, deaddev::cpu_mask{1});
+}
+
+TEST(cpu_topology, fake_sysfs) {
+  const std::string root = fake_sysfs();
+  const auto topology = deaddev::cpu_topology::load(root + "/cpu", root + "/node");
+  ASSERT_TRUE(topology.ok());
+  ASSERT_EQ(topology.online(), (deaddev::cpu_mask{0, 1, 2, 3, 4, 6, 7}));
+  ASSERT_EQ(topology.core(6), (deaddev::cpu_mask{2, 6}));
+  ASSERT_EQ(topology.package(3), (deaddev::cpu_mask{2, 3, 6, 7}));
+  ASSERT_EQ(topology.core(5), deaddev::cpu_mask{5});
+  ASSERT_EQ(topology.node_count(), 2u);
+  ASSERT_EQ(topology.node_ids(), (deaddev::cpu_mask{0, 2}));
+  ASSERT_EQ(topology.node_of(7), 2u);
+  ASSERT_TRUE(topology.node(1).none());
+  ASSERT_EQ(topology.node_of(100), std::size_t{deaddev::cpu_topology::npos});
+
+  // physical cores of node 0 that are online, without their SMT siblings
+  const auto node0 = topology.node(0) & topology.online();
+  ASSERT_EQ(node0, (deaddev::cpu_mask{0, 1, 4}));
+  ASSERT_EQ(topology.one_per_core(node0), (deaddev::cpu_mask{0, 1}));
+  ASSERT_EQ(topology.one_per_core(topology.online()), (deaddev::cpu_mask{0, 1, 2, 3}));
+  ASSERT_EQ(topology.online() & ~topology.package(0), (deaddev::cpu_mask{2, 3, 6, 7}));
+
+  ASSERT_FALSE(deaddev::cpu_topology::load(root + "/missing").ok());
+}
+
+TEST(cpu_topology, system) {
+  const auto topology = deaddev::cpu_topology::load();
+  if (!topology.ok()) {
+    GTEST_SKIP() << "no sysfs";
+  }
+  const auto allowed = deaddev::current_affinity();
+  ASSERT_TRUE(allowed.any());
+  ASSERT_TRUE((allowed & ~topology.online()).none());
+  for (const std::size_t cpu : allowed) {
+    ASSERT_TRUE(topology.core(cpu).is_set(cpu));
+    ASSERT_TRUE((topology.core(cpu) & ~topology.package(cpu)).none());
+  }
+}
+
+TEST(pinned_worker_pool, runs_pinned) {
+  const auto allowed = deaddev::current_affinity();
+  deaddev::pinned_worker_pool pool(allowed);
+  ASSERT_EQ(pool.size(), allowed.count());
+  ASSERT_TRUE(pool.pinned());
+  std::vector<std::size_t> where(pool.size(), deaddev::max_cpus);
+  for (int round = 0; round < 3; ++round) {
+    pool.run([&](std::size_t index) {
+      const auto affinity = deaddev::current_affinity();
+      where[index] = affinity.count() == 1 ? affinity.find_first() : deaddev::max_cpus;
+    });
+    for (std::size_t index = 0; index < pool.size(); ++index) {
+      ASSERT_EQ(where[index], pool.cpu(index));
+    }
+  }
+  ASSERT_EQ(deaddev::current_affinity(), allowed);
+}
+
+TEST(pinned_worker_pool, unpinned_and_aggregate) {
+  deaddev::pinned_worker_pool pool{deaddev::cpu_mask{}};
+  ASSERT_EQ(pool.size(), 1u);
+  ASSERT_FALSE(pool.pinned());
+  std::atomic<int> calls{0};
+  pool.run([&](std::size_t) { ++calls; });
+  ASSERT_EQ(calls.load(), 1);
+
+  std::vector<task_flags> column;
+  for (std::size_t i = 0; i < 5003; ++i) {
+    column.emplace_back(static_cast<uint8_t>((i * 2654435761u) >> 11));
+  }
+  deaddev::pinned_worker_pool pinned(deaddev::current_affinity());
+  for (deaddev::pinned_worker_pool *workers : {&pool, &pinned}) {
+    deaddev::flag_counts<task_bits> expected;
+    expected.add(column.data(), column.size());
+    deaddev::flag_counts<task_bits> flags;
+    deaddev::mask_histogram<task_bits> histogram;
+    deaddev::aggregate_on(*workers, column.data(), column.size(), flags, histogram);
+    ASSERT_EQ(flags.rows(), column.size());
+    std::uint64_t histogram_rows = 0;
+    histogram.for_each([&](task_flags, std::uint64_t count) { histogram_rows += count; });
+    ASSERT_EQ(histogram_rows, column.size());
+    for (std::size_t bit = 0; bit < 8; ++bit) {
+      ASSERT_EQ(flags[bit], expected[bit]);
+    }
+  }
+}
+#endif
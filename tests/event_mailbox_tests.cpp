@@ -0,0 +1,72 @@
+#include <deaddev/event_mailbox.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace mailbox_ns {
+enum class event_bits : uint32_t {
+  readable_bit = 0x01,
+  writable_bit = 0x02,
+  timer_bit = 0x04,
+  stop_bit = 0x80000000,
+};
+DEADDEV_ENABLE_BITMASK(event_bits, event_bits::readable_bit, event_bits::writable_bit,
+                       event_bits::timer_bit, event_bits::stop_bit);
+} // namespace mailbox_ns
+using event_bits = mailbox_ns::event_bits;
+using events = deaddev::bitmask<event_bits>;
+
+TEST(event_mailbox, coalesces_and_drains_once) {
+  deaddev::event_mailbox<event_bits> mailbox;
+  ASSERT_EQ(mailbox.try_drain(), 0);
+  ASSERT_TRUE(mailbox.post(event_bits::readable_bit));
+  ASSERT_FALSE(mailbox.post(event_bits::readable_bit));
+  ASSERT_FALSE(mailbox.post(event_bits::timer_bit));
+  ASSERT_EQ(mailbox.pending(), event_bits::readable_bit | event_bits::timer_bit);
+  ASSERT_EQ(mailbox.drain(), event_bits::readable_bit | event_bits::timer_bit);
+  ASSERT_EQ(mailbox.try_drain(), 0);
+}
+
+TEST(event_mailbox, latest_payload_per_flag) {
+  deaddev::event_mailbox<event_bits, int> mailbox;
+  mailbox.post(event_bits::timer_bit, 1);
+  mailbox.post(event_bits::timer_bit, 2);
+  mailbox.post(event_bits::stop_bit, 7);
+  ASSERT_EQ(mailbox.drain(), event_bits::timer_bit | event_bits::stop_bit);
+  ASSERT_EQ(mailbox.payload(event_bits::timer_bit), 2);
+  ASSERT_EQ(mailbox.payload(event_bits::stop_bit), 7);
+}
+
+TEST(event_mailbox, consumer_sleeps_until_posted) {
+  constexpr int producers = 4;
+  constexpr int per_producer = 5000;
+  deaddev::event_mailbox<event_bits, int> mailbox;
+  std::atomic<int> done{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < producers; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < per_producer; ++j) {
+        mailbox.post(j % 2 == 0 ? event_bits::readable_bit : event_bits::writable_bit);
+      }
+      if (++done == producers) {
+        mailbox.post(event_bits::stop_bit, producers);
+      }
+    });
+  }
+  events seen;
+  for (;;) {
+    const events drained = mailbox.drain();
+    ASSERT_NE(drained, 0);
+    seen |= drained;
+    if (drained.is_set(event_bits::stop_bit)) {
+      break;
+    }
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(mailbox.payload(event_bits::stop_bit), producers);
+  ASSERT_TRUE(seen.is_set(event_bits::readable_bit | event_bits::writable_bit));
+}
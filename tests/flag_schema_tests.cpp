@@ -0,0 +1,75 @@
+#include <deaddev/bitmask_algorithm.hpp>
+#include <deaddev/flag_schema.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace flag_schema_ns {
+enum class tenant_bits : uint16_t {};
+DEADDEV_ENABLE_BITMASK(tenant_bits, static_cast<tenant_bits>(0xFFFF));
+} // namespace flag_schema_ns
+using tenant_bits = flag_schema_ns::tenant_bits;
+
+TEST(flag_schema, register_and_lookup) {
+  deaddev::flag_schema<tenant_bits> schema;
+  ASSERT_EQ(schema.add("beta_ui"), 0u);
+  ASSERT_EQ(schema.add("audit_log"), 1u);
+  ASSERT_EQ(schema.add("beta_ui"), schema.npos);
+  ASSERT_EQ(schema.add("bad name"), schema.npos);
+  ASSERT_EQ(schema.add(""), schema.npos);
+  ASSERT_EQ(schema.find("audit_log"), 1u);
+  ASSERT_TRUE(schema.freeze());
+  ASSERT_EQ(schema.add("late"), schema.npos);
+  ASSERT_EQ(schema.find("audit_log"), 1u);
+  ASSERT_EQ(schema.find("audit"), schema.npos);
+  ASSERT_EQ(schema.flag("beta_ui"), static_cast<tenant_bits>(1));
+  ASSERT_EQ(schema.name(1), "audit_log");
+  ASSERT_EQ(schema.all_flags(), 0x3);
+
+  deaddev::flag_schema<tenant_bits> full;
+  for (int i = 0; i < 16; ++i) {
+    ASSERT_EQ(full.add("flag_" + std::to_string(i)), static_cast<std::size_t>(i));
+  }
+  ASSERT_EQ(full.add("flag_16"), full.npos);
+  ASSERT_EQ(full.all_flags(), 0xFFFF);
+}
+
+TEST(flag_schema, perfect_hash) {
+  deaddev::flag_schema<> schema;
+  for (int i = 0; i < 64; ++i) {
+    ASSERT_EQ(schema.add("feature." + std::to_string(i * 7919)), static_cast<std::size_t>(i));
+  }
+  ASSERT_TRUE(schema.freeze());
+  for (int i = 0; i < 64; ++i) {
+    ASSERT_EQ(schema.find("feature." + std::to_string(i * 7919)), static_cast<std::size_t>(i));
+    ASSERT_EQ(schema.find("feature." + std::to_string(i * 7919 + 1)), schema.npos);
+  }
+}
+
+TEST(flag_schema, format_parse_and_kernels) {
+  deaddev::flag_schema<> schema;
+  schema.add("read");
+  schema.add("write");
+  schema.add("admin");
+  ASSERT_TRUE(schema.freeze());
+  using mask = deaddev::flag_schema<>::value_type;
+  const mask read_admin = schema.flag("read") | schema.flag("admin");
+  ASSERT_EQ(schema.format(read_admin), "read|admin");
+  ASSERT_EQ(schema.format(read_admin | mask(0x1F0u)), "read|admin|0x1f0");
+  ASSERT_EQ(schema.format(mask(0)), "");
+  mask parsed(0);
+  ASSERT_TRUE(schema.parse(" admin | read ", parsed));
+  ASSERT_EQ(parsed, read_admin);
+  ASSERT_TRUE(schema.parse(schema.format(read_admin | mask(0x1F0u)), parsed));
+  ASSERT_EQ(parsed, read_admin | mask(0x1F0u));
+  ASSERT_FALSE(schema.parse("read|owner", parsed));
+  ASSERT_EQ(parsed, read_admin | mask(0x1F0u));
+  ASSERT_TRUE(parsed.is_set(schema.flag("admin")));
+
+  std::vector<mask> rows;
+  for (int i = 0; i < 100; ++i) {
+    rows.push_back(i % 4 == 0 ? read_admin : mask(schema.flag("write")));
+  }
+  ASSERT_EQ(deaddev::count_if(rows.data(), rows.size(), deaddev::has_all(read_admin)), 25u);
+}
@@ -0,0 +1,68 @@
+#include <deaddev/hybrid_bitmask.hpp>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using hybrid_flags = deaddev::hybrid_bitmask<1000, std::size_t, 4>;
+using wide_flags = hybrid_flags::wide_type;
+
+TEST(hybrid_bitmask, switches_representation) {
+  hybrid_flags flags{900, 3, 64};
+  ASSERT_TRUE(flags.is_sparse());
+  ASSERT_EQ(std::vector<std::size_t>(flags.begin(), flags.end()),
+            (std::vector<std::size_t>{3, 64, 900}));
+  flags.set(3).set(999);
+  ASSERT_TRUE(flags.is_sparse());
+  flags.set(500);
+  ASSERT_FALSE(flags.is_sparse());
+  ASSERT_EQ(flags.count(), 5u);
+  ASSERT_EQ(flags.find_first(), 3u);
+  ASSERT_EQ(flags.find_next(65), 500u);
+  ASSERT_EQ(flags.find_last(), 999u);
+  hybrid_flags copy = flags;
+  flags.remove(64);
+  ASSERT_TRUE(flags.is_sparse());
+  ASSERT_EQ(flags, (hybrid_flags{3, 500, 900, 999}));
+  ASSERT_NE(flags, copy);
+  ASSERT_EQ(copy.to_wide().count(), 5u);
+  ASSERT_EQ(hybrid_flags(copy.to_wide()), copy);
+  hybrid_flags moved = std::move(copy);
+  ASSERT_TRUE(copy.none());
+  ASSERT_EQ(moved.count(), 5u);
+  ASSERT_TRUE(moved.clear().is_sparse());
+}
+
+TEST(hybrid_bitmask, matches_wide_bitmask) {
+  std::mt19937 random(7);
+  const auto make = [&random](wide_flags &wide) {
+    hybrid_flags hybrid;
+    const std::size_t count = random() % 3 == 0 ? random() % 40 : random() % 6;
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::size_t index = random() % 1000;
+      hybrid.set(index);
+      wide.set(index);
+    }
+    return hybrid;
+  };
+  for (int round = 0; round < 2000; ++round) {
+    wide_flags left_wide;
+    wide_flags right_wide;
+    const hybrid_flags left = make(left_wide);
+    const hybrid_flags right = make(right_wide);
+    ASSERT_EQ(left.count(), left_wide.count());
+    ASSERT_EQ(left.is_sparse(), left.count() <= hybrid_flags::inline_capacity);
+    ASSERT_EQ((left & right).to_wide(), left_wide & right_wide);
+    ASSERT_EQ((left | right).to_wide(), left_wide | right_wide);
+    ASSERT_EQ((left ^ right).to_wide(), left_wide ^ right_wide);
+    ASSERT_EQ(hybrid_flags(left).remove(right).to_wide(), wide_flags(left_wide).remove(right_wide));
+    ASSERT_EQ(left.intersects(right), left_wide.intersects(right_wide));
+    ASSERT_EQ(left.is_set(right), left_wide.is_set(right_wide));
+    ASSERT_EQ((left | right).is_set(right), true);
+    ASSERT_EQ(left == right, left_wide == right_wide);
+    const auto both = left & right;
+    ASSERT_EQ(both.is_sparse(), both.count() <= hybrid_flags::inline_capacity);
+    ASSERT_EQ(std::vector<std::size_t>(both.begin(), both.end()),
+              std::vector<std::size_t>(both.to_wide().begin(), both.to_wide().end()));
+  }
+}
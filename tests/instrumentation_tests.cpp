@@ -0,0 +1,90 @@
+#include <deaddev/bitmask_instrumentation.hpp>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace instrumentation_ns {
+enum class plain_bits : uint8_t {
+  option_0_bit = 0x01,
+  option_1_bit = 0x02,
+};
+DEADDEV_ENABLE_BITMASK(plain_bits, plain_bits::option_0_bit, plain_bits::option_1_bit);
+
+enum class traced_bits : uint16_t {
+  option_0_bit = 0x0001,
+  option_1_bit = 0x0002,
+  option_9_bit = 0x0200,
+};
+DEADDEV_ENABLE_BITMASK(traced_bits, traced_bits::option_0_bit, traced_bits::option_1_bit,
+                       traced_bits::option_9_bit);
+DEADDEV_INSTRUMENT_BITMASK(traced_bits, deaddev::sampled_flag_counters<traced_bits, 1>);
+
+enum class sampled_bits : uint32_t {
+  option_0_bit = 0x01,
+};
+DEADDEV_ENABLE_BITMASK(sampled_bits, sampled_bits::option_0_bit);
+DEADDEV_INSTRUMENT_BITMASK(sampled_bits, deaddev::sampled_flag_counters<sampled_bits, 8>);
+} // namespace instrumentation_ns
+using plain_bits = instrumentation_ns::plain_bits;
+using traced_bits = instrumentation_ns::traced_bits;
+using sampled_bits = instrumentation_ns::sampled_bits;
+
+namespace {
+// uninstrumented operations stay usable in constant expressions, no hook is instantiated
+constexpr bool plain_operations() {
+  deaddev::bitmask<plain_bits> mask;
+  mask.set(plain_bits::option_0_bit);
+  mask |= plain_bits::option_1_bit;
+  mask &= deaddev::bitmask<plain_bits>::all_flags();
+  mask.remove(plain_bits::option_0_bit);
+  return mask.is_set(plain_bits::option_1_bit) && !mask.is_set(plain_bits::option_0_bit);
+}
+static_assert(plain_operations(), "");
+static_assert(!deaddev::details::bitmask_instrumentation_traits<plain_bits>::enabled, "");
+static_assert(deaddev::details::bitmask_instrumentation_traits<traced_bits>::enabled, "");
+} // namespace
+
+TEST(instrumentation, counts_operations) {
+  using counters = deaddev::sampled_flag_counters<traced_bits, 1>;
+  counters::reset();
+  deaddev::bitmask<traced_bits> mask;
+  mask.set(traced_bits::option_0_bit);
+  mask.set(traced_bits::option_1_bit | traced_bits::option_9_bit);
+  mask.remove(traced_bits::option_9_bit);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(mask.is_set(traced_bits::option_1_bit));
+  }
+  mask ^= traced_bits::option_0_bit;
+  std::thread worker([] {
+    deaddev::bitmask<traced_bits> local;
+    local |= traced_bits::option_9_bit;
+    local &= traced_bits::option_9_bit;
+  });
+  worker.join();
+  const auto totals = counters::snapshot();
+  using operation = deaddev::bitmask_operation;
+  ASSERT_EQ(totals.count(operation::set, 0), 1u);
+  ASSERT_EQ(totals.count(operation::set, 1), 1u);
+  ASSERT_EQ(totals.count(operation::set, 9), 1u);
+  ASSERT_EQ(totals.count(operation::remove, 9), 1u);
+  ASSERT_EQ(totals.count(operation::test, 1), 5u);
+  ASSERT_EQ(totals.count(operation::xor_assign, 0), 1u);
+  // counters of the exited thread
+  ASSERT_EQ(totals.count(operation::or_assign, 9), 1u);
+  ASSERT_EQ(totals.count(operation::and_assign, 9), 1u);
+  ASSERT_EQ(totals.count(operation::test, 0), 0u);
+  counters::reset();
+  ASSERT_EQ(counters::snapshot().count(operation::test, 1), 0u);
+}
+
+TEST(instrumentation, samples) {
+  using counters = deaddev::sampled_flag_counters<sampled_bits, 8>;
+  deaddev::bitmask<sampled_bits> mask(sampled_bits::option_0_bit);
+  std::thread worker([&mask] {
+    for (int i = 0; i < 800; ++i) {
+      static_cast<void>(mask.is_set(sampled_bits::option_0_bit));
+    }
+  });
+  worker.join();
+  ASSERT_EQ(counters::snapshot().count(deaddev::bitmask_operation::test, 0), 800u);
+}
@@ -0,0 +1,34 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+import deaddev.bitmask;
+#include <deaddev/bitmask_macros.hpp>
+
+namespace module_ns {
+enum class module_bitmask_flag_bits : uint16_t {
+  option_0_bit = 0x01,
+  option_1_bit = 0x04,
+  option_2_bit = 0x08,
+};
+DEADDEV_ENABLE_BITMASK(module_bitmask_flag_bits, module_bitmask_flag_bits::option_0_bit,
+                       module_bitmask_flag_bits::option_1_bit,
+                       module_bitmask_flag_bits::option_2_bit);
+} // namespace module_ns
+using module_bitmask_flags = deaddev::bitmask<module_ns::module_bitmask_flag_bits>;
+
+enum class external_module_flag_bits : uint8_t { option_0_bit = 0x01, option_1_bit = 0x02 };
+DEADDEV_ENABLE_BITMASK_EXTERNAL(external_module_flag_bits,
+                                external_module_flag_bits::option_0_bit,
+                                external_module_flag_bits::option_1_bit);
+
+TEST(module, free_operators) {
+  module_bitmask_flags flags{module_ns::module_bitmask_flag_bits::option_1_bit |
+                             module_ns::module_bitmask_flag_bits::option_2_bit};
+  ASSERT_EQ(~flags, module_ns::module_bitmask_flag_bits::option_0_bit);
+  ASSERT_TRUE(flags.is_set(module_ns::module_bitmask_flag_bits::option_2_bit));
+}
+
+TEST(module, external_registration) {
+  deaddev::bitmask<external_module_flag_bits> flags{
+      external_module_flag_bits::option_0_bit};
+  ASSERT_EQ(~flags, external_module_flag_bits::option_1_bit);
+}
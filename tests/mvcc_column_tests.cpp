@@ -0,0 +1,84 @@
+#include <deaddev/mvcc_column.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace mvcc_ns {
+enum class row_bits : uint8_t {
+  visible_bit = 0x01,
+  dirty_bit = 0x02,
+};
+DEADDEV_ENABLE_BITMASK(row_bits, row_bits::visible_bit, row_bits::dirty_bit);
+} // namespace mvcc_ns
+using row_bits = mvcc_ns::row_bits;
+using row_flags = deaddev::bitmask<row_bits>;
+
+TEST(mvcc_column, snapshots_are_isolated) {
+  deaddev::mvcc_column<row_bits, 64> column(200);
+  const auto empty = column.read();
+  ASSERT_EQ(empty.epoch(), 1u);
+  ASSERT_EQ(empty.size(), 200u);
+  ASSERT_EQ(empty.block_count(), 4u);
+  ASSERT_EQ(empty.block_size(3), 8u);
+
+  column.set(5, row_bits::visible_bit);
+  column.set(6, row_bits::visible_bit | row_bits::dirty_bit);
+  column.push_back(row_bits::dirty_bit);
+  // not published yet
+  ASSERT_EQ(column.read().epoch(), 1u);
+  ASSERT_EQ(column.commit(), 2u);
+  const auto second = column.read();
+  column.remove(6, row_bits::dirty_bit);
+  column.commit();
+  const auto third = column.read();
+
+  ASSERT_EQ(empty.count_if(deaddev::has_any(row_bits::visible_bit | row_bits::dirty_bit)), 0u);
+  ASSERT_EQ(second.size(), 201u);
+  ASSERT_EQ(second[6], row_bits::visible_bit | row_bits::dirty_bit);
+  ASSERT_EQ(second.count_if(deaddev::has_all(row_bits::dirty_bit)), 2u);
+  ASSERT_EQ(third[6], row_bits::visible_bit);
+  ASSERT_EQ(third.count_if(deaddev::has_all(row_bits::dirty_bit)), 1u);
+  // only written blocks were copied
+  ASSERT_EQ(second.block_epoch(0), 2u);
+  ASSERT_EQ(third.block_epoch(0), 3u);
+  ASSERT_EQ(third.block_epoch(1), 1u);
+  ASSERT_EQ(third.block_data(1), empty.block_data(1));
+  ASSERT_EQ(third.block_data(3), second.block_data(3));
+}
+
+TEST(mvcc_column, shrink_clears_rows) {
+  deaddev::mvcc_column<row_bits, 64> column(10);
+  column.set(8, row_bits::visible_bit);
+  column.commit();
+  column.resize(5);
+  column.resize(10);
+  column.commit();
+  ASSERT_EQ(column.read()[8], 0);
+}
+
+TEST(mvcc_column, reader_sees_whole_commits) {
+  constexpr std::size_t rows = 1000;
+  deaddev::mvcc_column<row_bits, 128> column(rows);
+  std::atomic<bool> stop{false};
+  std::thread reader([&] {
+    while (!stop.load()) {
+      const auto view = column.read();
+      // the writer flips every row of an epoch together
+      const std::size_t visible = view.count_if(deaddev::has_all(row_bits::visible_bit));
+      EXPECT_TRUE(visible == 0 || visible == rows);
+    }
+  });
+  for (int round = 0; round < 100; ++round) {
+    for (std::size_t row = 0; row < rows; ++row) {
+      if (round % 2 == 0) {
+        column.set(row, row_bits::visible_bit);
+      } else {
+        column.remove(row, row_bits::visible_bit);
+      }
+    }
+    column.commit();
+  }
+  stop = true;
+  reader.join();
+}
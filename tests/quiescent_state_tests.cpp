@@ -0,0 +1,86 @@
+#include <deaddev/quiescent_state.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+struct node {
+  explicit node(std::atomic<int> &freed) : freed(freed) {}
+  ~node() { ++freed; }
+  std::atomic<int> &freed;
+  int value = 0;
+};
+} // namespace
+
+TEST(quiescent_state, period_waits_for_every_online_thread) {
+  deaddev::quiescent_state_tracker<> tracker;
+  auto first = tracker.register_thread();
+  auto second = tracker.register_thread();
+  ASSERT_TRUE(first && second);
+  ASSERT_NE(first.slot(), second.slot());
+  std::atomic<int> freed{0};
+  tracker.retire(new node(freed));
+  ASSERT_EQ(tracker.period(), 1u);
+  tracker.quiescent(first);
+  tracker.quiescent(first);
+  ASSERT_EQ(freed.load(), 0);
+  // retired during the period, batched into the next one
+  tracker.retire(new node(freed));
+  tracker.retire(new node(freed));
+  tracker.quiescent(second);
+  ASSERT_EQ(freed.load(), 1);
+  ASSERT_EQ(tracker.period(), 2u);
+  // unregistering is a quiescent point
+  first.reset();
+  ASSERT_EQ(freed.load(), 1);
+  tracker.quiescent(second);
+  ASSERT_EQ(freed.load(), 3);
+  ASSERT_EQ(tracker.pending(), 0u);
+}
+
+TEST(quiescent_state, no_online_threads_and_slot_limit) {
+  deaddev::quiescent_state_tracker<2> tracker;
+  std::atomic<int> freed{0};
+  tracker.retire(new node(freed));
+  ASSERT_EQ(freed.load(), 1);
+  auto first = tracker.register_thread();
+  auto second = tracker.register_thread();
+  auto third = tracker.register_thread();
+  ASSERT_FALSE(third);
+  second.reset();
+  second = tracker.register_thread();
+  ASSERT_TRUE(second);
+}
+
+TEST(quiescent_state, readers_never_see_freed_nodes) {
+  constexpr int readers = 3;
+  deaddev::quiescent_state_tracker<> tracker;
+  std::atomic<int> freed{0};
+  std::atomic<node *> shared{new node(freed)};
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < readers; ++i) {
+    threads.emplace_back([&] {
+      auto handle = tracker.register_thread();
+      while (!stop.load()) {
+        node *current = shared.load(std::memory_order_acquire);
+        EXPECT_GE(current->value, 0);
+        tracker.quiescent(handle);
+      }
+    });
+  }
+  for (int i = 0; i < 2000; ++i) {
+    auto *replacement = new node(freed);
+    replacement->value = i;
+    tracker.retire(shared.exchange(replacement, std::memory_order_acq_rel));
+  }
+  stop = true;
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(tracker.pending(), 0u);
+  ASSERT_EQ(freed.load(), 2000);
+  delete shared.load();
+}
@@ -0,0 +1,87 @@
+#include <deaddev/range_index.hpp>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace range_index_ns {
+enum class row_bits : uint16_t {
+  option_0_bit = 0x0001,
+  option_2_bit = 0x0004,
+  option_7_bit = 0x0080,
+  option_15_bit = 0x8000,
+};
+DEADDEV_ENABLE_BITMASK(row_bits, row_bits::option_0_bit, row_bits::option_2_bit,
+                       row_bits::option_7_bit, row_bits::option_15_bit);
+} // namespace range_index_ns
+using row_bits = range_index_ns::row_bits;
+using row_flags = deaddev::bitmask<row_bits>;
+
+TEST(range_index, small_ranges) {
+  const std::vector<row_flags> rows{row_bits::option_0_bit,
+                                    row_bits::option_0_bit | row_bits::option_2_bit,
+                                    row_bits::option_0_bit | row_bits::option_15_bit};
+  const deaddev::range_index<row_bits, 2> index(rows.data(), rows.size());
+  ASSERT_EQ(index.range_or(0, 3),
+            row_bits::option_0_bit | row_bits::option_2_bit | row_bits::option_15_bit);
+  ASSERT_EQ(index.range_and(0, 3), row_bits::option_0_bit);
+  ASSERT_EQ(index.range_and(1, 1), row_flags::all_flags());
+  ASSERT_EQ(index.range_or(2, 2), 0);
+  ASSERT_EQ(index.range_count(row_bits::option_0_bit, 0, 3), 3u);
+  ASSERT_EQ(index.range_count(row_bits::option_15_bit, 0, 2), 0u);
+  ASSERT_EQ(deaddev::range_index<row_bits>().range_or(0, 0), 0);
+}
+
+TEST(range_index, unregistered_flag_counts_nothing) {
+  const std::vector<row_flags> rows(5, row_flags(static_cast<uint16_t>(0xFFFF)));
+  const deaddev::range_index<row_bits, 2> index(rows.data(), rows.size());
+  ASSERT_EQ(index.range_count(row_bits::option_7_bit, 0, 5), 5u);
+  // below a registered flag and above the last one
+  for (const auto flag : {static_cast<row_bits>(0x0002), static_cast<row_bits>(0x4000)}) {
+#ifdef NDEBUG
+    ASSERT_EQ(index.range_count(flag, 0, 5), 0u);
+#else
+    ASSERT_DEATH(static_cast<void>(index.range_count(flag, 0, 5)), "registered flag");
+#endif
+  }
+}
+
+TEST(range_index, matches_scan_under_updates) {
+  const row_bits flags[] = {row_bits::option_0_bit, row_bits::option_2_bit,
+                            row_bits::option_7_bit, row_bits::option_15_bit};
+  std::mt19937 random(11);
+  const auto random_mask = [&random] {
+    return row_flags(static_cast<uint16_t>(random() & random() & 0x8085));
+  };
+  std::vector<row_flags> rows(5003);
+  for (auto &row : rows) {
+    row = random_mask();
+  }
+  deaddev::range_index<row_bits> index(rows.data(), rows.size());
+  for (int round = 0; round < 3000; ++round) {
+    const std::size_t row = random() % rows.size();
+    rows[row] = random_mask();
+    index.set(row, rows[row]);
+    std::size_t first = random() % (rows.size() + 1);
+    std::size_t last = random() % (rows.size() + 1);
+    if (first > last) {
+      std::swap(first, last);
+    }
+    row_flags any(0);
+    row_flags every = row_flags::all_flags();
+    std::size_t counts[4] = {};
+    for (std::size_t i = first; i < last; ++i) {
+      any |= rows[i];
+      every &= rows[i];
+      for (int flag = 0; flag < 4; ++flag) {
+        counts[flag] += rows[i].is_set(flags[flag]);
+      }
+    }
+    ASSERT_EQ(index.range_or(first, last), any);
+    ASSERT_EQ(index.range_and(first, last), every);
+    for (int flag = 0; flag < 4; ++flag) {
+      ASSERT_EQ(index.range_count(flags[flag], first, last), counts[flag]);
+    }
+  }
+  ASSERT_EQ(index[17], rows[17]);
+}
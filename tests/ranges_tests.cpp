@@ -0,0 +1,84 @@
+#include <deaddev/bitmask_ranges.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ranges>
+#include <vector>
+
+namespace ranges_ns {
+enum class ranges_flag_bits : uint8_t {
+  option_0_bit = 0x01,
+  option_1_bit = 0x02,
+  option_2_bit = 0x04,
+  option_7_bit = 0x80,
+};
+DEADDEV_ENABLE_BITMASK(ranges_flag_bits, ranges_flag_bits::option_0_bit,
+                       ranges_flag_bits::option_1_bit, ranges_flag_bits::option_2_bit,
+                       ranges_flag_bits::option_7_bit);
+} // namespace ranges_ns
+using ranges_flag_bits = ranges_ns::ranges_flag_bits;
+using ranges_flags = deaddev::bitmask<ranges_flag_bits>;
+
+static_assert(std::ranges::forward_range<deaddev::set_flags_view<ranges_flag_bits>>);
+static_assert(std::ranges::view<
+              decltype(std::declval<std::vector<ranges_flags> &>() |
+                       deaddev::views::where(deaddev::has_all(ranges_flags{})))>);
+
+TEST(ranges, set_flags) {
+  std::vector<ranges_flag_bits> flags;
+  for (const ranges_flag_bits flag : deaddev::views::set_flags(
+           ranges_flags(ranges_flag_bits::option_7_bit | ranges_flag_bits::option_1_bit))) {
+    flags.push_back(flag);
+  }
+  ASSERT_EQ(flags, (std::vector<ranges_flag_bits>{ranges_flag_bits::option_1_bit,
+                                                  ranges_flag_bits::option_7_bit}));
+  ASSERT_EQ(deaddev::views::set_flags(ranges_flags{}).size(), 0u);
+}
+
+TEST(ranges, where) {
+  std::vector<ranges_flags> column;
+  for (std::size_t i = 0; i < 300; ++i) {
+    column.emplace_back(static_cast<uint8_t>(i % 200 == 7 || i == 299 ? 0x84 : i % 4));
+  }
+  std::vector<std::size_t> indices;
+  for (const std::size_t index :
+       column | deaddev::views::where_indices(
+                    deaddev::has_all(ranges_flag_bits::option_2_bit))) {
+    indices.push_back(index);
+  }
+  ASSERT_EQ(indices, (std::vector<std::size_t>{7, 207, 299}));
+
+  auto counted = column | deaddev::views::where(deaddev::has_any(ranges_flags(0x84))) |
+                 std::views::transform([](ranges_flags row) { return row == 0x84; });
+  ASSERT_EQ(std::ranges::count(counted, true), 3);
+  ASSERT_TRUE(std::ranges::empty(
+      column | deaddev::views::where([](ranges_flags row) { return row == 0x80; })));
+}
+
+TEST(ranges, where_with_capturing_lambda) {
+  std::vector<ranges_flags> column;
+  for (std::size_t i = 0; i < 200; ++i) {
+    column.emplace_back(static_cast<uint8_t>(i % 8));
+  }
+  const ranges_flags want(0x05);
+  auto view = column | deaddev::views::where([want](ranges_flags row) { return row == want; });
+  static_assert(std::ranges::view<decltype(view)>);
+  auto copy = view;
+  copy = view;
+  auto indices = column | deaddev::views::where_indices([want](ranges_flags row) {
+                   return row == want;
+                 }) |
+                 std::views::transform([](std::size_t index) { return index / 8; });
+  ASSERT_EQ(std::ranges::distance(copy), 25);
+  ASSERT_TRUE(std::ranges::equal(indices, std::views::iota(std::size_t{0}, std::size_t{25})));
+}
+
+TEST(ranges, masked) {
+  const std::vector<ranges_flags> column{ranges_flags(0x83), ranges_flags(0x05)};
+  std::vector<ranges_flags> masked;
+  for (const ranges_flags row : column | deaddev::views::masked(ranges_flag_bits::option_0_bit |
+                                                                ranges_flag_bits::option_7_bit)) {
+    masked.push_back(row);
+  }
+  ASSERT_EQ(masked, (std::vector<ranges_flags>{ranges_flags(0x81), ranges_flags(0x01)}));
+}
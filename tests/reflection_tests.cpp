@@ -0,0 +1,41 @@
+#include <deaddev/bitmask_reflection.hpp>
+#include <gtest/gtest.h>
+
+namespace reflection_ns {
+enum class reflected_flag_bits : uint16_t {
+  option_0_bit = 0x01,
+  option_1_bit = 0x04,
+  option_2_bit = 0x08,
+  option_3_bit = 0x8000,
+  options_0_1 = option_0_bit | option_1_bit,
+};
+DEADDEV_ENABLE_BITMASK_REFLECTED(reflected_flag_bits);
+} // namespace reflection_ns
+using reflected_flags = deaddev::bitmask<reflection_ns::reflected_flag_bits>;
+
+enum unscoped_reflected_flag_bits : uint8_t {
+  UNSCOPED_OPTION_0_BIT = 0x02,
+  UNSCOPED_OPTION_1_BIT = 0x80,
+};
+DEADDEV_ENABLE_BITMASK_REFLECTED_EXTERNAL(unscoped_reflected_flag_bits);
+
+static_assert(deaddev::reflected_flags<reflection_ns::reflected_flag_bits>::count == 4, "");
+static_assert(deaddev::reflected_all_flags<unscoped_reflected_flag_bits>() == 0x82, "");
+
+TEST(reflection, all_flags) {
+  ASSERT_EQ(reflected_flags::all_flags(), 0x800D);
+  reflected_flags flags{reflection_ns::reflected_flag_bits::option_1_bit};
+  ASSERT_EQ(~flags, reflection_ns::reflected_flag_bits::option_0_bit |
+                        reflection_ns::reflected_flag_bits::option_2_bit |
+                        reflection_ns::reflected_flag_bits::option_3_bit);
+}
+
+TEST(reflection, flag_name) {
+  ASSERT_EQ(deaddev::flag_name(reflection_ns::reflected_flag_bits::option_2_bit),
+            "option_2_bit");
+  ASSERT_EQ(deaddev::flag_name(reflection_ns::reflected_flag_bits::option_3_bit),
+            "option_3_bit");
+  ASSERT_EQ(deaddev::flag_name(reflection_ns::reflected_flag_bits::options_0_1), "");
+  ASSERT_EQ(deaddev::flag_name(static_cast<reflection_ns::reflected_flag_bits>(0x02)), "");
+  ASSERT_EQ(deaddev::flag_name(UNSCOPED_OPTION_1_BIT), "UNSCOPED_OPTION_1_BIT");
+}
@@ -0,0 +1,109 @@
+#include <deaddev/role_graph.hpp>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace role_graph_ns {
+enum class permission_bits : uint32_t {
+  read_bit = 0x01,
+  write_bit = 0x02,
+  delete_bit = 0x04,
+  admin_bit = 0x80000000,
+};
+DEADDEV_ENABLE_BITMASK(permission_bits, permission_bits::read_bit, permission_bits::write_bit,
+                       permission_bits::delete_bit, permission_bits::admin_bit);
+} // namespace role_graph_ns
+using permission_bits = role_graph_ns::permission_bits;
+using permissions = deaddev::bitmask<permission_bits>;
+using roles = deaddev::role_graph<permission_bits>;
+
+TEST(role_graph, diamond) {
+  roles graph;
+  const auto viewer = graph.add_role(permission_bits::read_bit);
+  const auto editor = graph.add_role(permission_bits::write_bit);
+  const auto moderator = graph.add_role(permission_bits::delete_bit);
+  const auto admin = graph.add_role(permission_bits::admin_bit);
+  ASSERT_TRUE(graph.add_parent(editor, viewer));
+  ASSERT_TRUE(graph.add_parent(moderator, viewer));
+  ASSERT_TRUE(graph.add_parent(admin, editor));
+  ASSERT_TRUE(graph.add_parent(admin, moderator));
+  ASSERT_FALSE(graph.add_parent(admin, editor));
+  ASSERT_FALSE(graph.add_parent(viewer, admin));
+  ASSERT_FALSE(graph.add_parent(viewer, viewer));
+  ASSERT_EQ(graph.effective(admin), permissions::all_flags());
+  ASSERT_EQ(graph.effective(editor), permission_bits::read_bit | permission_bits::write_bit);
+
+  // viewer, editor and moderator change
+  ASSERT_EQ(graph.set_permissions(viewer, permission_bits::read_bit | permission_bits::admin_bit),
+            3u);
+  ASSERT_EQ(graph.effective(moderator),
+            permission_bits::read_bit | permission_bits::delete_bit | permission_bits::admin_bit);
+  // admin already had every flag
+  ASSERT_EQ(graph.effective(admin), permissions::all_flags());
+  // editor already inherits the flag, nothing below changes
+  ASSERT_EQ(graph.set_permissions(editor, permission_bits::write_bit | permission_bits::read_bit),
+            0u);
+  ASSERT_TRUE(graph.remove_parent(moderator, viewer));
+  ASSERT_FALSE(graph.remove_parent(moderator, viewer));
+  ASSERT_EQ(graph.effective(moderator), permission_bits::delete_bit);
+}
+
+TEST(role_graph, matches_closure) {
+  std::mt19937 random(5);
+  roles graph;
+  std::vector<uint32_t> own;
+  for (int i = 0; i < 200; ++i) {
+    own.push_back(1u << (random() % 32));
+    graph.add_role(permissions(own.back()));
+  }
+  const auto closure = [&](roles::role_id role) {
+    std::vector<char> seen(graph.size(), 0);
+    std::vector<roles::role_id> stack{role};
+    uint32_t mask = 0;
+    while (!stack.empty()) {
+      const auto current = stack.back();
+      stack.pop_back();
+      if (seen[current]) {
+        continue;
+      }
+      seen[current] = 1;
+      mask |= own[current];
+      for (const auto parent : graph.parents(current)) {
+        stack.push_back(parent);
+      }
+    }
+    return permissions(mask);
+  };
+  for (int round = 0; round < 600; ++round) {
+    const auto role = static_cast<roles::role_id>(random() % graph.size());
+    const auto other = static_cast<roles::role_id>(random() % graph.size());
+    switch (random() % 3) {
+    case 0:
+      static_cast<void>(graph.add_parent(role, other));
+      break;
+    case 1:
+      static_cast<void>(graph.remove_parent(role, other));
+      break;
+    default:
+      own[role] = 1u << (random() % 32);
+      graph.set_permissions(role, permissions(own[role]));
+    }
+    if (round % 50 == 0) {
+      for (roles::role_id check = 0; check < graph.size(); ++check) {
+        ASSERT_EQ(graph.effective(check), closure(check));
+      }
+    }
+  }
+
+  std::vector<roles::role_id> users;
+  for (int i = 0; i < 1000; ++i) {
+    users.push_back(static_cast<roles::role_id>(random() % graph.size()));
+  }
+  std::vector<uint64_t> words((users.size() + 63) / 64);
+  const auto required = permissions(permission_bits::read_bit);
+  graph.match_words(users.data(), users.size(), deaddev::has_all(required), words.data());
+  for (std::size_t i = 0; i < users.size(); ++i) {
+    ASSERT_EQ((words[i / 64] >> (i % 64)) & 1u, closure(users[i]).is_set(required) ? 1u : 0u);
+  }
+}
@@ -0,0 +1,84 @@
+#include <deaddev/run_queue.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+struct task : deaddev::run_queue_node {
+  int id = 0;
+};
+} // namespace
+
+TEST(run_queue, highest_level_first_fifo_within_level) {
+  std::vector<task> tasks(5);
+  for (int i = 0; i < 5; ++i) {
+    tasks[i].id = i;
+  }
+  deaddev::priority_run_queue<64> queue;
+  queue.push(tasks[0], 3);
+  queue.push(tasks[1], 63);
+  queue.push(tasks[2], 3);
+  queue.push(tasks[3], 0);
+  queue.push(tasks[4], 63);
+  ASSERT_EQ(queue.top_level(), 63u);
+  std::vector<int> order;
+  while (auto *node = queue.pop()) {
+    order.push_back(static_cast<task *>(node)->id);
+  }
+  ASSERT_EQ(order, (std::vector<int>{1, 4, 0, 2, 3}));
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(queue.top_level(), (deaddev::priority_run_queue<64>::npos));
+}
+
+TEST(run_queue, remove_and_wide_levels) {
+  std::vector<task> tasks(3);
+  deaddev::priority_run_queue<200> queue;
+  queue.push(tasks[0], 150);
+  queue.push(tasks[1], 150);
+  queue.push(tasks[2], 10);
+  queue.remove(tasks[0], 150);
+  ASSERT_EQ(queue.pop(), &tasks[1]);
+  ASSERT_FALSE(queue.occupancy().is_set(150));
+  ASSERT_EQ(queue.pop(), &tasks[2]);
+  ASSERT_EQ(queue.pop(), nullptr);
+}
+
+TEST(run_queue, per_cpu_steals_highest_priority) {
+  std::vector<task> tasks(3);
+  deaddev::per_cpu_run_queue<64> queues(3);
+  queues.push(1, tasks[0], 5);
+  queues.push(2, tasks[1], 40);
+  queues.push(2, tasks[2], 1);
+  ASSERT_EQ(queues.pop(0), &tasks[1]);
+  ASSERT_EQ(queues.pop(0), &tasks[0]);
+  ASSERT_EQ(queues.pop(0), &tasks[2]);
+  ASSERT_EQ(queues.pop(0), nullptr);
+}
+
+TEST(run_queue, per_cpu_concurrent) {
+  constexpr std::size_t cpus = 4;
+  constexpr std::size_t per_cpu = 2000;
+  std::vector<task> tasks(cpus * per_cpu);
+  deaddev::per_cpu_run_queue<64> queues(cpus);
+  std::atomic<std::size_t> popped{0};
+  std::vector<std::thread> threads;
+  for (std::size_t cpu = 0; cpu < cpus; ++cpu) {
+    threads.emplace_back([&, cpu] {
+      for (std::size_t i = 0; i < per_cpu; ++i) {
+        queues.push(cpu, tasks[cpu * per_cpu + i], i % 64);
+        if (i % 2 == 0 && queues.pop(cpu) != nullptr) {
+          ++popped;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  while (queues.pop(0) != nullptr) {
+    ++popped;
+  }
+  ASSERT_EQ(popped.load(), cpus * per_cpu);
+}
@@ -0,0 +1,79 @@
+#if defined(__linux__)
+#include <deaddev/shared_bitmask.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace shared_ns {
+enum class worker_bits : uint16_t {
+  start_bit = 0x0001,
+  ready_bit = 0x0002,
+  stop_bit = 0x8000,
+};
+DEADDEV_ENABLE_BITMASK(worker_bits, worker_bits::start_bit, worker_bits::ready_bit,
+                       worker_bits::stop_bit);
+enum class other_bits : uint32_t {
+  any_bit = 0x01,
+};
+DEADDEV_ENABLE_BITMASK(other_bits, other_bits::any_bit);
+} // namespace shared_ns
+using worker_bits = shared_ns::worker_bits;
+using other_bits = shared_ns::other_bits;
+
+TEST(shared_bitmask, attach_checks_layout) {
+  alignas(64) unsigned char memory[128] = {};
+  using flags = deaddev::shared_bitmask<worker_bits>;
+  ASSERT_EQ(flags::attach(memory, sizeof(memory)), nullptr);
+  ASSERT_EQ(flags::create(memory, 16), nullptr);
+  ASSERT_EQ(flags::create(memory + 8, 120), nullptr);
+  auto *created = flags::create(memory, sizeof(memory));
+  ASSERT_NE(created, nullptr);
+  ASSERT_EQ(flags::attach(memory, sizeof(memory)), created);
+  // another mask size
+  ASSERT_EQ(deaddev::shared_bitmask<other_bits>::attach(memory, sizeof(memory)), nullptr);
+  created->set(worker_bits::stop_bit);
+  ASSERT_EQ(created->load(), worker_bits::stop_bit);
+  ASSERT_TRUE(created->wait_any_for(worker_bits::stop_bit, std::chrono::milliseconds(1)));
+  ASSERT_FALSE(created->wait_all_for(worker_bits::stop_bit | worker_bits::ready_bit,
+                                     std::chrono::milliseconds(5)));
+  created->remove(worker_bits::stop_bit);
+  ASSERT_EQ(created->load(), 0);
+}
+
+TEST(shared_bitmask, wakes_other_process) {
+  const int fd = memfd_create("deaddev_shared_bitmask", 0);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(ftruncate(fd, 4096), 0);
+  void *memory = mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ASSERT_NE(memory, MAP_FAILED);
+  auto *flags = deaddev::shared_bitmask<worker_bits>::create(memory, 4096);
+  ASSERT_NE(flags, nullptr);
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // separate mapping of the same segment
+    void *view = mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    auto *worker = deaddev::shared_bitmask<worker_bits>::attach(view, 4096);
+    if (worker == nullptr) {
+      _exit(1);
+    }
+    worker->wait_any(worker_bits::start_bit);
+    worker->set(worker_bits::ready_bit);
+    _exit(worker->wait_any_for(worker_bits::stop_bit, std::chrono::seconds(10)) ? 0 : 2);
+  }
+  flags->set(worker_bits::start_bit);
+  ASSERT_TRUE(flags->wait_all_for(worker_bits::start_bit | worker_bits::ready_bit,
+                                  std::chrono::seconds(10)));
+  flags->set(worker_bits::stop_bit);
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+  munmap(memory, 4096);
+  close(fd);
+}
+#endif
@@ -116,4 +116,27 @@ TEST(scoped_enum, bitwise_negation) {
   scoped_bitmask_flags flags{scoped_bitmask_flag_bits::option_1_bit |
                              scoped_bitmask_flag_bits::option_2_bit};
   ASSERT_EQ(~flags, scoped_bitmask_flag_bits::option_0_bit);
-}
\ No newline at end of file
+}
+namespace external_ns {
+enum class external_bitmask_flag_bits : uint8_t {
+  option_0_bit = 0x01,
+  option_1_bit = 0x02,
+};
+} // namespace external_ns
+DEADDEV_ENABLE_BITMASK_EXTERNAL(external_ns::external_bitmask_flag_bits,
+                                external_ns::external_bitmask_flag_bits::option_0_bit,
+                                external_ns::external_bitmask_flag_bits::option_1_bit);
+using external_bitmask_flags = deaddev::bitmask<external_ns::external_bitmask_flag_bits>;
+
+static_assert(deaddev::details::is_bitmask_v<simple_bitmask_flag_bits>, "");
+static_assert(deaddev::details::is_bitmask_v<external_ns::external_bitmask_flag_bits>, "");
+static_assert(!deaddev::details::is_bitmask_v<int>, "");
+static_assert(!deaddev::details::is_bitmask_v<simple_bitmask_flags>, "");
+
+TEST(external_enum, bitwise_negation) {
+  external_bitmask_flags flags{external_ns::external_bitmask_flag_bits::option_1_bit};
+  ASSERT_EQ(~flags, external_ns::external_bitmask_flag_bits::option_0_bit);
+  ASSERT_EQ(external_bitmask_flags::all_flags(),
+            external_ns::external_bitmask_flag_bits::option_0_bit |
+                external_ns::external_bitmask_flag_bits::option_1_bit);
+}
@@ -0,0 +1,145 @@
+#include <deaddev/timing_wheel.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+struct timer : deaddev::timer_node {
+  int id = 0;
+  std::uint64_t stamp = 0;
+};
+} // namespace
+
+TEST(timing_wheel, expires_in_order_across_levels) {
+  std::vector<timer> timers(5);
+  deaddev::timing_wheel<3> wheel;
+  const std::uint64_t expires[] = {5, 64, 4100, 63, 300000};
+  for (int i = 0; i < 5; ++i) {
+    timers[i].id = i;
+    wheel.schedule(timers[i], expires[i]);
+  }
+  ASSERT_EQ(wheel.size(), 5u);
+  ASSERT_EQ(wheel.next_event(), 5u);
+  std::vector<int> order;
+  const auto expired = wheel.advance(5000, [&](deaddev::timer_node &node) {
+    order.push_back(static_cast<timer &>(node).id);
+    static_cast<timer &>(node).stamp = wheel.now();
+  });
+  ASSERT_EQ(expired, 4u);
+  ASSERT_EQ(order, (std::vector<int>{0, 3, 1, 2}));
+  ASSERT_EQ(timers[2].stamp, 4100u);
+  ASSERT_EQ(wheel.now(), 5001u);
+  // beyond 64^3 ticks, waits in overflow
+  ASSERT_EQ(wheel.advance(299999, [](deaddev::timer_node &) {}), 0u);
+  ASSERT_EQ(wheel.advance(300000, [](deaddev::timer_node &) {}), 1u);
+  ASSERT_TRUE(wheel.empty());
+  ASSERT_EQ(wheel.next_event(), (deaddev::timing_wheel<3>::never));
+}
+
+TEST(timing_wheel, cancel_and_reschedule) {
+  std::vector<timer> timers(3);
+  deaddev::timing_wheel<> wheel(100);
+  wheel.schedule(timers[0], 110);
+  wheel.schedule(timers[1], 110);
+  wheel.schedule(timers[2], 50); // already due
+  ASSERT_TRUE(wheel.cancel(timers[0]));
+  ASSERT_FALSE(wheel.cancel(timers[0]));
+  wheel.schedule(timers[1], 200);
+  ASSERT_EQ(wheel.occupancy(0), std::uint64_t{1} << (100 % 64));
+  std::vector<deaddev::timer_node *> fired;
+  wheel.advance(199, [&](deaddev::timer_node &node) { fired.push_back(&node); });
+  ASSERT_EQ(fired, (std::vector<deaddev::timer_node *>{&timers[2]}));
+  wheel.advance(200, [&](deaddev::timer_node &node) { fired.push_back(&node); });
+  ASSERT_EQ(fired.size(), 2u);
+  ASSERT_EQ(fired[1], &timers[1]);
+}
+
+TEST(timing_wheel, callback_changes_timers_due_on_same_tick) {
+  std::vector<timer> timers(3);
+  deaddev::timing_wheel<> wheel;
+  for (auto &node : timers) {
+    wheel.schedule(node, 10);
+  }
+  std::vector<deaddev::timer_node *> fired;
+  deaddev::timer_node *moved = nullptr;
+  const auto expired = wheel.advance(20, [&](deaddev::timer_node &node) {
+    fired.push_back(&node);
+    for (auto &other : timers) {
+      if (&other == &node) {
+        continue;
+      }
+      // reschedules the first other timer and cancels the last one
+      if (moved == nullptr) {
+        moved = &other;
+        wheel.schedule(other, 500);
+      } else {
+        ASSERT_TRUE(wheel.cancel(other));
+      }
+    }
+  });
+  ASSERT_EQ(expired, 1u);
+  ASSERT_EQ(fired.size(), 1u);
+  ASSERT_EQ(wheel.size(), 1u);
+  ASSERT_NE(moved->level, std::uint8_t{deaddev::timer_node::unlinked});
+  ASSERT_EQ(wheel.next_event(), 448u);
+  fired.clear();
+  ASSERT_EQ(wheel.advance(500, [&](deaddev::timer_node &node) { fired.push_back(&node); }), 1u);
+  ASSERT_EQ(fired, (std::vector<deaddev::timer_node *>{moved}));
+  ASSERT_TRUE(wheel.empty());
+}
+
+TEST(timing_wheel, periodic_from_callback) {
+  timer tick;
+  deaddev::timing_wheel<2> wheel;
+  wheel.schedule(tick, 0);
+  std::vector<std::uint64_t> ticks;
+  wheel.advance(1000, [&](deaddev::timer_node &node) {
+    ticks.push_back(wheel.now());
+    wheel.schedule(node, wheel.now() + 300);
+  });
+  ASSERT_EQ(ticks, (std::vector<std::uint64_t>{0, 300, 600, 900}));
+  // lower bound, timers of level 1 move down first
+  ASSERT_EQ(wheel.next_event(), 1152u);
+  ASSERT_EQ(wheel.advance(1199, [](deaddev::timer_node &) {}), 0u);
+  ASSERT_EQ(wheel.next_event(), 1200u);
+}
+
+TEST(timing_wheel, matches_reference) {
+  std::mt19937_64 random(42);
+  std::vector<timer> timers(500);
+  deaddev::timing_wheel<2> wheel;
+  std::uint64_t now = 0;
+  for (int step = 0; step < 200; ++step) {
+    for (auto &t : timers) {
+      if (t.level == deaddev::timer_node::unlinked && random() % 4 == 0) {
+        t.stamp = wheel.now();
+        wheel.schedule(t, now + random() % 10000);
+      } else if (random() % 16 == 0) {
+        wheel.cancel(t);
+      }
+    }
+    now += random() % 700;
+    std::vector<timer *> expected;
+    for (auto &t : timers) {
+      if (t.level != deaddev::timer_node::unlinked && t.expires <= now) {
+        expected.push_back(&t);
+      }
+    }
+    std::uint64_t last = 0;
+    std::size_t count = 0;
+    wheel.advance(now, [&](deaddev::timer_node &node) {
+      ASSERT_LE(last, node.expires);
+      // timers scheduled when already due expire on the next tick
+      ASSERT_EQ(wheel.now(), std::max(node.expires, static_cast<timer &>(node).stamp));
+      last = node.expires;
+      ++count;
+    });
+    ASSERT_EQ(count, expected.size());
+    for (auto *t : expected) {
+      ASSERT_EQ(t->level, deaddev::timer_node::unlinked);
+    }
+  }
+}
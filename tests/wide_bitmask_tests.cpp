@@ -0,0 +1,51 @@
+#include <deaddev/wide_bitmask.hpp>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using wide_flags = deaddev::wide_bitmask<130>;
+
+enum class component : uint16_t { position = 0, velocity = 70, health = 129 };
+using component_mask = deaddev::wide_bitmask<130, component>;
+
+TEST(wide_bitmask, set_and_remove) {
+  wide_flags flags{1, 64, 129};
+  ASSERT_TRUE(flags.is_set(64));
+  ASSERT_FALSE(flags.is_set(63));
+  ASSERT_EQ(flags.count(), 3u);
+  flags.remove(64).set(100);
+  ASSERT_EQ(flags, (wide_flags{1, 100, 129}));
+  ASSERT_TRUE(flags.is_set(wide_flags{1, 129}));
+  ASSERT_FALSE(flags.is_set(wide_flags{1, 2}));
+  ASSERT_TRUE(flags.intersects(wide_flags{2, 100}));
+  ASSERT_TRUE(flags.clear().none());
+}
+
+TEST(wide_bitmask, find) {
+  const wide_flags flags{3, 64, 127};
+  ASSERT_EQ(flags.find_first(), 3u);
+  ASSERT_EQ(flags.find_next(4), 64u);
+  ASSERT_EQ(flags.find_next(65), 127u);
+  ASSERT_EQ(flags.find_next(128), wide_flags::npos);
+  ASSERT_EQ(flags.find_last(), 127u);
+  ASSERT_EQ(wide_flags{}.find_first(), wide_flags::npos);
+  ASSERT_EQ(wide_flags{}.find_last(), wide_flags::npos);
+}
+
+TEST(wide_bitmask, operators) {
+  const wide_flags left{0, 65, 129};
+  const wide_flags right{65, 100};
+  ASSERT_EQ(left & right, wide_flags{65});
+  ASSERT_EQ(left | right, (wide_flags{0, 65, 100, 129}));
+  ASSERT_EQ(left ^ right, (wide_flags{0, 100, 129}));
+  ASSERT_EQ((~left).count(), 127u);
+  ASSERT_EQ(wide_flags::all().count(), 130u);
+  ASSERT_EQ(~wide_flags::all(), wide_flags{});
+}
+
+TEST(wide_bitmask, enum_index) {
+  const component_mask mask{component::velocity, component::health};
+  std::vector<component> components(mask.begin(), mask.end());
+  ASSERT_EQ(components, (std::vector<component>{component::velocity, component::health}));
+  ASSERT_FALSE(mask.is_set(component::position));
+}
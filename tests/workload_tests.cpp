@@ -0,0 +1,81 @@
+#include <deaddev/bitmask_workload.hpp>
+#include <gtest/gtest.h>
+
+#include <map>
+
+namespace workload_ns {
+enum class workload_flag_bits : uint32_t {
+  option_0_bit = 0x01,
+  option_1_bit = 0x02,
+  option_2_bit = 0x04,
+  option_3_bit = 0x08,
+  option_4_bit = 0x10,
+};
+DEADDEV_ENABLE_BITMASK(workload_flag_bits, workload_flag_bits::option_0_bit,
+                       workload_flag_bits::option_1_bit, workload_flag_bits::option_2_bit,
+                       workload_flag_bits::option_3_bit, workload_flag_bits::option_4_bit);
+} // namespace workload_ns
+using workload_flags = deaddev::bitmask<workload_ns::workload_flag_bits>;
+using workload_generator = deaddev::workload_generator<workload_ns::workload_flag_bits>;
+
+TEST(workload, reproducible_with_any_thread_count) {
+  workload_generator generator(42);
+  generator.locality(0.25);
+  const std::size_t count = workload_generator::block_size * 3 + 17;
+  const auto single = generator.generate(count, 1);
+  ASSERT_EQ(single, generator.generate(count, 4));
+  ASSERT_NE(single, workload_generator(43).locality(0.25).generate(count, 1));
+}
+
+TEST(workload, flag_probabilities) {
+  workload_generator generator(7);
+  generator.flag_probability(workload_flags::all_flags(), 0.0)
+      .flag_probability(workload_ns::workload_flag_bits::option_1_bit, 1.0)
+      .flag_probability(workload_ns::workload_flag_bits::option_3_bit, 0.25);
+  const std::size_t count = 100000;
+  std::size_t option_3 = 0;
+  for (const workload_flags mask : generator.generate(count)) {
+    ASSERT_TRUE(mask.is_set(workload_ns::workload_flag_bits::option_1_bit));
+    ASSERT_EQ(mask & ~workload_flags(workload_ns::workload_flag_bits::option_1_bit |
+                                     workload_ns::workload_flag_bits::option_3_bit),
+              0);
+    option_3 += mask.is_set(workload_ns::workload_flag_bits::option_3_bit) ? 1 : 0;
+  }
+  ASSERT_NEAR(static_cast<double>(option_3) / count, 0.25, 0.01);
+}
+
+TEST(workload, locality_starts_blocks_with_drawn_mask) {
+  workload_generator generator(5);
+  generator.flag_probability(workload_flags::all_flags(), 0.0)
+      .flag_probability(workload_ns::workload_flag_bits::option_1_bit, 1.0)
+      .locality(1.0);
+  for (const workload_flags mask : generator.generate(workload_generator::block_size * 2, 2)) {
+    ASSERT_TRUE(mask.is_set(workload_ns::workload_flag_bits::option_1_bit));
+  }
+}
+
+TEST(workload, correlated_groups) {
+  const workload_flags group{workload_ns::workload_flag_bits::option_0_bit |
+                             workload_ns::workload_flag_bits::option_4_bit};
+  workload_generator generator(11);
+  generator.flag_probability(workload_flags::all_flags(), 0.0).group(group, 0.5);
+  for (const workload_flags mask : generator.generate(10000)) {
+    ASSERT_TRUE(mask == 0 || mask == group);
+  }
+}
+
+TEST(workload, zipf_popularity) {
+  workload_generator generator(3);
+  generator.zipf(8, 1.0);
+  std::map<uint32_t, std::size_t> counts;
+  for (const workload_flags mask : generator.generate(100000)) {
+    ++counts[static_cast<uint32_t>(mask)];
+  }
+  ASSERT_LE(counts.size(), 8u);
+  std::size_t most_popular = 0;
+  for (const auto &entry : counts) {
+    most_popular = std::max(most_popular, entry.second);
+  }
+  // first entry weight is 1 / H(8) ~ 0.37
+  ASSERT_GT(most_popular, 30000u);
+}